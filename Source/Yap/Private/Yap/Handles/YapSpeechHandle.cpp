@@ -40,6 +40,9 @@ void FYapSpeechHandle::Invalidate()
 	Guid.Invalidate();
 	
 	bActive = false;
+
+	SlotIndex = INDEX_NONE;
+	SlotGeneration = 0;
 }
 
 // ------------------------------------------------------------------------------------------------
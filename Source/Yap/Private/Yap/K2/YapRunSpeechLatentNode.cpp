@@ -50,7 +50,6 @@ UYapRunSpeechLatentNode* UYapRunSpeechLatentNode::RunSpeechLatent(
 	}
 
 	Node->Data.SpeakerID = CharacterID;
-	Node->Data.Speaker = UYapSubsystem::GetCharacterManager(SpeechOwner).FindCharacter(CharacterID);
 	Node->Data.DialogueText = DialogueText;
 	Node->Data.DialogueAudioAsset = DialogueAudioAsset;
 	Node->Data.MoodTag = MoodTag;
@@ -73,6 +72,42 @@ void UYapRunSpeechLatentNode::Activate()
 {
 	UYapSubsystem* Subsystem = UYapSubsystem::Get(_SpeechOwner);
 
+	// Culled before the speaker is even looked up
+	if (!Subsystem->AdmitFreeSpeech(Data.SpeakerID, _SpeechOwner))
+	{
+		OnSpeechComplete.BindDynamic(this, &ThisClass::OnSpeechCompleteFunc);
+		UYapSpeechHandleBFL::BindToOnSpeechComplete(_SpeechOwner, _Handle, OnSpeechComplete);
+		
+		Subsystem->CullSpeech(_Handle);
+		return;
+	}
+	
+	TScriptInterface<IYapCharacterInterface> Speaker;
+	
+	FYapOnCharacterLoaded OnLoaded = FYapOnCharacterLoaded::CreateUObject(this, &ThisClass::OnSpeakerLoaded);
+	
+	if (UYapSubsystem::GetCharacterManager(_SpeechOwner).FindCharacter(Data.SpeakerID, Speaker, OnLoaded) == EYapCharacterLoadState::Pending)
+	{
+		// Speech will start once the speaker is loaded
+		return;
+	}
+
+	Data.Speaker = Speaker;
+	
+	StartSpeech();
+}
+
+void UYapRunSpeechLatentNode::OnSpeakerLoaded(TScriptInterface<IYapCharacterInterface> Speaker)
+{
+	Data.Speaker = Speaker;
+
+	StartSpeech();
+}
+
+void UYapRunSpeechLatentNode::StartSpeech()
+{
+	UYapSubsystem* Subsystem = UYapSubsystem::Get(_SpeechOwner);
+
 	UE_LOG(LogYap, VeryVerbose, TEXT("RunSpeechLatent activate... Running speech: %s <%s>"), *Data.DialogueText.ToString(), *_Handle.ToString());
 	
 	Subsystem->RunSpeech(Data, _NodeType, _Handle);
@@ -109,6 +144,11 @@ void UYapRunSpeechLatentNode::OnSpeechCompleteFunc(UObject* Broadcaster, const F
 			Cancelled.Broadcast();
 			break;
 		}
+		case EYapSpeechCompleteResult::Culled:
+		{
+			Finished.Broadcast();
+			break;
+		}
 		default:
 		{
 			UE_LOG(LogYap, Error, TEXT("Run Speech Latent node finished with undefined result! This should never happen!"));
@@ -12,18 +12,22 @@
 
 #define LOCTEXT_NAMESPACE "Yap"
 
+FName UFlowNode_YapConversation_Open::DroppedPinName = TEXT("Dropped");
+
 UFlowNode_YapConversation_Open::UFlowNode_YapConversation_Open()
 {
 #if WITH_EDITOR
 	Category = TEXT("Yap");
 #endif
+
+	OutputPins.Add(FFlowPin(DroppedPinName));
 }
 
 void UFlowNode_YapConversation_Open::ExecuteInput(const FName& PinName)
 {
 	Super::ExecuteInput(PinName);
 	
-	FYapConversation& NewConversation = UYapSubsystem::Get(GetWorld())->OpenConversation(ConversationName.GetTagName(), GetFlowAsset());
+	FYapConversation& NewConversation = UYapSubsystem::Get(GetWorld())->OpenConversation(ConversationName.GetTagName(), GetFlowAsset(), Scheduling);
 
 	// The subsystem will give conversation listeners a chance to set an interlock. If so, the state will be "Opening" rather than "Open".
 	// When the interlock gets released, the delegate below will get called instead.
@@ -35,9 +39,16 @@ void UFlowNode_YapConversation_Open::ExecuteInput(const FName& PinName)
 	else
 	{
 		NewConversation.OnConversationOpened.AddDynamic(this, &ThisClass::FinishNode);
+		NewConversation.OnConversationDropped.AddDynamic(this, &ThisClass::OnDropped);
 	}
 }
 
+void UFlowNode_YapConversation_Open::OnDropped(UObject* Instigator, FYapConversationHandle Handle)
+{
+	UE_LOG(LogYap, Verbose, TEXT("Conversation Dropped: %s"), *ConversationName.GetTagName().ToString());
+	TriggerOutput(DroppedPinName, true);
+}
+
 void UFlowNode_YapConversation_Open::FinishNode(UObject* Instigator, FYapConversationHandle Handle)
 {
 	FinishNode_Internal();
@@ -50,6 +61,7 @@ void UFlowNode_YapConversation_Open::FinishNode_Internal()
 	if (Conversation)
 	{
 		Conversation->OnConversationOpened.RemoveAll(this);
+		Conversation->OnConversationDropped.RemoveAll(this);
 		TriggerFirstOutput(true);
 	}
 	else
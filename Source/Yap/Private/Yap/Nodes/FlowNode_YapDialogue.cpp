@@ -3,15 +3,19 @@
 
 #include "Yap/Nodes/FlowNode_YapDialogue.h"
 
+#include "FlowAsset.h"
 #include "GameplayTagsManager.h"
 #include "GameplayTagsModule.h"
 #include "Nodes/Route/FlowNode_Reroute.h"
 #include "UObject/ObjectSaveContext.h"
 #include "Yap/YapBit.h"
+#include "Yap/YapCharacterManager.h"
 #include "Yap/YapCondition.h"
+#include "Yap/YapDialogueDatabase.h"
 #include "Yap/YapFragment.h"
 #include "Yap/YapProjectSettings.h"
 #include "Yap/YapSquirrelNoise.h"
+#include "Yap/YapStats.h"
 #include "Yap/YapSubsystem.h"
 #include "Yap/Enums/YapLoadContext.h"
 #include "Engine/World.h"
@@ -76,16 +80,16 @@ int16 UFlowNode_YapDialogue::FindFragmentIndex(const FGuid& InFragmentGuid) cons
 
 FYapFragment* UFlowNode_YapDialogue::FindTaggedFragment(const FGameplayTag& Tag)
 {
-	// TODO replace with new logic using FNames
-	/*
+	const FName FragmentID = Tag.GetTagName();
+	
 	for (FYapFragment& Fragment : Fragments)
 	{
-		if (Fragment.GetFragmentTag() == Tag)
+		if (!FragmentID.IsNone() && Fragment.GetFragmentID() == FragmentID)
 		{
 			return &Fragment;
 		}
 	}
-*/
+
 	return nullptr;
 }
 
@@ -123,7 +127,7 @@ void UFlowNode_YapDialogue::OnCancel(UObject* Instigator, FYapSpeechHandle Handl
 	
 	for (uint8 i = 0; i <= FocusedFragmentIndex.Get(0); ++i)
 	{
-		GetWorld()->GetTimerManager().ClearTimer(Fragments[i].PaddingTimerHandle);
+		UYapSubsystem::Get(this)->ClearTimer(Fragments[i].PaddingTimerHandle);
 	}
 
 	FragmentsInPadding.Empty();
@@ -140,54 +144,87 @@ void UFlowNode_YapDialogue::OnCancel(UObject* Instigator, FYapSpeechHandle Handl
 // the flow graph dialogue node to cancel events separately.
 void UFlowNode_YapDialogue::OnAdvanceConversation(UObject* Instigator, FYapConversationHandle Handle)
 {
-	// TODO make sure this dialogue node is actually in this conversation, URGENT
-	if (!FocusedFragmentIndex.IsSet() || !FocusedSpeechHandle.IsValid())
+	UE_LOG(LogYap, VeryVerbose, TEXT("%s: OnAdvanceConversation [CH %s]"), *GetName(), *Handle.ToString());
+
+	// Gathered first; advancing one activation can start others which must not be advanced by the same request
+	TArray<TPair<int32, FYapSpeechHandle>, TInlineAllocator<4>> FocusedContexts;
+
+	for (const FYapDialogueNodeContext& Context : Contexts)
+	{
+		// Activations in other conversations, or running as free speech, are not advanced by this request
+		if (Context.ConversationHandle != Handle)
+		{
+			continue;
+		}
+		
+		if (Context.bActive && !Context.bWaitingForConversation && Context.FocusedFragmentIndex.IsSet() && Context.FocusedSpeechHandle.IsValid())
+		{
+			FocusedContexts.Emplace(Context.Index, Context.FocusedSpeechHandle);
+		}
+	}
+
+	if (FocusedContexts.Num() == 0)
 	{
 		UE_LOG(LogYap, Warning, TEXT("%s: OnAdvanceConversation called while focused fragment wasn't set; ignoring request"), *GetName());
 		return;
 	}
 
-	UE_LOG(LogYap, VeryVerbose, TEXT("%s: OnAdvanceConversation [CH %s]"), *GetName(), *Handle.ToString());
-	
-	auto RunningFragmentsCopy = RunningFragments;
+	UYapSubsystem* Subsystem = UYapSubsystem::Get(this);
 
-	bool bForceAdvance = Fragments[FocusedFragmentIndex.GetValue()].IsAwaitingManualAdvance() || !SpeakingFragments.Contains(FocusedSpeechHandle) && FragmentsInPadding.Contains(FocusedSpeechHandle);
-	
-	for (auto& [SpeechHandle, Index] : RunningFragmentsCopy)
+	for (const TPair<int32, FYapSpeechHandle>& FocusedContext : FocusedContexts)
 	{
-		FYapFragment& Fragment = Fragments[Index];
-		FTimerHandle& PaddingTimerHandle = Fragment.PaddingTimerHandle;
+		FYapDialogueNodeContext& Context = Contexts[FocusedContext.Key];
+
+		if (!Context.bActive || Context.FocusedSpeechHandle != FocusedContext.Value)
+		{
+			continue;
+		}
 
-		if (PaddingTimerHandle.IsValid())
+		const FYapSpeechHandle FocusedSpeechHandle = Context.FocusedSpeechHandle;
+		const uint8 FocusedFragmentIndex = Context.FocusedFragmentIndex.GetValue();
+		
+		bool bForceAdvance = Context.bAwaitingManualAdvance || !Context.SpeakingFragments.Contains(FocusedSpeechHandle) && Context.FragmentsInPadding.Contains(FocusedSpeechHandle);
+
+		for (auto& [SpeechHandle, PaddingTimerHandle] : Context.FragmentsInPadding)
 		{
-			GetWorld()->GetTimerManager().ClearTimer(PaddingTimerHandle);
+			Subsystem->ClearTimer(PaddingTimerHandle);
 		}
-	}
 
-	FragmentsInPadding.Empty(FragmentsInPadding.Num());
+		Context.FragmentsInPadding.Reset();
 	
-	if (bForceAdvance)
-	{
-		// If the focused (most recent) fragment is just waiting for padding then the normal OnSpeechComplete event isn't going to fire for it. We need to forcefully advance.
-		FinishFragment(FocusedSpeechHandle, FocusedFragmentIndex.GetValue());
-		AdvanceFromFragment(FocusedSpeechHandle, FocusedFragmentIndex.GetValue());
-	}
-	else
-	{
-		// The OnSpeechComplete event is going to fire, set a flag for it to use
-		bForceAdvanceOnSpeechComplete = true;
+		if (bForceAdvance)
+		{
+			// If the focused (most recent) fragment is just waiting for padding then the normal OnSpeechComplete event isn't going to fire for it. We need to forcefully advance.
+			FinishFragment(Context, FocusedSpeechHandle, FocusedFragmentIndex);
+			AdvanceFromFragment(Context, FocusedSpeechHandle, FocusedFragmentIndex);
+		}
+		else
+		{
+			// The OnSpeechComplete event is going to fire, set a flag for it to use
+			Context.bForceAdvanceOnSpeechComplete = true;
+		}
 	}
 }
 
-void UFlowNode_YapDialogue::FinishNode(FName OutputPinToTrigger)
+void UFlowNode_YapDialogue::FinishNode(FYapDialogueNodeContext& Context, FName OutputPinToTrigger)
 {
 	UE_LOG(LogYap, VeryVerbose, TEXT("%s: FinishNode - Unbinding from OnAdvanceConversation"), *GetName());
+
+	if (!Context.bActive)
+	{
+		return;
+	}
 	
-	bNodeActive = false;
-	FocusedFragmentIndex.Reset();
-	FocusedSpeechHandle.Invalidate();
-	
-	TriggerOutput(OutputPinToTrigger, true, EFlowPinActivationType::Default);
+	Context.bActive = false;
+	Context.FocusedFragmentIndex.Reset();
+	Context.FocusedSpeechHandle.Invalidate();
+
+	--NumActiveContexts;
+
+	TryReleaseContext(Context);
+
+	// Flow only finishes the node once its last activation is done
+	TriggerOutput(OutputPinToTrigger, NumActiveContexts == 0, EFlowPinActivationType::Default);
 }
 
 void UFlowNode_YapDialogue::SetActive()
@@ -207,9 +244,7 @@ TOptional<float> UFlowNode_YapDialogue::GetSpeechTime(uint8 FragmentIndex) const
 		return NullOpt;
 	}
 	
-	const FYapFragment& Fragment = GetFragment(FragmentIndex);
-
-	return Fragment.GetSpeechTime(GetWorld(), GetNodeConfig());
+	return GetFragmentTimes(FragmentIndex).GetSpeechTime();
 }
 
 #if WITH_EDITOR
@@ -230,28 +265,94 @@ float UFlowNode_YapDialogue::GetPadding(uint8 FragmentIndex) const
 	}
 	*/
 	
+	return GetFragmentTimes(FragmentIndex).Padding;
+}
+
+// Cooked fragments are read from the Flow asset's dialogue database when it has one. Replaced fragments never are, their text or audio differs from what was baked.
+static FYapDialogueDatabase::FFragmentView FindDatabaseFragment(const UFlowNode_YapDialogue* DialogueNode, const FYapFragment& Fragment, uint8 FragmentIndex)
+{
+	const UYapSubsystem* Subsystem = UYapSubsystem::Get(DialogueNode->GetWorld());
+
+	if (!Subsystem || DialogueNode->GetDialogueID().IsNone() || Subsystem->GetBitReplacements().Contains(Fragment.GetFragmentID()))
+	{
+		return {};
+	}
+
+	// The subsystem keeps the database open, views stay valid
+	const TSharedPtr<const FYapDialogueDatabase> Database = Subsystem->GetDialogueDatabase(DialogueNode->GetFlowAsset());
+
+	return Database.IsValid() ? Database->FindFragment(DialogueNode->GetDialogueID(), FragmentIndex) : FYapDialogueDatabase::FFragmentView();
+}
+
+FYapFragmentTimes UFlowNode_YapDialogue::GetFragmentTimes(uint8 FragmentIndex) const
+{
 	const FYapFragment& Fragment = GetFragment(FragmentIndex);
 
-	float Value = Fragment.GetPaddingValue(GetWorld(), GetNodeConfig());
+	EYapMaturitySetting MaturitySetting = EYapMaturitySetting::Unspecified;
+	
+	Fragment.ResolveMaturitySetting(GetWorld(), MaturitySetting);
+	
+	const UYapSubsystem* Subsystem = UYapSubsystem::Get(GetWorld());
+
+	// Replaced text, audio or manual time changes the speech time, so baked times don't hold. Evaluated once each time the replacement changes.
+	if (TOptional<FYapFragmentTimes>* ReplacementTimes = Subsystem ? Subsystem->GetBitReplacements().FindReplacementTimes(Fragment.GetFragmentID(), MaturitySetting) : nullptr)
+	{
+		if (ReplacementTimes->IsSet())
+		{
+			return ReplacementTimes->GetValue();
+		}
+
+		const FYapBit& ReplacementBit = Fragment.GetBit(GetWorld(), MaturitySetting);
+
+		if (ReplacementBit.IsAudioTimeReady())
+		{
+			ReplacementTimes->Emplace(Fragment.EvaluateTimes(GetWorld(), MaturitySetting, EYapLoadContext::Async, GetNodeConfig()));
+
+			return ReplacementTimes->GetValue();
+		}
+
+		// Preloading normally has the replacement's audio in by now. Never block on it, and don't cache until it arrives; time by its text meanwhile.
+		if (!ReplacementBit.IsAudioAssetLoading())
+		{
+			ReplacementBit.LoadContent(Fragment.GetFragmentID(), EYapLoadContext::Async);
+		}
+
+		return Fragment.EvaluateTimes(GetWorld(), MaturitySetting, EYapLoadContext::DoNotLoad, GetNodeConfig());
+	}
+	
+	// Two entries per fragment, mature first
+	if (BakedFragmentTimes.Num() == Fragments.Num() * 2)
+	{
+		return BakedFragmentTimes[FragmentIndex * 2 + (MaturitySetting == EYapMaturitySetting::ChildSafe ? 1 : 0)];
+	}
+
+	const FYapDialogueDatabase::FFragmentView DatabaseFragment = FindDatabaseFragment(this, Fragment, FragmentIndex);
 
-	return Value;
+	if (DatabaseFragment.IsValid())
+	{
+		return DatabaseFragment.GetTimes(MaturitySetting);
+	}
+
+	return Fragment.EvaluateTimes(GetWorld(), MaturitySetting, EYapLoadContext::Sync, GetNodeConfig());
 }
 
 // ------------------------------------------------------------------------------------------------
 
 bool UFlowNode_YapDialogue::CanSkip(FYapSpeechHandle Handle) const
 {
-	if (FocusedSpeechHandle != Handle || !Handle.IsValid())
+	const int32* ContextIndex = SpeechContexts.Find(Handle);
+
+	if (!ContextIndex || Contexts[*ContextIndex].FocusedSpeechHandle != Handle || !Handle.IsValid())
 	{
 		return false;
 	}
 
-	check(FocusedFragmentIndex.IsSet());
+	const FYapDialogueNodeContext& Context = Contexts[*ContextIndex];
 	
-	const FYapFragment& Fragment = Fragments[FocusedFragmentIndex.GetValue()];
+	check(Context.FocusedFragmentIndex.IsSet());
 	
 	// The fragment is finished running, and this feature is only being used for manual advance
-	if (Fragment.IsAwaitingManualAdvance())
+	if (Context.bAwaitingManualAdvance)
 	{
 		return true;
 	}
@@ -309,14 +410,9 @@ void UFlowNode_YapDialogue::InitializeInstance()
 {
 	Super::InitializeInstance();
 
-	for (FYapFragment& Fragment : Fragments)
+	if (UYapSubsystem* Subsystem = UYapSubsystem::Get(this))
 	{
-		if (Fragment.GetFragmentID().IsValid())
-		{
-			// TODO
-			UYapSubsystem* Subsystem = GetWorld()->GetSubsystem<UYapSubsystem>();
-			//Subsystem->RegisterTaggedFragment(Fragment.GetFragmentTag(), this);
-		}
+		Subsystem->RegisterTaggedFragments(this);
 	}
 	
 	TriggerPreload();
@@ -324,16 +420,27 @@ void UFlowNode_YapDialogue::InitializeInstance()
 
 // ------------------------------------------------------------------------------------------------
 
+void UFlowNode_YapDialogue::DeinitializeInstance()
+{
+	if (UYapSubsystem* Subsystem = UYapSubsystem::Get(this))
+	{
+		Subsystem->UnregisterTaggedFragments(this);
+	}
+	
+	Super::DeinitializeInstance();
+}
+
+// ------------------------------------------------------------------------------------------------
+
 void UFlowNode_YapDialogue::ExecuteInput(const FName& PinName)
 {
 	if (CanEnterNode())
 	{
-		bNodeActive = true;
+		FYapDialogueNodeContext& Context = AcquireContext();
 
-		FocusedFragmentIndex.Reset();
-		FocusedSpeechHandle.Invalidate();
+		UYapSubsystem::Get(this)->PrefetchAhead(this);
 		
-		bool bStartedSuccessfully = IsPlayerPrompt() ? TryBroadcastPrompts() : TryStartFragments();
+		bool bStartedSuccessfully = IsPlayerPrompt() ? TryBroadcastPrompts(Context) : TryStartFragments(Context);
 
 		if (bStartedSuccessfully)
 		{			
@@ -341,7 +448,12 @@ void UFlowNode_YapDialogue::ExecuteInput(const FName& PinName)
 		}
 		else
 		{
-			TriggerOutput(BypassPinName, true, EFlowPinActivationType::Default);
+			Context.bActive = false;
+			--NumActiveContexts;
+
+			TryReleaseContext(Context);
+			
+			TriggerOutput(BypassPinName, NumActiveContexts == 0, EFlowPinActivationType::Default);
 		}
 	}
 	else
@@ -375,9 +487,9 @@ void UFlowNode_YapDialogue::OnPassThrough_Implementation()
 
 bool UFlowNode_YapDialogue::CanEnterNode()
 {
-	if (bNodeActive)
+	if (IsPlayerPrompt() && NumActiveContexts > 0)
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to enter dialogue node [%s], but dialogue node is already active! Yap does not currently support running the same node multiple times simultaneously."), *GetName());
+		UE_LOG(LogYap, Warning, TEXT("Tried to enter player prompt node [%s], but it is already active! Only Talk nodes can run multiple times simultaneously."), *GetName());
 		return false;
 	}
 	
@@ -386,23 +498,149 @@ bool UFlowNode_YapDialogue::CanEnterNode()
 
 // ------------------------------------------------------------------------------------------------
 
-bool UFlowNode_YapDialogue::CheckConditions()
+void FYapDialogueNodeContext::Reset()
+{
+	bActive = false;
+	bForceAdvanceOnSpeechComplete = false;
+	bAwaitingManualAdvance = false;
+	bWaitingForConversation = false;
+	PendingCharacterLoads = 0;
+	++CharacterLoadSerial;
+	bCharactersLoaded = false;
+	ResumeFragmentIndex = INDEX_NONE;
+	FocusedFragmentIndex.Reset();
+	FocusedSpeechHandle.Invalidate();
+	InConversation = NAME_None;
+	ConversationHandle.Invalidate();
+	PromptIndices.Reset();
+	RunningFragments.Reset();
+	SpeakingFragments.Reset();
+	FragmentsInPadding.Reset();
+
+	for (FYapDialogueFragmentRunState& FragmentState : FragmentStates)
+	{
+		FragmentState.RunState = EYapFragmentRunState::Idle;
+		FragmentState.bAwaitingManualAdvance = false;
+		FragmentState.Activations = 0;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapDialogueNodeContext& UFlowNode_YapDialogue::AcquireContext()
+{
+	int32 ContextIndex;
+
+	if (FreeContexts.Num() > 0)
+	{
+		ContextIndex = FreeContexts.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		ContextIndex = Contexts.Add(new FYapDialogueNodeContext());
+		Contexts[ContextIndex].Index = ContextIndex;
+	}
+
+	FYapDialogueNodeContext& Context = Contexts[ContextIndex];
+	Context.bActive = true;
+	Context.FragmentStates.SetNum(Fragments.Num(), EAllowShrinking::No);
+
+	++NumActiveContexts;
+
+	return Context;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UFlowNode_YapDialogue::TryReleaseContext(FYapDialogueNodeContext& Context)
+{
+	if (Context.bActive || Context.RunningFragments.Num() > 0)
+	{
+		return;
+	}
+
+	Context.Reset();
+
+	FreeContexts.Add(Context.Index);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapDialogueNodeContext* UFlowNode_YapDialogue::FindSpeechContext(const FYapSpeechHandle& Handle)
 {
-	for (UYapCondition* Condition : Conditions)
+	const int32* ContextIndex = SpeechContexts.Find(Handle);
+
+	return ContextIndex ? &Contexts[*ContextIndex] : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UFlowNode_YapDialogue::IncrementActivations(FYapDialogueNodeContext& Context, uint8 FragmentIndex)
+{
+	++Context.FragmentStates[FragmentIndex].Activations;
+	
+	Fragments[FragmentIndex].IncrementActivations();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FYapDialogueFragmentRunState* UFlowNode_YapDialogue::FindLatestFragmentRunState(uint8 FragmentIndex) const
+{
+	const FYapDialogueFragmentRunState* Latest = nullptr;
+	
+	for (const FYapDialogueNodeContext& Context : Contexts)
 	{
-		if (!IsValid(Condition))
+		if (!Context.FragmentStates.IsValidIndex(FragmentIndex))
 		{
-			UE_LOG(LogYap, Warning, TEXT("%s: Null condition found!"), *GetName());
 			continue;
 		}
 
-		if (!Condition->EvaluateCondition_Internal())
+		const FYapDialogueFragmentRunState& FragmentState = Context.FragmentStates[FragmentIndex];
+
+		if (FragmentState.StartTime >= 0.0 && (!Latest || FragmentState.StartTime > Latest->StartTime))
 		{
-			return false;
+			Latest = &FragmentState;
 		}
 	}
 
-	return true;
+	return Latest;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool UFlowNode_YapDialogue::IsFragmentAwaitingManualAdvance(uint8 FragmentIndex) const
+{
+	for (const FYapDialogueNodeContext& Context : Contexts)
+	{
+		if (Context.FragmentStates.IsValidIndex(FragmentIndex) && Context.FragmentStates[FragmentIndex].bAwaitingManualAdvance)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+int32 UFlowNode_YapDialogue::GetRunningFragmentIndex() const
+{
+	for (const FYapDialogueNodeContext& Context : Contexts)
+	{
+		if (Context.bActive && Context.FocusedFragmentIndex.IsSet())
+		{
+			return Context.FocusedFragmentIndex.GetValue();
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool UFlowNode_YapDialogue::CheckConditions()
+{
+	return ConditionProgram.Evaluate(Conditions, this);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -541,14 +779,24 @@ void UFlowNode_YapDialogue::InvalidateFragmentTags()
 
 // ------------------------------------------------------------------------------------------------
 
-bool UFlowNode_YapDialogue::TryBroadcastPrompts()
+bool UFlowNode_YapDialogue::TryBroadcastPrompts(FYapDialogueNodeContext& Context)
 {
-	PromptIndices.Empty(Fragments.Num());
+	YAP_SCOPE(STAT_YapBroadcastPrompts, "Yap TryBroadcastPrompts", DialogueID, FName(NAME_None));
+
+	if (WaitForSuspendedConversation(Context, INDEX_NONE) || WaitForCharacters(Context, INDEX_NONE))
+	{
+		return true;
+	}
+	
+	Context.PromptIndices.Empty(Fragments.Num());
 	
 	UYapSubsystem* Subsystem = GetWorld()->GetSubsystem<UYapSubsystem>();
 
 	const FYapConversation* Conversation = Subsystem->GetConversationByOwner(this, GetFlowAsset()); 
 
+	// Any menu we broadcast before can no longer be chosen
+	Subsystem->ReleasePrompts(this);
+	
 	FYapPromptHandle LastHandle;
 	
  	for (uint8 i = 0; i < Fragments.Num(); ++i)
@@ -567,18 +815,20 @@ bool UFlowNode_YapDialogue::TryBroadcastPrompts()
 
  		const FYapBit& Bit = Fragment.GetBit(GetWorld());
  		const UYapNodeConfig& ActiveConfig = GetNodeConfig();
+		const FYapDialogueDatabase::FFragmentView DatabaseFragment = FindDatabaseFragment(this, Fragment, i);
+		const EYapMaturitySetting MaturitySetting = UYapSubsystem::GetCurrentMaturitySetting(GetWorld());
  		
  		FYapData_PlayerPromptCreated Data;
  		Data.Conversation = Conversation->GetHandle();
 
  		if (ActiveConfig.GetUsesDirectedAt())
  		{
- 			Data.DirectedAt = Fragment.GetDirectedAt(GetWorld(), EYapLoadContext::Sync);
+ 			Data.DirectedAt = Fragment.GetDirectedAt(GetWorld(), EYapLoadContext::Async);
  		}
 
  		if (ActiveConfig.GetUsesSpeaker())
  		{
- 			Data.Speaker = Fragment.GetSpeakerCharacter(GetWorld(), EYapLoadContext::Sync);
+ 			Data.Speaker = Fragment.GetSpeakerCharacter(GetWorld(), EYapLoadContext::Async);
 	 		Data.SpeakerName = Fragment.GetSpeakerTag().GetTagName();	
  		}
 
@@ -587,26 +837,26 @@ bool UFlowNode_YapDialogue::TryBroadcastPrompts()
  			Data.MoodTag = Fragment.GetMoodTag();
  		}
  		
- 		Data.DialogueText = Bit.GetDialogueText();
+ 		Data.DialogueText = DatabaseFragment.IsValid() ? DatabaseFragment.GetDialogueText(MaturitySetting) : Bit.GetDialogueText();
 
  		if (ActiveConfig.GetUsesTitleText(GetNodeType()))
  		{
- 			Data.TitleText = Bit.GetTitleText();
+ 			Data.TitleText = DatabaseFragment.IsValid() ? DatabaseFragment.GetTitleText(MaturitySetting) : Bit.GetTitleText();
  		}
  		
-		LastHandle = Subsystem->BroadcastPrompt(Data, this->GetClass());
+		LastHandle = Subsystem->BroadcastPrompt(Data, this->GetClass(), this);
 
- 		PromptIndices.Add(LastHandle, i);
+ 		Context.PromptIndices.Add(LastHandle, i);
 	}
 
-	if (PromptIndices.Num() == 0)
+	if (Context.PromptIndices.Num() == 0)
 	{
 		return false;
 	}
 	
 	Subsystem->OnPromptChosen.AddDynamic(this, &ThisClass::OnPromptChosen);
 	
-	if (PromptIndices.Num() == 1 && GetNodeConfig().Prompts.bAutoSelectLastPrompt)
+	if (Context.PromptIndices.Num() == 1 && GetNodeConfig().Prompts.bAutoSelectLastPrompt)
 	{
 		LastHandle.RunPrompt(this);
 	}
@@ -622,11 +872,11 @@ bool UFlowNode_YapDialogue::TryBroadcastPrompts()
 
 // ------------------------------------------------------------------------------------------------
 
-void UFlowNode_YapDialogue::RunPrompt(uint8 FragmentIndex)
+void UFlowNode_YapDialogue::RunPrompt(FYapDialogueNodeContext& Context, uint8 FragmentIndex)
 {
 	UYapSubsystem::Get(GetWorld())->OnPromptChosen.RemoveDynamic(this, &ThisClass::OnPromptChosen);
 
-	if (!RunFragment(FragmentIndex))
+	if (!RunFragment(Context, FragmentIndex))
 	{
 		UE_LOG(LogYap, Error, TEXT("%s [%i]: RunPrompt failed! This should never happen. Execution of this flow will stop."), *GetName(), FragmentIndex);
 	}
@@ -634,7 +884,7 @@ void UFlowNode_YapDialogue::RunPrompt(uint8 FragmentIndex)
 
 // ------------------------------------------------------------------------------------------------
 
-bool UFlowNode_YapDialogue::TryStartFragments()
+bool UFlowNode_YapDialogue::TryStartFragments(FYapDialogueNodeContext& Context)
 {
 	bool bStartedSuccessfully = false;
 
@@ -667,7 +917,7 @@ bool UFlowNode_YapDialogue::TryStartFragments()
 		{
 			if (ValidFragments.Num() == 1)
 			{
-				bStartedSuccessfully = RunFragment(ValidFragments[0]);
+				bStartedSuccessfully = RunFragment(Context, ValidFragments[0]);
 			}
 			else if (UYapSubsystem* Subsystem = UYapSubsystem::Get(this))
 			{
@@ -677,7 +927,7 @@ bool UFlowNode_YapDialogue::TryStartFragments()
 
 				uint8 Final = (uint8)FMath::FloorToInt(IntervalVal);
 				
-				bStartedSuccessfully = RunFragment(ValidFragments[Final]);
+				bStartedSuccessfully = RunFragment(Context, ValidFragments[Final]);
 			}
 		}
 	}
@@ -685,7 +935,7 @@ bool UFlowNode_YapDialogue::TryStartFragments()
 	{
 		for (uint8 i = 0; i < Fragments.Num(); ++i)
 		{
-			bStartedSuccessfully = RunFragment(i);
+			bStartedSuccessfully = RunFragment(Context, i);
 
 			if (bStartedSuccessfully)
 			{
@@ -699,7 +949,7 @@ bool UFlowNode_YapDialogue::TryStartFragments()
 
 // ------------------------------------------------------------------------------------------------
 
-bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
+bool UFlowNode_YapDialogue::RunFragment(FYapDialogueNodeContext& Context, uint8 FragmentIndex)
 {
 	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: RunFragment START -------------------------------"), *GetName(), FragmentIndex);
 
@@ -711,25 +961,46 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 
 	FYapFragment& Fragment = Fragments[FragmentIndex];
 
+	YAP_SCOPE(STAT_YapRunFragment, "Yap RunFragment", DialogueID, Fragment.GetSpeakerTag());
+
 	// TODO: the select random node needs to check this for all fragments. I should probably chop off the rest of this function into something else and call that from the random mode.
 	if (!FragmentCanRun(FragmentIndex))
 	{
 		UE_LOG(LogYap, VeryVerbose, TEXT("FAILED - FragmentCanRun returned false"));
-		Fragment.SetStartTime(-1.0);
-		Fragment.SetEndTime(-1.0);
+		Context.FragmentStates[FragmentIndex].StartTime = -1.0;
+		Context.FragmentStates[FragmentIndex].EndTime = -1.0;
 		Fragment.SetEntryState(EYapFragmentEntryStateFlags::Failed);
 		return false;
 	}
 
+	if (WaitForSuspendedConversation(Context, FragmentIndex) || WaitForCharacters(Context, FragmentIndex))
+	{
+		return true;
+	}
+
 	LastRanFragment = FragmentIndex;
+
+	FYapDialogueFragmentRunState& FragmentState = Context.FragmentStates[FragmentIndex];
 	
-	Fragment.SetRunState(EYapFragmentRunState::Running);
-	Fragment.ClearAwaitingManualAdvance();
+	FragmentState.RunState = EYapFragmentRunState::Running;
+	FragmentState.bAwaitingManualAdvance = false;
+
+	UYapSubsystem* Subsystem = GetWorld()->GetSubsystem<UYapSubsystem>();
+
+	if (!IsPlayerPrompt() && !UYapSubsystem::IsNodeInConversation(this) && !Subsystem->AdmitFreeSpeech(Fragment.GetSpeakerTag().GetTagName()))
+	{
+		RunCulledFragment(Context, FragmentIndex);
+		return true;
+	}
 	
 	const FYapBit& Bit = Fragment.GetBit(GetWorld());
 	const UYapNodeConfig& ActiveConfig = GetNodeConfig();
+	const FYapDialogueDatabase::FFragmentView DatabaseFragment = FindDatabaseFragment(this, Fragment, FragmentIndex);
+	const EYapMaturitySetting MaturitySetting = UYapSubsystem::GetCurrentMaturitySetting(GetWorld());
 
-	TOptional<float> SpeechTime = Fragment.GetSpeechTime(GetWorld(), ActiveConfig);
+	const FYapFragmentTimes Times = GetFragmentTimes(FragmentIndex);
+	
+	TOptional<float> SpeechTime = Times.GetSpeechTime();
 
 	float EffectiveTime = 0.0f;
 	
@@ -738,27 +1009,27 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 		EffectiveTime = SpeechTime.GetValue();
 	}
 	
-	UYapSubsystem* Subsystem = GetWorld()->GetSubsystem<UYapSubsystem>();
-	
 	FYapData_SpeechBegins Data;
 
 	if (FYapConversation* Conversation = Subsystem->GetConversationByOwner(GetWorld(), GetFlowAsset()))
 	{
 		Data.Conversation = Conversation->GetConversationName();
-		InConversation = Data.Conversation;
+		Context.InConversation = Data.Conversation;
+		Context.ConversationHandle = Conversation->GetHandle();
 	}
 	else
 	{
-		InConversation = NAME_None;
+		Context.InConversation = NAME_None;
+		Context.ConversationHandle.Invalidate();
 	}
 	
-	bool bInConversation = InConversation != NAME_None;
+	bool bInConversation = Context.InConversation != NAME_None;
 
 	float PaddingTime = 0;
 
-	if (Fragment.GetUsesPadding(GetWorld(), ActiveConfig))
+	if (!FMath::IsNearlyZero(Times.Padding))
 	{
-		PaddingTime = Fragment.GetProgressionTime(GetWorld(), ActiveConfig);
+		PaddingTime = Times.ProgressionTime;
 		
 		if (GetNodeType() == EYapDialogueNodeType::TalkAndAdvance)
 		{
@@ -780,7 +1051,7 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 
 	if (ActiveConfig.GetUsesSpeaker())
 	{
-		Data.Speaker = Fragment.GetSpeakerCharacter(GetWorld(), EYapLoadContext::Sync);
+		Data.Speaker = Fragment.GetSpeakerCharacter(GetWorld(), EYapLoadContext::Async);
 		Data.SpeakerID = Fragment.GetSpeakerTag().GetTagName();
 	}
 
@@ -789,7 +1060,7 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 		Data.MoodTag = Fragment.GetMoodTag();
 	}
 	
-	Data.DialogueText = Bit.GetDialogueText();
+	Data.DialogueText = DatabaseFragment.IsValid() ? DatabaseFragment.GetDialogueText(MaturitySetting) : Bit.GetDialogueText();
 	Data.SpeechTime = EffectiveTime;
 
 	if (ActiveConfig.GetUsesAudioAsset())
@@ -801,7 +1072,7 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 
 	if (!ActiveConfig.GetUsesTitleText(GetNodeType()))
 	{
-		Data.TitleText = Bit.GetTitleText();
+		Data.TitleText = DatabaseFragment.IsValid() ? DatabaseFragment.GetTitleText(MaturitySetting) : Bit.GetTitleText();
 	}
 
 #if !UE_BUILD_SHIPPING
@@ -809,43 +1080,46 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 	
 	if (IsValid(Speaker))
 	{
-		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: [%s] %s"), *GetName(), FragmentIndex, *IYapCharacterInterface::GetName(Speaker).ToString(), *Bit.GetDialogueText().ToString());		
+		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: [%s] %s"), *GetName(), FragmentIndex, *IYapCharacterInterface::GetName(Speaker).ToString(), *Data.DialogueText.ToString());		
 	}
 	else
 	{
-		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: [No Speaker] %s"), *GetName(), FragmentIndex, *Bit.GetDialogueText().ToString());		
+		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: [No Speaker] %s"), *GetName(), FragmentIndex, *Data.DialogueText.ToString());		
 	}
 #endif
 	
-	// Make a handle for the pending speech and bind to completion events of it
-	FocusedSpeechHandle = Subsystem->GetNewSpeechHandle(Fragment.GetGuid(), Data.SpeakerID, Data.Speaker.GetObject(), bInConversation ? GetFlowAsset() : nullptr);
-	FocusedFragmentIndex = FragmentIndex;
+	// Make a handle for the pending speech and bind to completion events of it. Every activation gets its own, the same fragment can be running in several.
+	const FYapSpeechHandle SpeechHandle = Subsystem->GetNewSpeechHandle(Data.SpeakerID, Data.Speaker.GetObject(), bInConversation ? GetFlowAsset() : nullptr);
+	
+	Context.FocusedSpeechHandle = SpeechHandle;
+	Context.FocusedFragmentIndex = FragmentIndex;
+	Context.bAwaitingManualAdvance = false;
 
-	AddRunningFragment(FocusedSpeechHandle, FragmentIndex);
-	SpeakingFragments.Add(FocusedSpeechHandle);
+	AddRunningFragment(Context, SpeechHandle, FragmentIndex);
+	Context.SpeakingFragments.Add(SpeechHandle);
 
-	Fragment.SetStartTime(GetWorld()->GetTimeSeconds());
+	FragmentState.StartTime = GetWorld()->GetTimeSeconds();
 	Fragment.SetEntryState(EYapFragmentEntryStateFlags::Success);
-	Fragment.IncrementActivations();
+	IncrementActivations(Context, FragmentIndex);
 	
-	Subsystem->RunSpeech(Data, GetClass(), FocusedSpeechHandle);
+	Subsystem->RunSpeech(Data, GetClass(), SpeechHandle);
 
 	if (GetNodeType() == EYapDialogueNodeType::TalkAndAdvance) // TODO || something else?
 	{
-		UYapSubsystem::Get(this)->MarkConversationSpeechAsFragile(FocusedSpeechHandle);
+		UYapSubsystem::Get(this)->MarkConversationSpeechAsFragile(SpeechHandle);
 	}
 	
-	BindToSubsystemSpeechCompleteEvent(FocusedSpeechHandle);
+	BindToSubsystemSpeechCompleteEvent(SpeechHandle);
 	
 	if (EffectiveTime <= 0.0f || GetNodeType() == EYapDialogueNodeType::TalkAndAdvance)
 	{
-		OnPaddingComplete(FocusedSpeechHandle);
+		OnPaddingComplete(SpeechHandle);
 	}
 	
-	if (PaddingTime > 0)
+	// The fragment may have finished above already
+	if (PaddingTime > 0 && Context.RunningFragments.Contains(SpeechHandle))
 	{
-		GetWorld()->GetTimerManager().SetTimer(Fragment.PaddingTimerHandle, FTimerDelegate::CreateUObject(this, &ThisClass::OnPaddingComplete, FocusedSpeechHandle), PaddingTime, false);
-		FragmentsInPadding.Add(FocusedSpeechHandle);	
+		Context.FragmentsInPadding.Add(SpeechHandle, Subsystem->StartPaddingTimer(this, SpeechHandle, PaddingTime));
 	}
 	
 	TriggerSpeechStartPin(FragmentIndex);
@@ -853,31 +1127,241 @@ bool UFlowNode_YapDialogue::RunFragment(uint8 FragmentIndex)
 	return true;
 }
 
-void UFlowNode_YapDialogue::AddRunningFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex)
+// ------------------------------------------------------------------------------------------------
+
+bool UFlowNode_YapDialogue::WaitForSuspendedConversation(FYapDialogueNodeContext& Context, int32 FragmentIndex)
+{
+	FYapConversation* Conversation = UYapSubsystem::GetConversationByOwner(this, GetFlowAsset());
+
+	if (!Conversation || !Conversation->IsSuspended())
+	{
+		return false;
+	}
+
+	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: Conversation %s is suspended, waiting for it to open again"), *GetName(), FragmentIndex, *Conversation->GetConversationName().ToString());
+
+	Context.bWaitingForConversation = true;
+	Context.ResumeFragmentIndex = FragmentIndex;
+	Context.ConversationHandle = Conversation->GetHandle();
+
+	Conversation->OnConversationOpened.AddUniqueDynamic(this, &ThisClass::OnConversationResumed);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UFlowNode_YapDialogue::OnConversationResumed(UObject* Instigator, FYapConversationHandle Handle)
+{
+	if (FYapConversation* Conversation = UYapSubsystem::GetConversationByOwner(this, GetFlowAsset()))
+	{
+		Conversation->OnConversationOpened.RemoveDynamic(this, &ThisClass::OnConversationResumed);
+	}
+
+	// Gathered first; a resumed activation can be held again if the conversation is preempted straight away
+	TArray<int32, TInlineAllocator<4>> WaitingContexts;
+
+	for (const FYapDialogueNodeContext& Context : Contexts)
+	{
+		if (Context.bActive && Context.bWaitingForConversation && Context.ConversationHandle == Handle)
+		{
+			WaitingContexts.Add(Context.Index);
+		}
+	}
+
+	for (int32 ContextIndex : WaitingContexts)
+	{
+		FYapDialogueNodeContext& Context = Contexts[ContextIndex];
+
+		Context.bWaitingForConversation = false;
+
+		ResumeActivation(Context);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool UFlowNode_YapDialogue::WaitForCharacters(FYapDialogueNodeContext& Context, int32 FragmentIndex)
+{
+	if (Context.bCharactersLoaded)
+	{
+		Context.bCharactersLoaded = false;
+		return false;
+	}
+
+	const UYapNodeConfig& ActiveConfig = GetNodeConfig();
+
+	const bool bSpeaker = ActiveConfig.GetUsesSpeaker();
+	
+	// Only prompts broadcast the directed-at character; speech only passes its ID
+	const bool bDirectedAt = FragmentIndex == INDEX_NONE && ActiveConfig.GetUsesDirectedAt();
+
+	if (!bSpeaker && !bDirectedAt)
+	{
+		return false;
+	}
+	
+	UYapCharacterManager& CharacterManager = UYapSubsystem::GetCharacterManager(this);
+
+	++Context.CharacterLoadSerial;
+	Context.PendingCharacterLoads = 0;
+
+	auto Request = [this, &CharacterManager, &Context] (const FGameplayTag& CharacterTag)
+	{
+		if (!CharacterTag.IsValid())
+		{
+			return;
+		}
+
+		TScriptInterface<IYapCharacterInterface> Character;
+		
+		FYapOnCharacterLoaded OnLoaded = FYapOnCharacterLoaded::CreateUObject(this, &ThisClass::OnCharacterLoaded, Context.Index, Context.CharacterLoadSerial);
+
+		if (CharacterManager.FindCharacter(CharacterTag.GetTagName(), Character, OnLoaded) == EYapCharacterLoadState::Pending)
+		{
+			++Context.PendingCharacterLoads;
+		}
+	};
+
+	const int32 First = FragmentIndex == INDEX_NONE ? 0 : FragmentIndex;
+	const int32 Last = FragmentIndex == INDEX_NONE ? Fragments.Num() - 1 : FragmentIndex;
+
+	for (int32 i = First; i <= Last; ++i)
+	{
+		if (bSpeaker)
+		{
+			Request(Fragments[i].GetSpeakerTag());
+		}
+
+		if (bDirectedAt)
+		{
+			Request(Fragments[i].GetDirectedAtTag());
+		}
+	}
+
+	if (Context.PendingCharacterLoads == 0)
+	{
+		return false;
+	}
+
+	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: Waiting for %i character load(s)"), *GetName(), FragmentIndex, Context.PendingCharacterLoads);
+	
+	Context.ResumeFragmentIndex = FragmentIndex;
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UFlowNode_YapDialogue::OnCharacterLoaded(TScriptInterface<IYapCharacterInterface> Character, int32 ContextIndex, uint32 Serial)
+{
+	if (!Contexts.IsValidIndex(ContextIndex))
+	{
+		return;
+	}
+
+	FYapDialogueNodeContext& Context = Contexts[ContextIndex];
+
+	// Belongs to an activation which has since finished, or to an earlier wait of this one
+	if (!Context.bActive || Context.CharacterLoadSerial != Serial || Context.PendingCharacterLoads == 0)
+	{
+		return;
+	}
+
+	if (--Context.PendingCharacterLoads > 0)
+	{
+		return;
+	}
+
+	Context.bCharactersLoaded = true;
+
+	ResumeActivation(Context);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UFlowNode_YapDialogue::ResumeActivation(FYapDialogueNodeContext& Context)
+{
+	const bool bEntering = !Context.FocusedFragmentIndex.IsSet();
+
+	const bool bResumed = Context.ResumeFragmentIndex == INDEX_NONE ? TryBroadcastPrompts(Context) : RunFragment(Context, (uint8)Context.ResumeFragmentIndex);
+
+	if (!bResumed)
+	{
+		FinishNode(Context, bEntering ? BypassPinName : OutputPinName);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UFlowNode_YapDialogue::RunCulledFragment(FYapDialogueNodeContext& Context, uint8 FragmentIndex)
 {
-	if (RunningFragments.Num() == 0)
+	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: RunFragment culled by free speech budget"), *GetName(), FragmentIndex);
+	
+	FYapFragment& Fragment = Fragments[FragmentIndex];
+	
+	UYapSubsystem* Subsystem = GetWorld()->GetSubsystem<UYapSubsystem>();
+
+	// Runs through the same bookkeeping as real speech, so the node advances the usual way when the culled result comes in
+	const FYapSpeechHandle Handle = Subsystem->GetNewSpeechHandle(Fragment.GetSpeakerTag().GetTagName(), this, nullptr);
+	
+	Context.FocusedSpeechHandle = Handle;
+	Context.FocusedFragmentIndex = FragmentIndex;
+	Context.bAwaitingManualAdvance = false;
+	Context.InConversation = NAME_None;
+	Context.ConversationHandle.Invalidate();
+
+	AddRunningFragment(Context, Handle, FragmentIndex);
+	Context.SpeakingFragments.Add(Handle);
+
+	Context.FragmentStates[FragmentIndex].StartTime = GetWorld()->GetTimeSeconds();
+	Fragment.SetEntryState(EYapFragmentEntryStateFlags::Success);
+	IncrementActivations(Context, FragmentIndex);
+
+	BindToSubsystemSpeechCompleteEvent(Handle);
+
+	TriggerSpeechStartPin(FragmentIndex);
+
+	Subsystem->CullSpeech(Handle);
+
+	// Talk and Advance nodes move on without waiting for their speech to complete
+	if (GetNodeType() == EYapDialogueNodeType::TalkAndAdvance)
+	{
+		OnPaddingComplete(Handle);
+	}
+}
+
+void UFlowNode_YapDialogue::AddRunningFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex)
+{
+	if (Context.RunningFragments.Num() == 0)
 	{
 		if (GetNodeType() != EYapDialogueNodeType::TalkAndAdvance)
 		{
-			UYapSubsystem::Get(this)->OnAdvanceConversationDelegate.AddDynamic(this, &ThisClass::OnAdvanceConversation);
+			// Unique, other activations of this node may have bound already
+			UYapSubsystem::Get(this)->OnAdvanceConversationDelegate.AddUniqueDynamic(this, &ThisClass::OnAdvanceConversation);
 		}
 	}
 
-	RunningFragments.Add(Handle, FragmentIndex);
+	Context.RunningFragments.Add(Handle, FragmentIndex);
+	SpeechContexts.Add(Handle, Context.Index);
 }
 
-void UFlowNode_YapDialogue::RemoveRunningFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex)
+void UFlowNode_YapDialogue::RemoveRunningFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex)
 {
-	RunningFragments.Remove(Handle);
+	Context.RunningFragments.Remove(Handle);
+	SpeechContexts.Remove(Handle);
 
-	if (RunningFragments.Num() == 0)
+	if (Context.RunningFragments.Num() == 0)
 	{
 		if (GetNodeType() != EYapDialogueNodeType::TalkAndAdvance)
 		{
 			//UYapSubsystem::Get(this)->OnAdvanceConversationDelegate.RemoveDynamic(this, &ThisClass::OnAdvanceConversation);
 		}
 
-		InConversation = NAME_None;
+		Context.InConversation = NAME_None;
+		Context.ConversationHandle.Invalidate();
+
+		TryReleaseContext(Context);
 	}
 }
 
@@ -909,30 +1393,31 @@ void UFlowNode_YapDialogue::UnbindToSubsystemSpeechCompleteEvent(const FYapSpeec
 
 void UFlowNode_YapDialogue::OnSpeechComplete(UObject* Instigator, FYapSpeechHandle Handle, EYapSpeechCompleteResult Result)
 {
-	uint8* FragmentIndex = RunningFragments.Find(Handle);
+	FYapDialogueNodeContext* Context = FindSpeechContext(Handle);
 	
-	if (!FragmentIndex)
+	if (!Context)
 	{
 		UE_LOG(LogYap, VeryVerbose, TEXT("%s: OnSpeechComplete; ignored; handle {%s} was not running"), *GetName(), *Handle.ToString());
 		return;
 	}
-	
-	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: OnSpeechComplete {%s}"), *GetName(), *FragmentIndex, *Handle.ToString());
 
-	FYapFragment& Fragment = Fragments[*FragmentIndex];
+	// Copied, finishing the fragment removes it from the running fragments
+	const uint8 FragmentIndex = Context->RunningFragments.FindChecked(Handle);
+	
+	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: OnSpeechComplete {%s}"), *GetName(), FragmentIndex, *Handle.ToString());
 	
-	SpeakingFragments.Remove(Handle);
+	Context->SpeakingFragments.Remove(Handle);
 
-	TriggerSpeechEndPin(*FragmentIndex);
+	TriggerSpeechEndPin(FragmentIndex);
 
 	// No positive padding - this fragment is done
-	if (!FragmentsInPadding.Contains(Handle))
+	if (!Context->FragmentsInPadding.Contains(Handle))
 	{
-		FinishFragment(Handle, *FragmentIndex);
+		FinishFragment(*Context, Handle, FragmentIndex);
 
 		if (GetNodeType() != EYapDialogueNodeType::TalkAndAdvance)
 		{
-			TryAdvanceFromFragment(Handle, *FragmentIndex);
+			TryAdvanceFromFragment(*Context, Handle, FragmentIndex);
 		}
 	}
 }
@@ -946,66 +1431,64 @@ void UFlowNode_YapDialogue::OnPaddingComplete(FYapSpeechHandle Handle)
 		return;
 	}
 	
-	uint8* FragmentIndex = RunningFragments.Find(Handle);
+	FYapDialogueNodeContext* Context = FindSpeechContext(Handle);
 	
-	if (!FragmentIndex)
+	if (!Context)
 	{
 		UE_LOG(LogYap, VeryVerbose, TEXT("%s: OnPaddingComplete call ignored; handle {%s} was not running"), *GetName(), *Handle.ToString());
 		return;
 	}
 
-	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: OnPaddingComplete {%s}"), *GetName(), *FragmentIndex, *Handle.ToString());
+	const uint8 FragmentIndex = Context->RunningFragments.FindChecked(Handle);
 
-	FragmentsInPadding.Remove(Handle);
+	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: OnPaddingComplete {%s}"), *GetName(), FragmentIndex, *Handle.ToString());
+
+	Context->FragmentsInPadding.Remove(Handle);
 	
-	if (!SpeakingFragments.Contains(Handle))
+	if (!Context->SpeakingFragments.Contains(Handle))
 	{
 		// Positive padding - we've already finished speaking, this fragment is done
-		FinishFragment(Handle, *FragmentIndex);
-		TryAdvanceFromFragment(Handle, *FragmentIndex);
+		FinishFragment(*Context, Handle, FragmentIndex);
+		TryAdvanceFromFragment(*Context, Handle, FragmentIndex);
 	}
 	else
 	{
 		// Negative padding - we MUST advance now, but the fragment isn't done
-		AdvanceFromFragment(Handle, *FragmentIndex);
+		AdvanceFromFragment(*Context, Handle, FragmentIndex);
 	}
 }
 
 // ------------------------------------------------------------------------------------------------
 
-void UFlowNode_YapDialogue::FinishFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex)
+void UFlowNode_YapDialogue::FinishFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex)
 {
 	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: FinishFragment {%s}"), *GetName(), FragmentIndex, *Handle.ToString());
 		
-	FYapFragment& Fragment = Fragments[FragmentIndex];
-	
-	Fragment.SetEndTime(GetWorld()->GetTimeSeconds());
+	Context.FragmentStates[FragmentIndex].EndTime = GetWorld()->GetTimeSeconds();
 
-	RemoveRunningFragment(Handle, FragmentIndex);
+	RemoveRunningFragment(Context, Handle, FragmentIndex);
 }
 
 // ------------------------------------------------------------------------------------------------
 
-void UFlowNode_YapDialogue::TryAdvanceFromFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex)
+void UFlowNode_YapDialogue::TryAdvanceFromFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex)
 {
-	if (FocusedFragmentIndex != FragmentIndex)
+	if (Context.FocusedFragmentIndex != FragmentIndex)
 	{
-		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: TryAdvanceFromFragment failed; current focused fragment is: %s"), *GetName(), FragmentIndex, FocusedFragmentIndex.IsSet() ? *FString::FromInt(FocusedFragmentIndex.GetValue()) : TEXT("UNSET") );
+		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: TryAdvanceFromFragment failed; current focused fragment is: %s"), *GetName(), FragmentIndex, Context.FocusedFragmentIndex.IsSet() ? *FString::FromInt(Context.FocusedFragmentIndex.GetValue()) : TEXT("UNSET") );
 		return;
 	}
 	
-	FYapFragment& Fragment = Fragments[FragmentIndex];
-
 	bool bInConversation = UYapSubsystem::IsNodeInConversation(this);
 	
 	// TODO When calling AdvanceFromFragment in Skip function, if the game is set to do manual advancement, this won't run. Push this into a separate function I can call or add another route into this.
-	if (bForceAdvanceOnSpeechComplete || GetFragmentAutoAdvance(FragmentIndex, bInConversation))
+	if (Context.bForceAdvanceOnSpeechComplete || GetFragmentAutoAdvance(FragmentIndex, bInConversation))
 	{
-		bForceAdvanceOnSpeechComplete = false;
+		Context.bForceAdvanceOnSpeechComplete = false;
 		
 		UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: TryAdvanceFromFragment passed - GetFragmentAutoAdvance true)"), *GetName(), FragmentIndex);
 
-		AdvanceFromFragment(Handle, FragmentIndex);
+		AdvanceFromFragment(Context, Handle, FragmentIndex);
 	}
 	else
 	{
@@ -1019,33 +1502,39 @@ void UFlowNode_YapDialogue::TryAdvanceFromFragment(const FYapSpeechHandle& Handl
 		{
 		*/
 			UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: TryAdvanceFromFragment failed - fragment awaiting manual advance"), *GetName(), FragmentIndex);
-			Fragment.SetAwaitingManualAdvance();
+			Context.bAwaitingManualAdvance = true;
+			Context.FragmentStates[FragmentIndex].bAwaitingManualAdvance = true;
 		/*
 		}
 		*/
 	}
 }
 
-void UFlowNode_YapDialogue::AdvanceFromFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex)
+void UFlowNode_YapDialogue::AdvanceFromFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex)
 {
 	UE_LOG(LogYap, VeryVerbose, TEXT("%s [%i]: AdvanceFromFragment"), *GetName(), FragmentIndex);
 	
-	FYapFragment& Fragment = Fragments[FragmentIndex];
+	FYapDialogueFragmentRunState& FragmentState = Context.FragmentStates[FragmentIndex];
 	
-	Fragment.SetRunState(EYapFragmentRunState::Idle);
+	FragmentState.RunState = EYapFragmentRunState::Idle;
 	
-	if (FragmentIndex != FocusedFragmentIndex)
+	if (FragmentIndex != Context.FocusedFragmentIndex)
 	{
 		return;
 	}
 	
-	Fragment.ClearAwaitingManualAdvance();
-	
-	UYapSubsystem::Get(this)->OnAdvanceConversationDelegate.RemoveDynamic(this, &ThisClass::OnAdvanceConversation);
+	Context.bAwaitingManualAdvance = false;
+	FragmentState.bAwaitingManualAdvance = false;
+
+	// Other activations of this node may still be waiting for the conversation to advance
+	if (NumActiveContexts <= 1)
+	{
+		UYapSubsystem::Get(this)->OnAdvanceConversationDelegate.RemoveDynamic(this, &ThisClass::OnAdvanceConversation);
+	}
 
 	if (IsPlayerPrompt())
 	{
-		FinishNode(Fragment.GetPromptPin().PinName);
+		FinishNode(Context, Fragments[FragmentIndex].GetPromptPin().PinName);
 	}
 	else
 	{
@@ -1053,7 +1542,7 @@ void UFlowNode_YapDialogue::AdvanceFromFragment(const FYapSpeechHandle& Handle,
 		{
 			case EYapDialogueTalkSequencing::SelectOne:
 			{
-				FinishNode(OutputPinName);
+				FinishNode(Context, OutputPinName);
 				
 				break;
 			}
@@ -1061,14 +1550,14 @@ void UFlowNode_YapDialogue::AdvanceFromFragment(const FYapSpeechHandle& Handle,
 			{
 				for (uint8 NextIndex = FragmentIndex + 1; NextIndex < Fragments.Num(); ++NextIndex)
 				{
-					if (RunFragment(NextIndex))
+					if (RunFragment(Context, NextIndex))
 					{
 						// The next fragment will continue execution
 						return;
 					}
 				}
 			
-				FinishNode(OutputPinName);
+				FinishNode(Context, OutputPinName);
 					
 				break;
 			}
@@ -1076,21 +1565,21 @@ void UFlowNode_YapDialogue::AdvanceFromFragment(const FYapSpeechHandle& Handle,
 			{
 				for (uint8 NextIndex = FragmentIndex + 1; NextIndex < Fragments.Num(); ++NextIndex)
 				{
-					if (!RunFragment(NextIndex))
+					if (!RunFragment(Context, NextIndex))
 					{					
-						FinishNode(OutputPinName);
+						FinishNode(Context, OutputPinName);
 						
 						return;
 					}
 				}
 				
-				FinishNode(OutputPinName);
+				FinishNode(Context, OutputPinName);
 
 				break;
 			}
 			case EYapDialogueTalkSequencing::SelectRandom:
 			{
-				FinishNode(OutputPinName);
+				FinishNode(Context, OutputPinName);
 				
 				break;
 			}
@@ -1250,16 +1739,16 @@ FYapFragment& UFlowNode_YapDialogue::GetFragmentMutableByIndex(uint8 Index)
 
 void UFlowNode_YapDialogue::OnPromptChosen(UObject* Instigator, FYapPromptHandle Handle)
 {
-	uint8* FragmentIndex = PromptIndices.Find(Handle);
-
-	if (FragmentIndex)
+	for (FYapDialogueNodeContext& Context : Contexts)
 	{
-		RunPrompt(*FragmentIndex);
-	}
-	else
-	{
-		UE_LOG(LogYap, Error, TEXT("%s: Tried to choose prompt but could not find {%s}"), *GetName(), *Handle.ToString())
+		if (const uint8* FragmentIndex = Context.bActive ? Context.PromptIndices.Find(Handle) : nullptr)
+		{
+			RunPrompt(Context, *FragmentIndex);
+			return;
+		}
 	}
+
+	UE_LOG(LogYap, Error, TEXT("%s: Tried to choose prompt but could not find {%s}"), *GetName(), *Handle.ToString())
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1633,6 +2122,11 @@ bool UFlowNode_YapDialogue::ToggleNodeType(bool bHasOutputConnections)
 
 FString UFlowNode_YapDialogue::GetStatusString() const
 {
+	if (NumActiveContexts > 1)
+	{
+		return FString::Printf(TEXT("%i instances"), NumActiveContexts);
+	}
+	
 	return {};
 }
 #endif
@@ -1680,9 +2174,83 @@ void UFlowNode_YapDialogue::PostLoad()
 	TriggerPreload();
 }
 
+void UFlowNode_YapDialogue::BakeFragmentTimes()
+{
+	const UYapNodeConfig& NodeConfig = GetNodeConfig();
+	
+	BakedFragmentTimes.Reset(Fragments.Num() * 2);
+
+	for (const FYapFragment& Fragment : Fragments)
+	{
+		for (EYapMaturitySetting MaturitySetting : { EYapMaturitySetting::Mature, EYapMaturitySetting::ChildSafe })
+		{
+			// Audio duration needs the asset; load it here so that evaluating doesn't warn about sync loads
+			(void)Fragment.GetBit(nullptr, MaturitySetting).GetDialogueAudioAsset_SoftPtr<UObject>().LoadSynchronous();
+			
+			BakedFragmentTimes.Add(Fragment.EvaluateTimes(nullptr, MaturitySetting, EYapLoadContext::DoNotLoad, NodeConfig));
+		}
+	}
+}
+
+void UFlowNode_YapDialogue::CookAdditionalFilesOverride(const TCHAR* PackageFilename, const ITargetPlatform* TargetPlatform, TFunctionRef<void(const TCHAR* Filename, void* Data, int64 Size)> WriteAdditionalFile)
+{
+	Super::CookAdditionalFilesOverride(PackageFilename, TargetPlatform, WriteAdditionalFile);
+
+	const UFlowAsset* FlowAsset = GetFlowAsset();
+	
+	if (IsTemplate() || !IsValid(FlowAsset))
+	{
+		return;
+	}
+
+	// There is one database per Flow asset; the dialogue node with the lowest GUID writes it, whichever node the cooker gets to first
+	FGuid WriterGuid = GetGuid();
+	
+	for (const auto& [Guid, Node] : FlowAsset->GetNodes())
+	{
+		if (Node && Node->IsA<UFlowNode_YapDialogue>() && Node->GetGuid() < WriterGuid)
+		{
+			WriterGuid = Node->GetGuid();
+		}
+	}
+
+	if (WriterGuid != GetGuid())
+	{
+		return;
+	}
+
+	TArray<uint8> DatabaseData;
+	FYapDialogueDatabase::Build(FlowAsset, DatabaseData);
+
+	const FString DatabaseFilename = YapDialogueDatabase::GetFilename(PackageFilename);
+	
+	WriteAdditionalFile(*DatabaseFilename, DatabaseData.GetData(), DatabaseData.Num());
+}
+
 void UFlowNode_YapDialogue::PreSave(FObjectPreSaveContext SaveContext)
 {
 	Super::PreSave(SaveContext);
+
+	// Word counts are otherwise only updated while editing text, so they can be stale; recount them all for the cooked data
+	if (SaveContext.IsCooking() && UYapProjectSettings::CacheFragmentWordCountAutomatically())
+	{
+		TArray<FYapText*> Texts;
+		Texts.Reserve(Fragments.Num() * 4);
+		
+		for (FYapFragment& Fragment : Fragments)
+		{
+			Fragment.GatherTexts(Texts);
+		}
+
+		FYapText::UpdateInternalWordCounts(Texts);
+	}
+
+	BakedFragmentTimes.Reset();
+	
+	if (SaveContext.IsCooking())
+	{
+		BakeFragmentTimes();
+	}
 	
 	// TODO this should be removed in ~2026
 	if (!IsTemplate() && !GEditor->IsPlayingSessionInEditor())
@@ -1819,4 +2387,15 @@ void UFlowNode_YapDialogue::PreloadContent()
 
 // ------------------------------------------------------------------------------------------------
 
+void UFlowNode_YapDialogue::PrefetchContent(TAsyncLoadPriority Priority, TArray<TSharedPtr<FStreamableHandle>>& OutHandles)
+{
+	// Only called while the flow runs, so there is always a game world
+	for (const FYapFragment& Fragment : Fragments)
+	{
+		Fragment.PrefetchContent(GetWorld(), EYapMaturitySetting::Unspecified, Priority, OutHandles);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,154 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapAudioDurationCache.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeRWLock.h"
+#include "Yap/YapLog.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+FYapAudioDurationCache& FYapAudioDurationCache::Get()
+{
+	static FYapAudioDurationCache* Instance = []
+	{
+		FYapAudioDurationCache* NewInstance = new FYapAudioDurationCache();
+		NewInstance->Load();
+		return NewInstance;
+	}();
+
+	return *Instance;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TOptional<float> FYapAudioDurationCache::Find(const FSoftObjectPath& AudioAsset) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	if (const FEntry* Entry = Entries.Find(AudioAsset))
+	{
+		return Entry->Duration;
+	}
+
+	return NullOpt;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FString FYapAudioDurationCache::GetFilename()
+{
+	return FPaths::ProjectContentDir() / TEXT("Yap") / TEXT("Cache") / TEXT("AudioDurations.yapcache");
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapAudioDurationCache::Load()
+{
+	TArray<FString> Lines;
+
+	if (!FFileHelper::LoadFileToStringArray(Lines, *GetFilename()))
+	{
+		return;
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+
+	Entries.Reserve(Lines.Num());
+
+	for (const FString& Line : Lines)
+	{
+		// <Audio asset path> <Package hash> <Duration>
+		TArray<FString> Fields;
+		Line.ParseIntoArray(Fields, TEXT("\t"), false);
+
+		if (Fields.Num() != 3)
+		{
+			continue;
+		}
+
+		FEntry& Entry = Entries.Add(FSoftObjectPath(Fields[0]));
+		Entry.PackageHash = MoveTemp(Fields[1]);
+		Entry.Duration = FCString::Atof(*Fields[2]);
+	}
+
+	UE_LOG(LogYap, Verbose, TEXT("Loaded %i cached audio durations."), Entries.Num());
+}
+
+// ------------------------------------------------------------------------------------------------
+
+#if WITH_EDITOR
+const FString* FYapAudioDurationCache::FindHash(const FSoftObjectPath& AudioAsset) const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	const FEntry* Entry = Entries.Find(AudioAsset);
+
+	return Entry ? &Entry->PackageHash : nullptr;
+}
+
+void FYapAudioDurationCache::Set(const FSoftObjectPath& AudioAsset, float Duration, const FString& PackageHash)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	FEntry& Entry = Entries.FindOrAdd(AudioAsset);
+	Entry.Duration = Duration;
+	Entry.PackageHash = PackageHash;
+}
+
+int32 FYapAudioDurationCache::Prune(const TSet<FSoftObjectPath>& KeepAudioAssets)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	const int32 OldNum = Entries.Num();
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!KeepAudioAssets.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	return OldNum - Entries.Num();
+}
+
+void FYapAudioDurationCache::Invalidate(FName PackageName)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (It.Key().GetLongPackageFName() == PackageName)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+bool FYapAudioDurationCache::Save() const
+{
+	FReadScopeLock ReadLock(Lock);
+
+	TArray<FSoftObjectPath> SortedPaths;
+	Entries.GenerateKeyArray(SortedPaths);
+
+	// Sorted so that the file diffs cleanly in source control
+	SortedPaths.Sort([] (const FSoftObjectPath& A, const FSoftObjectPath& B) { return A.ToString() < B.ToString(); });
+
+	FString Output;
+
+	for (const FSoftObjectPath& Path : SortedPaths)
+	{
+		const FEntry& Entry = Entries[Path];
+		Output += FString::Printf(TEXT("%s\t%s\t%f\n"), *Path.ToString(), *Entry.PackageHash, Entry.Duration);
+	}
+
+	return FFileHelper::SaveStringToFile(Output, *GetFilename(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -3,7 +3,9 @@
 
 #include "Yap/YapBit.h"
 
+#include "Yap/YapAudioDurationCache.h"
 #include "Yap/YapProjectSettings.h"
+#include "Yap/YapStats.h"
 #include "Yap/YapStreamableManager.h"
 #include "Yap/YapSubsystem.h"
 #include "Yap/Enums/YapLoadContext.h"
@@ -33,7 +35,7 @@ bool FYapBit::HasAudioAsset() const
 
 // --------------------------------------------------------------------------------------------
 
-TOptional<float> FYapBit::GetSpeechTime(UWorld* World, EYapTimeMode TimeMode, EYapLoadContext LoadContext, const UYapNodeConfig& Config) const
+TOptional<float> FYapBit::GetSpeechTime(UWorld* World, EYapTimeMode TimeMode, EYapLoadContext LoadContext, const UYapNodeConfig& Config, FName FragmentID) const
 {
 	// TODO clamp minimums from project settings?
 	TOptional<float> Time;
@@ -47,7 +49,13 @@ TOptional<float> FYapBit::GetSpeechTime(UWorld* World, EYapTimeMode TimeMode, EY
 		}
 		case EYapTimeMode::AudioTime:
 		{
-			Time = GetAudioTime(World, LoadContext);
+			Time = GetAudioTime(World, LoadContext, FragmentID);
+
+			// Only without a sync load: the audio isn't in yet, so time it by its text until it is
+			if (!Time.IsSet() && !AudioAsset.IsNull())
+			{
+				Time = GetTextTime(Config);
+			}
 			break;
 		}
 		case EYapTimeMode::TextTime:
@@ -70,32 +78,36 @@ TOptional<float> FYapBit::GetSpeechTime(UWorld* World, EYapTimeMode TimeMode, EY
 
 // --------------------------------------------------------------------------------------------
 
-void FYapBit::LoadContent(EYapLoadContext LoadContext) const
+void FYapBit::LoadContent(FName FragmentID, EYapLoadContext LoadContext, TAsyncLoadPriority Priority) const
 {
 	if (!AudioAsset.IsPending())
 	{
 		return;
 	}
+
+	YAP_SCOPE_ASSET(STAT_YapLoadContent, "Yap LoadContent", FragmentID, FName(NAME_None), AudioAsset.GetAssetName());
 	
 	switch (LoadContext)
 	{
 		case EYapLoadContext::Sync:
 		{
+			INC_DWORD_STAT(STAT_YapSyncLoads);
 			UE_LOG(LogYap, Warning, TEXT("Synchronously loading audio asset. This should not happen during gameplay! Try loading the flow asset sooner, or delaying dialogue.\nAsset: %s"), *AudioAsset->GetPathName());
 			(const_cast<FYapBit*>(this))->AudioAssetHandle = FYapStreamableManager::Get().RequestSyncLoad(AudioAsset.ToSoftObjectPath());
 			break;
 		}
 		case EYapLoadContext::Async:
 		{
-			(const_cast<FYapBit*>(this))->AudioAssetHandle = FYapStreamableManager::Get().RequestAsyncLoad(AudioAsset.ToSoftObjectPath());
+			(const_cast<FYapBit*>(this))->AudioAssetHandle = FYapStreamableManager::Get().RequestAsyncLoad(AudioAsset.ToSoftObjectPath(), FStreamableDelegate(), Priority);
 			break;
 		}
 		case EYapLoadContext::AsyncEditorOnly:
 		{
 #if WITH_EDITOR
-			if (!GEditor->IsPlaySessionInProgress())
+			// Kept, so that editor widgets can tell when the load finishes; requested once rather than on every widget refresh
+			if (!GEditor->IsPlaySessionInProgress() && !IsAudioAssetLoading())
 			{
-				FYapStreamableManager::Get().RequestAsyncLoad(AudioAsset.ToSoftObjectPath());
+				(const_cast<FYapBit*>(this))->AudioAssetHandle = FYapStreamableManager::Get().RequestAsyncLoad(AudioAsset.ToSoftObjectPath());
 			}
 #endif
 			break;
@@ -105,6 +117,32 @@ void FYapBit::LoadContent(EYapLoadContext LoadContext) const
 
 // --------------------------------------------------------------------------------------------
 
+TSharedPtr<FStreamableHandle> FYapBit::PrefetchContent(TAsyncLoadPriority Priority) const
+{
+	if (!AudioAsset.IsPending())
+	{
+		return nullptr;
+	}
+
+	return FYapStreamableManager::Get().RequestAsyncLoad(AudioAsset.ToSoftObjectPath(), FStreamableDelegate(), Priority);
+}
+
+// --------------------------------------------------------------------------------------------
+
+bool FYapBit::IsAudioAssetLoading() const
+{
+	return AudioAssetHandle.IsValid() && AudioAssetHandle->IsLoadingInProgress();
+}
+
+// --------------------------------------------------------------------------------------------
+
+bool FYapBit::IsAudioTimeReady() const
+{
+	return !AudioAsset.IsPending() || FYapAudioDurationCache::Get().Find(AudioAsset.ToSoftObjectPath()).IsSet();
+}
+
+// --------------------------------------------------------------------------------------------
+
 TOptional<float> FYapBit::GetTextTime(const UYapNodeConfig& NodeConfig) const
 {
 	int32 TWPM = NodeConfig.DialoguePlayback.TimeSettings.TextWordsPerMinute;
@@ -117,14 +155,20 @@ TOptional<float> FYapBit::GetTextTime(const UYapNodeConfig& NodeConfig) const
 
 // --------------------------------------------------------------------------------------------
 
-TOptional<float> FYapBit::GetAudioTime(UObject* WorldContext, EYapLoadContext LoadContext) const
+TOptional<float> FYapBit::GetAudioTime(UObject* WorldContext, EYapLoadContext LoadContext, FName FragmentID) const
 {
 	if (AudioAsset.IsNull())
 	{
 		return NullOpt;
 	}
 
-	LoadContent(LoadContext);
+	// Avoids loading the asset just to read its duration
+	if (const TOptional<float> CachedDuration = FYapAudioDurationCache::Get().Find(AudioAsset.ToSoftObjectPath()); CachedDuration.IsSet())
+	{
+		return CachedDuration;
+	}
+	
+	LoadContent(FragmentID, LoadContext);
 
 	UObject* Asset = AudioAsset.Get();
 
@@ -144,34 +188,34 @@ TOptional<float> FYapBit::GetAudioTime(UObject* WorldContext, EYapLoadContext Lo
 
 // --------------------------------------------------------------------------------------------
 
-/*
-
-FYapBit& FYapBit::operator=(const FYapBitReplacement& Replacement)
+void FYapBit::ApplyReplacement(const FYapBitReplacement& Replacement, EYapMaturitySetting MaturitySetting)
 {
-#define FLOWYAP_REPLACE(X) if (Replacement.X.IsSet()) {X = Replacement.X.GetValue(); }  
+	const bool bChildSafe = MaturitySetting == EYapMaturitySetting::ChildSafe;
 
-	FLOWYAP_REPLACE(SpeakerAsset);
-	FLOWYAP_REPLACE(DirectedAtAsset);
-	FLOWYAP_REPLACE(MatureTitleText);
+	const TOptional<FYapText>& ReplacementTitleText = bChildSafe ? Replacement.SafeTitleText : Replacement.MatureTitleText;
+	const TOptional<TSoftObjectPtr<UObject>>& ReplacementAudioAsset = bChildSafe ? Replacement.SafeAudioAsset : Replacement.MatureAudioAsset;
 
-	if (Replacement.bOverrideMatureDialogueText)
+	if (ReplacementTitleText.IsSet())
 	{
-		MatureDialogueText = Replacement.MatureDialogueText;
+		TitleText = ReplacementTitleText.GetValue();
+	}
+
+	if (bChildSafe ? Replacement.SafeDialogueText.IsSet() : Replacement.bOverrideMatureDialogueText)
+	{
+		DialogueText = bChildSafe ? Replacement.SafeDialogueText.GetValue() : Replacement.MatureDialogueText;
+	}
+
+	if (ReplacementAudioAsset.IsSet())
+	{
+		AudioAsset = ReplacementAudioAsset.GetValue();
+		AudioAssetHandle.Reset();
+	}
+
+	if (Replacement.ManualTime.IsSet())
+	{
+		ManualTime = Replacement.ManualTime.GetValue();
 	}
-	
-	//FLOWYAP_REPLACE(MatureDialogueText);
-	FLOWYAP_REPLACE(SafeTitleText);
-	FLOWYAP_REPLACE(SafeDialogueText);
-	FLOWYAP_REPLACE(MatureAudioAsset);
-	FLOWYAP_REPLACE(SafeAudioAsset);
-	FLOWYAP_REPLACE(MoodTag);
-	FLOWYAP_REPLACE(TimeMode);
-	FLOWYAP_REPLACE(ManualTime);
-	
-#undef FLOWYAP_REPLACE
-	return *this;
 }
-*/
 
 // --------------------------------------------------------------------------------------------
 // EDITOR API
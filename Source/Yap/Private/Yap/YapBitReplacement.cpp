@@ -0,0 +1,233 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapBitReplacement.h"
+
+#include "Yap/Enums/YapMaturitySetting.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBitReplacement::Overlay(const FYapBitReplacement& Other)
+{
+#define YAP_OVERLAY(X) if (Other.X.IsSet()) { X = Other.X; }
+
+	YAP_OVERLAY(SpeakerAsset);
+	YAP_OVERLAY(DirectedAtAsset);
+	YAP_OVERLAY(MatureTitleText);
+	YAP_OVERLAY(SafeTitleText);
+	YAP_OVERLAY(SafeDialogueText);
+	YAP_OVERLAY(MatureAudioAsset);
+	YAP_OVERLAY(SafeAudioAsset);
+	YAP_OVERLAY(MoodTag);
+	YAP_OVERLAY(TimeMode);
+	YAP_OVERLAY(ManualTime);
+
+#undef YAP_OVERLAY
+
+	if (Other.bOverrideMatureDialogueText)
+	{
+		bOverrideMatureDialogueText = true;
+		MatureDialogueText = Other.MatureDialogueText;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapBitReplacement::ChangesTimes() const
+{
+	return bOverrideMatureDialogueText || SafeDialogueText.IsSet() || MatureAudioAsset.IsSet() || SafeAudioAsset.IsSet() || ManualTime.IsSet();
+}
+
+// ================================================================================================
+
+void FYapBitReplacementLayers::Set(EYapBitReplacementLayer Layer, FName FragmentID, const FYapBitReplacement& Replacement)
+{
+	check(Layer < EYapBitReplacementLayer::COUNT);
+
+	Layers[static_cast<uint8>(Layer)].Add(FragmentID, Replacement);
+
+	Resolve(FragmentID);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBitReplacementLayers::Remove(EYapBitReplacementLayer Layer, FName FragmentID)
+{
+	check(Layer < EYapBitReplacementLayer::COUNT);
+
+	if (Layers[static_cast<uint8>(Layer)].Remove(FragmentID) > 0)
+	{
+		Resolve(FragmentID);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TSet<FName> FYapBitReplacementLayers::SetLayer(EYapBitReplacementLayer Layer, TMap<FName, FYapBitReplacement>&& Replacements)
+{
+	check(Layer < EYapBitReplacementLayer::COUNT);
+
+	TMap<FName, FYapBitReplacement>& LayerReplacements = Layers[static_cast<uint8>(Layer)];
+
+	// Everything which was or will be on this layer needs resolving again
+	TSet<FName> Affected;
+	Affected.Reserve(LayerReplacements.Num() + Replacements.Num());
+
+	for (const TPair<FName, FYapBitReplacement>& Replacement : LayerReplacements)
+	{
+		Affected.Add(Replacement.Key);
+	}
+
+	for (const TPair<FName, FYapBitReplacement>& Replacement : Replacements)
+	{
+		Affected.Add(Replacement.Key);
+	}
+
+	LayerReplacements = MoveTemp(Replacements);
+
+	for (FName FragmentID : Affected)
+	{
+		Resolve(FragmentID);
+	}
+
+	return Affected;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBitReplacementLayers::Reset()
+{
+	for (TMap<FName, FYapBitReplacement>& Layer : Layers)
+	{
+		Layer.Empty();
+	}
+
+	Resolved.Empty();
+
+	if (Parent)
+	{
+		for (const TPair<FName, TUniquePtr<FResolvedReplacement>>& Entry : Parent->Resolved)
+		{
+			Resolve(Entry.Key);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBitReplacementLayers::SetParent(const FYapBitReplacementLayers* InParent)
+{
+	check(InParent != this);
+
+	TSet<FName> Affected;
+
+	if (Parent)
+	{
+		Parent->Resolved.GetKeys(Affected);
+	}
+
+	Parent = InParent;
+
+	if (Parent)
+	{
+		for (const TPair<FName, TUniquePtr<FResolvedReplacement>>& Entry : Parent->Resolved)
+		{
+			Affected.Add(Entry.Key);
+		}
+	}
+
+	ResolveParentChanges(Affected);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBitReplacementLayers::ResolveParentChanges(const TSet<FName>& FragmentIDs)
+{
+	for (FName FragmentID : FragmentIDs)
+	{
+		Resolve(FragmentID);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FYapBit* FYapBitReplacementLayers::FindReplacementBit(FName FragmentID, EYapMaturitySetting MaturitySetting, const FYapBit& BaseBit) const
+{
+	const TUniquePtr<FResolvedReplacement>* Entry = Resolved.Find(FragmentID);
+
+	if (!Entry)
+	{
+		return nullptr;
+	}
+
+	const int32 BitIndex = MaturitySetting == EYapMaturitySetting::ChildSafe ? 1 : 0;
+
+	TOptional<FYapBit>& Bit = (*Entry)->Bits[BitIndex];
+
+	if (!Bit.IsSet())
+	{
+		Bit.Emplace(BaseBit);
+		Bit->ApplyReplacement((*Entry)->Replacement, MaturitySetting);
+	}
+
+	return &Bit.GetValue();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TOptional<FYapFragmentTimes>* FYapBitReplacementLayers::FindReplacementTimes(FName FragmentID, EYapMaturitySetting MaturitySetting) const
+{
+	const TUniquePtr<FResolvedReplacement>* Entry = Resolved.Find(FragmentID);
+
+	if (!Entry || !(*Entry)->Replacement.ChangesTimes())
+	{
+		return nullptr;
+	}
+
+	return &(*Entry)->Times[MaturitySetting == EYapMaturitySetting::ChildSafe ? 1 : 0];
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBitReplacementLayers::Resolve(FName FragmentID)
+{
+	TUniquePtr<FResolvedReplacement> Entry;
+
+	if (Parent)
+	{
+		if (const TUniquePtr<FResolvedReplacement>* ParentEntry = Parent->Resolved.Find(FragmentID))
+		{
+			Entry = MakeUnique<FResolvedReplacement>();
+			Entry->Replacement = (*ParentEntry)->Replacement;
+		}
+	}
+
+	for (const TMap<FName, FYapBitReplacement>& Layer : Layers)
+	{
+		if (const FYapBitReplacement* Replacement = Layer.Find(FragmentID))
+		{
+			if (!Entry.IsValid())
+			{
+				Entry = MakeUnique<FResolvedReplacement>();
+				Entry->Replacement = *Replacement;
+			}
+			else
+			{
+				Entry->Replacement.Overlay(*Replacement);
+			}
+		}
+	}
+
+	if (Entry.IsValid())
+	{
+		Resolved.Add(FragmentID, MoveTemp(Entry));
+	}
+	else
+	{
+		Resolved.Remove(FragmentID);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
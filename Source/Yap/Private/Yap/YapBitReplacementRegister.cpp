@@ -0,0 +1,92 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapBitReplacementRegister.h"
+
+#include "Yap/YapSubsystem.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::Deinitialize()
+{
+	// World subsystems normally go first; don't leave any pointing at layers which are about to be gone
+	for (const TWeakObjectPtr<UYapSubsystem>& Subsystem : WorldSubsystems)
+	{
+		if (Subsystem.IsValid())
+		{
+			Subsystem->BitReplacements.SetParent(nullptr);
+		}
+	}
+
+	WorldSubsystems.Empty();
+
+	BitReplacements.Reset();
+
+	Super::Deinitialize();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::Set(EYapBitReplacementLayer Layer, FName FragmentID, const FYapBitReplacement& Replacement)
+{
+	check(IsPersistentLayer(Layer));
+
+	BitReplacements.Set(Layer, FragmentID, Replacement);
+
+	ResolveInWorlds({ FragmentID });
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::Remove(EYapBitReplacementLayer Layer, FName FragmentID)
+{
+	check(IsPersistentLayer(Layer));
+
+	BitReplacements.Remove(Layer, FragmentID);
+
+	ResolveInWorlds({ FragmentID });
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::SetLayer(EYapBitReplacementLayer Layer, TMap<FName, FYapBitReplacement>&& Replacements)
+{
+	check(IsPersistentLayer(Layer));
+
+	ResolveInWorlds(BitReplacements.SetLayer(Layer, MoveTemp(Replacements)));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::AddWorldSubsystem(UYapSubsystem* Subsystem)
+{
+	WorldSubsystems.AddUnique(Subsystem);
+
+	Subsystem->BitReplacements.SetParent(&BitReplacements);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::RemoveWorldSubsystem(UYapSubsystem* Subsystem)
+{
+	WorldSubsystems.Remove(Subsystem);
+
+	Subsystem->BitReplacements.SetParent(nullptr);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBitReplacementRegister::ResolveInWorlds(const TSet<FName>& FragmentIDs)
+{
+	for (const TWeakObjectPtr<UYapSubsystem>& Subsystem : WorldSubsystems)
+	{
+		if (Subsystem.IsValid())
+		{
+			Subsystem->BitReplacements.ResolveParentChanges(FragmentIDs);
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
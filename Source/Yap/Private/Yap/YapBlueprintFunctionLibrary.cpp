@@ -8,6 +8,7 @@
 #endif
 
 #include "Yap/YapCharacterAsset.h"
+#include "Yap/YapConditionProgram.h"
 #include "Yap/YapLog.h"
 #include "Yap/YapProjectSettings.h"
 #include "Yap/Handles/YapPromptHandle.h"
@@ -89,4 +90,77 @@ AActor* UYapBlueprintFunctionLibrary::FindYapCharacterActor(UObject* WorldContex
 
 // ------------------------------------------------------------------------------------------------
 
+static TArray<AActor*> GetCharacterActors(const TArray<UYapCharacterComponent*>& Components)
+{
+	TArray<AActor*> Actors;
+	Actors.Reserve(Components.Num());
+
+	for (const UYapCharacterComponent* Component : Components)
+	{
+		Actors.Add(Component->GetOwner());
+	}
+
+	return Actors;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TArray<AActor*> UYapBlueprintFunctionLibrary::FindYapCharactersInRadius(UObject* WorldContext, FVector Center, float Radius)
+{
+	TArray<UYapCharacterComponent*> Components;
+	UYapSubsystem::Get(WorldContext)->GetCharacterGrid().QueryRadius(Center, Radius, Components);
+
+	return GetCharacterActors(Components);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TArray<AActor*> UYapBlueprintFunctionLibrary::FindYapCharactersInCone(UObject* WorldContext, FVector Origin, FVector Direction, float HalfAngle, float Range)
+{
+	TArray<UYapCharacterComponent*> Components;
+	UYapSubsystem::Get(WorldContext)->GetCharacterGrid().QueryCone(Origin, Direction, HalfAngle, Range, Components);
+
+	return GetCharacterActors(Components);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TArray<AActor*> UYapBlueprintFunctionLibrary::FindNearestYapCharacters(UObject* WorldContext, FVector Center, int32 Count, float MaxRadius)
+{
+	TArray<UYapCharacterComponent*> Components;
+	UYapSubsystem::Get(WorldContext)->GetCharacterGrid().QueryNearest(Center, Count, MaxRadius, Components);
+
+	return GetCharacterActors(Components);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBlueprintFunctionLibrary::InvalidateConditions()
+{
+	FYapConditionProgram::Invalidate(EYapConditionDependency::Game);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapBlueprintFunctionLibrary::StartSessionRecording(UObject* WorldContext)
+{
+	UYapSubsystem::Get(WorldContext)->StartSessionRecording();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FString UYapBlueprintFunctionLibrary::StopSessionRecording(UObject* WorldContext)
+{
+	return UYapSubsystem::Get(WorldContext)->StopSessionRecording();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool UYapBlueprintFunctionLibrary::ReplaySession(UObject* WorldContext, const FString& Filename)
+{
+	return UYapSubsystem::Get(WorldContext)->ReplaySession(Filename);
+}
+
+// ------------------------------------------------------------------------------------------------
+
 #undef LOCTEXT_NAMESPACE
@@ -4,7 +4,9 @@
 #include "Yap/YapBroker.h"
 
 #include "Components/AudioComponent.h"
+#include "Async/ParallelFor.h"
 #include "Internationalization/BreakIterator.h"
+#include "Yap/YapConditionProgram.h"
 #include "Yap/YapRunningFragment.h" 
 #include "Yap/YapLog.h"
 #include "Yap/YapProjectSettings.h"
@@ -14,14 +16,6 @@
 
 #define LOCTEXT_NAMESPACE "Yap"
 
-TOptional<bool> UYapBroker::bImplemented_Initialize = false;
-TOptional<bool> UYapBroker::bImplemented_GetMaturitySetting = false;
-TOptional<bool> UYapBroker::bImplemented_GetPlaybackSpeed = false;
-TOptional<bool> UYapBroker::bImplemented_GetAudioAssetDuration = false;
-#if WITH_EDITOR
-TOptional<bool> UYapBroker::bImplemented_PreviewAudioAsset = false;
-#endif
-
 bool UYapBroker::bWarned_Initialize = false;
 bool UYapBroker::bWarned_GetMaturitySetting = false;
 bool UYapBroker::bWarned_GetPlaybackSpeed = false;
@@ -36,7 +30,7 @@ bool UYapBroker::bWarned_PreviewAudioAsset = false;
 
 #define YAP_QUOTE(X) #X
 
-#define YAP_CALL_K2(FUNCTION, SHOW_UNIMPLEMENTED_WARNING, ...) CallK2Function<&UYapBroker::K2_##FUNCTION>(YAP_QUOTE(FUNCTION), bImplemented_##FUNCTION, bWarned_##FUNCTION, SHOW_UNIMPLEMENTED_WARNING __VA_OPT__(,) __VA_ARGS__)
+#define YAP_CALL_K2(FUNCTION, SHOW_UNIMPLEMENTED_WARNING, ...) CallK2Function<&UYapBroker::K2_##FUNCTION>(YAP_QUOTE(FUNCTION), GetCapabilities().b##FUNCTION, bWarned_##FUNCTION, SHOW_UNIMPLEMENTED_WARNING __VA_OPT__(,) __VA_ARGS__)
 
 void UYapBroker::Initialize()
 {
@@ -59,12 +53,18 @@ EYapMaturitySetting UYapBroker::GetMaturitySetting() const
 
 float UYapBroker::GetPlaybackSpeed() const
 {
+	// The default (unimplemented) playback speed is normal speed, not zero
+	if (!GetCapabilities().bGetPlaybackSpeed)
+	{
+		return 1.0f;
+	}
+	
 	return YAP_CALL_K2(GetPlaybackSpeed, false);
 }
 
 int32 UYapBroker::CalculateWordCount(const FText& Text) const
 {
-	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_CalculateWordCount))) // TODO cache this? Switch To YAP_CALL_K2?
+	if (GetCapabilities().bCalculateWordCount)
 	{
 		return K2_CalculateWordCount(Text);
 	}
@@ -72,42 +72,52 @@ int32 UYapBroker::CalculateWordCount(const FText& Text) const
 	// ------------------------------------------
 	// Default Implementation
 	
-	// Utility to count the number of words within a string (we use a line-break iterator to avoid counting the whitespace between the words)
 	TSharedRef<IBreakIterator> LineBreakIterator = FBreakIterator::CreateLineBreakIterator();
-	auto CountWords = [&LineBreakIterator](const FString& InTextToCount) -> int32
-	{
-		int32 NumWords = 0;
-		LineBreakIterator->SetString(InTextToCount);
 
-		int32 PreviousBreak = 0;
-		int32 CurrentBreak;
+	return CountWords(Text.ToString(), *LineBreakIterator);
+}
+
+void UYapBroker::CalculateWordCounts(TConstArrayView<FText> Texts, TArrayView<int32> OutWordCounts) const
+{
+	check(Texts.Num() == OutWordCounts.Num());
 
-		while ((CurrentBreak = LineBreakIterator->MoveToNext()) != INDEX_NONE)
+	// Blueprint implementations can only run on the game thread
+	if (GetCapabilities().bCalculateWordCount)
+	{
+		for (int32 i = 0; i < Texts.Num(); ++i)
 		{
-			if (CurrentBreak > PreviousBreak)
-			{
-				++NumWords;
-			}
-			PreviousBreak = CurrentBreak;
+			OutWordCounts[i] = K2_CalculateWordCount(Texts[i]);
 		}
 
-		LineBreakIterator->ClearString();
-		return NumWords;
-	};
+		return;
+	}
+
+	// ------------------------------------------
+	// Default Implementation
+
+	// Break iterators are expensive to create and not thread safe, so each worker gets its own
+	TArray<TSharedPtr<IBreakIterator>> LineBreakIterators;
 
-	return CountWords(Text.ToString());
+	ParallelForWithTaskContext(LineBreakIterators, Texts.Num(), [](int32 ContextIndex, int32 NumContexts)
+	{
+		return TSharedPtr<IBreakIterator>(FBreakIterator::CreateLineBreakIterator());
+	},
+	[&Texts, &OutWordCounts](TSharedPtr<IBreakIterator>& LineBreakIterator, int32 Index)
+	{
+		OutWordCounts[Index] = CountWords(Texts[Index].ToString(), *LineBreakIterator);
+	});
 }
 
 float UYapBroker::CalculateTextTime(int32 WordCount, int32 CharCount, const UYapNodeConfig& NodeConfig) const
 {
-	if (GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_CalculateTextTime))) // TODO cache this? Switch To YAP_CALL_K2?
+	if (GetCapabilities().bCalculateTextTime)
 	{
 		return K2_CalculateTextTime(WordCount, CharCount, &NodeConfig);
 	}
 	
 	int32 TWPM = NodeConfig.DialoguePlayback.TimeSettings.TextWordsPerMinute;
 	float SecondsPerWord = 60.0 / (float)TWPM;
-	float TalkTime = WordCount * SecondsPerWord * GetPlaybackSpeed();
+	float TalkTime = WordCount * SecondsPerWord * GetPlaybackSpeed_Internal();
 
 	float Min = NodeConfig.GetMinimumAutoTextTimeLength();
 		
@@ -318,19 +328,90 @@ void UYapBroker::Initialize_Internal()
 {
 	bWarned_Initialize = false;
 	bWarned_GetMaturitySetting = false;
+	bWarned_GetPlaybackSpeed = false;
 	bWarned_GetAudioAssetDuration = false;
 #if WITH_EDITOR
 	bWarned_PreviewAudioAsset = false;
 #endif // WITH_EDITOR
+
+	// Rebuild, in case the class was recompiled since this instance was last used
+	Capabilities.Reset();
+	(void)GetCapabilities();
+
+	NotifySettingsChanged();
 	
-	bImplemented_Initialize = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_Initialize));
-	bImplemented_GetMaturitySetting = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_GetMaturitySetting));
-	bImplemented_GetAudioAssetDuration = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_GetAudioAssetDuration));
+	Initialize();
+}
+
+const FYapBrokerCapabilities& UYapBroker::GetCapabilities() const
+{
+	if (!Capabilities.IsSet())
+	{
+		const UClass* Class = GetClass();
+		
+		FYapBrokerCapabilities NewCapabilities;
+		NewCapabilities.bInitialize = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_Initialize));
+		NewCapabilities.bGetMaturitySetting = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_GetMaturitySetting));
+		NewCapabilities.bGetPlaybackSpeed = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_GetPlaybackSpeed));
+		NewCapabilities.bCalculateWordCount = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_CalculateWordCount));
+		NewCapabilities.bCalculateTextTime = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_CalculateTextTime));
+		NewCapabilities.bGetAudioAssetDuration = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_GetAudioAssetDuration));
 #if WITH_EDITOR
-	bImplemented_PreviewAudioAsset = GetClass()->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_PreviewAudioAsset));
+		NewCapabilities.bPreviewAudioAsset = Class->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(UYapBroker, K2_PreviewAudioAsset));
 #endif // WITH_EDITOR
 
-	Initialize();
+		Capabilities = NewCapabilities;
+	}
+
+	return Capabilities.GetValue();
+}
+
+int32 UYapBroker::CountWords(const FString& String, IBreakIterator& LineBreakIterator)
+{
+	int32 NumWords = 0;
+	LineBreakIterator.SetString(String);
+
+	int32 PreviousBreak = 0;
+	int32 CurrentBreak;
+
+	while ((CurrentBreak = LineBreakIterator.MoveToNext()) != INDEX_NONE)
+	{
+		if (CurrentBreak > PreviousBreak)
+		{
+			++NumWords;
+		}
+		PreviousBreak = CurrentBreak;
+	}
+
+	LineBreakIterator.ClearString();
+	return NumWords;
+}
+
+EYapMaturitySetting UYapBroker::GetMaturitySetting_Internal() const
+{
+	if (CachedSettingsFrame != GFrameCounter)
+	{
+		CachedMaturitySetting = GetMaturitySetting();
+		CachedPlaybackSpeed = GetPlaybackSpeed();
+		CachedSettingsFrame = GFrameCounter;
+	}
+
+	return CachedMaturitySetting;
+}
+
+float UYapBroker::GetPlaybackSpeed_Internal() const
+{
+	// Both settings are refreshed together
+	(void)GetMaturitySetting_Internal();
+
+	return CachedPlaybackSpeed;
+}
+
+void UYapBroker::NotifySettingsChanged()
+{
+	CachedSettingsFrame = MAX_uint64;
+
+	FYapConditionProgram::Invalidate(EYapConditionDependency::Maturity);
 }
 
 #if WITH_EDITOR
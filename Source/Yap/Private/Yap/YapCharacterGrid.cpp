@@ -0,0 +1,296 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapCharacterGrid.h"
+
+#include "GameFramework/Actor.h"
+#include "Yap/YapCharacterComponent.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::Initialize(float InCellSize)
+{
+	check(InCellSize > 0.0f);
+
+	Reset();
+
+	CellSize = InCellSize;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::Reset()
+{
+	Entries.Empty();
+	FreeEntries.Empty();
+	ComponentToEntry.Empty();
+	Cells.Empty();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::Add(UYapCharacterComponent* Component)
+{
+	if (!IsValid(Component) || !Component->GetOwner() || ComponentToEntry.Contains(Component))
+	{
+		return;
+	}
+
+	const int32 EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Component = Component;
+	Entry.Key = Component;
+	Entry.Location = Component->GetOwner()->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	Entry.bUsed = true;
+
+	ComponentToEntry.Add(Component, EntryIndex);
+
+	LinkToCell(EntryIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::Remove(const UYapCharacterComponent* Component)
+{
+	int32 EntryIndex;
+
+	if (ComponentToEntry.RemoveAndCopyValue(Component, EntryIndex))
+	{
+		UnlinkFromCell(EntryIndex);
+		RemoveEntry(EntryIndex);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::Update()
+{
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+
+		if (!Entry.bUsed)
+		{
+			continue;
+		}
+
+		const UYapCharacterComponent* Component = Entry.Component.Get();
+		const AActor* Actor = Component ? Component->GetOwner() : nullptr;
+
+		if (!Actor)
+		{
+			ComponentToEntry.Remove(Entry.Key);
+			UnlinkFromCell(EntryIndex);
+			RemoveEntry(EntryIndex);
+			continue;
+		}
+
+		Entry.Location = Actor->GetActorLocation();
+
+		const FIntPoint NewCell = GetCell(Entry.Location);
+
+		if (NewCell != Entry.Cell)
+		{
+			UnlinkFromCell(EntryIndex);
+			Entry.Cell = NewCell;
+			LinkToCell(EntryIndex);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::QueryRadius(const FVector& Center, float Radius, TArray<UYapCharacterComponent*>& OutComponents) const
+{
+	const double RadiusSquared = FMath::Square(static_cast<double>(Radius));
+
+	ForEachEntryInBox(Center, Radius, [&] (int32 EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+
+		if (FVector::DistSquared(Entry.Location, Center) <= RadiusSquared)
+		{
+			if (UYapCharacterComponent* Component = Entry.Component.Get())
+			{
+				OutComponents.Add(Component);
+			}
+		}
+	});
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, TArray<UYapCharacterComponent*>& OutComponents) const
+{
+	const FVector Axis = Direction.GetSafeNormal();
+	const double RangeSquared = FMath::Square(static_cast<double>(Range));
+	const double CosHalfAngle = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+
+	ForEachEntryInBox(Origin, Range, [&] (int32 EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+
+		const FVector ToEntry = Entry.Location - Origin;
+		const double DistanceSquared = ToEntry.SizeSquared();
+
+		if (DistanceSquared > RangeSquared)
+		{
+			return;
+		}
+
+		// Compared without normalizing: dot >= |v| * cos, squared with the sign kept
+		const double Dot = ToEntry | Axis;
+		const bool bInCone = DistanceSquared == 0.0 || (CosHalfAngle >= 0.0
+			? Dot >= 0.0 && Dot * Dot >= DistanceSquared * CosHalfAngle * CosHalfAngle
+			: Dot >= 0.0 || Dot * Dot <= DistanceSquared * CosHalfAngle * CosHalfAngle);
+
+		if (bInCone)
+		{
+			if (UYapCharacterComponent* Component = Entry.Component.Get())
+			{
+				OutComponents.Add(Component);
+			}
+		}
+	});
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::QueryNearest(const FVector& Center, int32 Count, float MaxRadius, TArray<UYapCharacterComponent*>& OutComponents) const
+{
+	if (Count <= 0 || ComponentToEntry.Num() == 0)
+	{
+		return;
+	}
+
+	const double MaxRadiusSquared = MaxRadius > 0.0f ? FMath::Square(static_cast<double>(MaxRadius)) : TNumericLimits<double>::Max();
+
+	TArray<TPair<double, int32>, TInlineAllocator<32>> Candidates;
+
+	const FIntPoint CenterCell = GetCell(Center);
+
+	int32 NumVisited = 0;
+
+	// Visit square rings of cells outwards. Everything in ring R+1 is at least R cells away from Center, so once we have Count
+	// candidates closer than that, no later ring can improve on them.
+	for (int32 Ring = 0; ; ++Ring)
+	{
+		const double RingDistance = FMath::Max(Ring - 1, 0) * static_cast<double>(CellSize);
+
+		if (FMath::Square(RingDistance) > MaxRadiusSquared || NumVisited >= ComponentToEntry.Num())
+		{
+			break;
+		}
+
+		if (Candidates.Num() >= Count)
+		{
+			Candidates.Sort([] (const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+			Candidates.SetNum(Count, EAllowShrinking::No);
+
+			if (Candidates.Last().Key <= FMath::Square(RingDistance))
+			{
+				break;
+			}
+		}
+
+		auto VisitCell = [&] (int32 X, int32 Y)
+		{
+			if (const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y)))
+			{
+				for (int32 EntryIndex : *Cell)
+				{
+					++NumVisited;
+
+					const double DistanceSquared = FVector::DistSquared(Entries[EntryIndex].Location, Center);
+
+					if (DistanceSquared <= MaxRadiusSquared)
+					{
+						Candidates.Emplace(DistanceSquared, EntryIndex);
+					}
+				}
+			}
+		};
+
+		if (Ring == 0)
+		{
+			VisitCell(CenterCell.X, CenterCell.Y);
+			continue;
+		}
+
+		for (int32 Offset = -Ring; Offset <= Ring; ++Offset)
+		{
+			VisitCell(CenterCell.X + Offset, CenterCell.Y - Ring);
+			VisitCell(CenterCell.X + Offset, CenterCell.Y + Ring);
+		}
+
+		for (int32 Offset = -Ring + 1; Offset <= Ring - 1; ++Offset)
+		{
+			VisitCell(CenterCell.X - Ring, CenterCell.Y + Offset);
+			VisitCell(CenterCell.X + Ring, CenterCell.Y + Offset);
+		}
+	}
+
+	Candidates.Sort([] (const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; });
+
+	for (int32 i = 0; i < FMath::Min(Count, Candidates.Num()); ++i)
+	{
+		if (UYapCharacterComponent* Component = Entries[Candidates[i].Value].Component.Get())
+		{
+			OutComponents.Add(Component);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FVector* FYapCharacterGrid::FindLocation(const UYapCharacterComponent* Component) const
+{
+	const int32* EntryIndex = ComponentToEntry.Find(Component);
+
+	return EntryIndex ? &Entries[*EntryIndex].Location : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FIntPoint FYapCharacterGrid::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / CellSize), FMath::FloorToInt32(Location.Y / CellSize));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::LinkToCell(int32 EntryIndex)
+{
+	Cells.FindOrAdd(Entries[EntryIndex].Cell).Add(EntryIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::UnlinkFromCell(int32 EntryIndex)
+{
+	const FIntPoint& CellKey = Entries[EntryIndex].Cell;
+
+	if (TArray<int32>* Cell = Cells.Find(CellKey))
+	{
+		Cell->RemoveSingleSwap(EntryIndex, EAllowShrinking::No);
+
+		if (Cell->IsEmpty())
+		{
+			Cells.Remove(CellKey);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapCharacterGrid::RemoveEntry(int32 EntryIndex)
+{
+	Entries[EntryIndex] = FEntry();
+	FreeEntries.Add(EntryIndex);
+}
+
+#undef LOCTEXT_NAMESPACE
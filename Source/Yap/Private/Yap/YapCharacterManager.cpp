@@ -6,6 +6,7 @@
 #include "Yap/YapCharacterAsset.h"
 #include "Yap/YapLog.h"
 #include "Yap/YapProjectSettings.h"
+#include "Yap/YapStats.h"
 #include "Yap/YapStreamableManager.h"
 #include "Yap/YapSubsystem.h"
 #include "Yap/Interfaces/IYapCharacterInterface.h"
@@ -15,7 +16,7 @@
 
 // ================================================================================================
 
-TSharedPtr<FStreamableHandle> FYapCharacterRegisteredInstance::RequestLoadAsync()
+TSharedPtr<FStreamableHandle> FYapCharacterRegisteredInstance::RequestLoadAsync(TAsyncLoadPriority Priority)
 {
 	if (IsValid(CharacterHardPtr))
 	{
@@ -27,7 +28,7 @@ TSharedPtr<FStreamableHandle> FYapCharacterRegisteredInstance::RequestLoadAsync(
 		return nullptr;
 	}
 
-	return FYapStreamableManager::Get().RequestAsyncLoad(CharacterSoftPtr.ToSoftObjectPath());
+	return FYapStreamableManager::Get().RequestAsyncLoad(CharacterSoftPtr.ToSoftObjectPath(), FStreamableDelegate(), Priority);
 }
 
 TSharedPtr<FStreamableHandle> FYapCharacterRegisteredInstance::RequestLoad()
@@ -41,7 +42,17 @@ TSharedPtr<FStreamableHandle> FYapCharacterRegisteredInstance::RequestLoad()
 
 // ------------------------------------------------------------------------------------------------
 
-UObject* FYapCharacterRegisteredInstance::GetLoadedCharacter()
+UObject* FYapCharacterRegisteredInstance::GetLoadedCharacter() const
+{
+	if (IsValid(CharacterHardPtr))
+	{
+		return CharacterHardPtr;
+	}
+
+	return CharacterSoftPtr.Get();
+}
+
+UObject* FYapCharacterRegisteredInstance::LoadCharacterSync()
 {
 	if (IsValid(CharacterHardPtr))
 	{
@@ -55,6 +66,8 @@ UObject* FYapCharacterRegisteredInstance::GetLoadedCharacter()
 
 	if (CharacterSoftPtr.IsPending())
 	{
+		INC_DWORD_STAT(STAT_YapSyncLoads);
+		
 #if !UE_BUILD_SHIPPING
 		UE_LOG(LogYap, Warning, TEXT("Sync-loading character <%s>, this will cause a hitch! Try to request loading sooner."), *CharacterSoftPtr.GetAssetName());
 #endif
@@ -109,7 +122,7 @@ void UYapCharacterManager::RegisterCharacter(FName CharacterID,	const FYapCharac
 
 	CharacterDefinition.InitializeCharacter(NewCharacter);
 
-	RegisteredCharacters.Add(CharacterID, NewCharacter);
+	AddRegistration(CharacterID, FYapCharacterRegisteredInstance(NewCharacter));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -120,8 +133,8 @@ void UYapCharacterManager::RegisterCharacter(FName CharacterID, TSoftObjectPtr<U
 	{
 		return;
 	}
-	
-	RegisteredCharacters.Add(CharacterID, Character);
+
+	AddRegistration(CharacterID, FYapCharacterRegisteredInstance(Character));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -132,45 +145,253 @@ void UYapCharacterManager::RegisterCharacter(FName CharacterID, UObject* Charact
 	{
 		return;
 	}
-	
-	RegisteredCharacters.Add(CharacterID, Character);
+
+	AddRegistration(CharacterID, FYapCharacterRegisteredInstance(Character));
 }
 
 // ------------------------------------------------------------------------------------------------
 
 void UYapCharacterManager::UnregisterCharacter(FName CharacterID)
 {
-	RegisteredCharacters.Remove(CharacterID);
+	FYapCharacterRegisteredInstance Removed;
+	
+	if (RegisteredCharacters.RemoveAndCopyValue(CharacterID, Removed))
+	{
+		ReleaseResidency(Removed);
+
+		// Anyone still waiting on this character gets nothing
+		for (FYapOnCharacterLoaded& Callback : Removed.PendingCallbacks)
+		{
+			Callback.ExecuteIfBound(nullptr);
+		}
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
 
-TScriptInterface<IYapCharacterInterface> UYapCharacterManager::FindCharacter(FName CharacterID)
+EYapCharacterLoadState UYapCharacterManager::FindCharacter(FName CharacterID, TScriptInterface<IYapCharacterInterface>& OutCharacter, FYapOnCharacterLoaded OnLoaded)
 {
+	YAP_SCOPE(STAT_YapFindCharacter, "Yap FindCharacter", FName(NAME_None), CharacterID);
+	
+	OutCharacter = nullptr;
+	
 	FYapCharacterRegisteredInstance* Existing = RegisteredCharacters.Find(CharacterID);
 
-	if (Existing)
+	if (!Existing)
+	{
+		return EYapCharacterLoadState::NotRegistered;
+	}
+
+	if (UObject* Character = Existing->GetLoadedCharacter())
+	{
+		MarkResident(CharacterID, *Existing);
+		
+		OutCharacter = TScriptInterface<IYapCharacterInterface>(Character);
+		return EYapCharacterLoadState::Loaded;
+	}
+
+	if (Existing->GetSoftPtr().IsNull())
+	{
+		// Hard-registered character which has since been destroyed
+		return EYapCharacterLoadState::NotRegistered;
+	}
+
+	if (OnLoaded.IsBound())
+	{
+		Existing->PendingCallbacks.Add(MoveTemp(OnLoaded));
+	}
+
+	if (!Existing->PendingLoad.IsValid())
+	{
+		FStreamableDelegate OnComplete = FStreamableDelegate::CreateUObject(this, &ThisClass::OnCharacterLoaded, CharacterID);
+		
+		Existing->PendingLoad = FYapStreamableManager::Get().RequestAsyncLoad(Existing->GetSoftPtr().ToSoftObjectPath(), OnComplete, FStreamableManager::AsyncLoadHighPriority);
+	}
+
+	return EYapCharacterLoadState::Pending;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TScriptInterface<IYapCharacterInterface> UYapCharacterManager::FindCharacter(FName CharacterID, EYapLoadContext LoadContext)
+{
+	if (LoadContext == EYapLoadContext::Sync)
+	{
+		YAP_SCOPE(STAT_YapFindCharacter, "Yap FindCharacter (Sync)", FName(NAME_None), CharacterID);
+		
+		FYapCharacterRegisteredInstance* Existing = RegisteredCharacters.Find(CharacterID);
+
+		if (!Existing)
+		{
+			return nullptr;
+		}
+
+		UObject* Character = Existing->LoadCharacterSync();
+
+		if (Character)
+		{
+			MarkResident(CharacterID, *Existing);
+		}
+
+		return TScriptInterface<IYapCharacterInterface>(Character);
+	}
+
+	TScriptInterface<IYapCharacterInterface> Character;
+
+	if (LoadContext == EYapLoadContext::DoNotLoad)
 	{
-		return TScriptInterface<IYapCharacterInterface>(Existing->GetLoadedCharacter());
+		if (const FYapCharacterRegisteredInstance* Existing = RegisteredCharacters.Find(CharacterID))
+		{
+			Character = TScriptInterface<IYapCharacterInterface>(Existing->GetLoadedCharacter());
+		}
+
+		return Character;
 	}
+	
+	FindCharacter(CharacterID, Character);
 
-	return TScriptInterface<IYapCharacterInterface>(nullptr);
+	return Character;
 }
 
 // ------------------------------------------------------------------------------------------------
 
-TSharedPtr<FStreamableHandle> UYapCharacterManager::RequestLoadAsync(FName CharacterID)
+TSharedPtr<FStreamableHandle> UYapCharacterManager::RequestLoadAsync(FName CharacterID, TAsyncLoadPriority Priority)
 {
 	FYapCharacterRegisteredInstance* Existing = RegisteredCharacters.Find(CharacterID);
 
 	if (Existing)
 	{
-		return Existing->RequestLoadAsync();
+		return Existing->RequestLoadAsync(Priority);
 	}
 
 	return nullptr;
 }
 
+// ------------------------------------------------------------------------------------------------
+
+void UYapCharacterManager::AddRegistration(FName CharacterID, FYapCharacterRegisteredInstance&& Instance)
+{
+	TArray<FYapOnCharacterLoaded> Callbacks;
+
+	if (FYapCharacterRegisteredInstance* Existing = RegisteredCharacters.Find(CharacterID))
+	{
+		ReleaseResidency(*Existing);
+
+		// Cancelling skips the completion delegate, which would otherwise resolve the callbacks against the new registration before it is loaded
+		if (Existing->PendingLoad.IsValid())
+		{
+			Existing->PendingLoad->CancelHandle();
+		}
+
+		Callbacks = MoveTemp(Existing->PendingCallbacks);
+	}
+
+	RegisteredCharacters.Add(CharacterID, MoveTemp(Instance));
+
+	for (FYapOnCharacterLoaded& Callback : Callbacks)
+	{
+		TScriptInterface<IYapCharacterInterface> Character;
+
+		if (FindCharacter(CharacterID, Character, Callback) != EYapCharacterLoadState::Pending)
+		{
+			Callback.ExecuteIfBound(Character);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapCharacterManager::OnCharacterLoaded(FName CharacterID)
+{
+	FYapCharacterRegisteredInstance* Existing = RegisteredCharacters.Find(CharacterID);
+
+	// Unregistered while loading
+	if (!Existing)
+	{
+		return;
+	}
+
+	Existing->PendingLoad.Reset();
+
+	UObject* Character = Existing->GetLoadedCharacter();
+
+	if (Character)
+	{
+		MarkResident(CharacterID, *Existing);
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Failed to load character <%s> for ID <%s>!"), *Existing->GetSoftPtr().ToString(), *CharacterID.ToString());
+	}
+
+	// Callbacks may register or unregister characters, which can reallocate the map
+	TArray<FYapOnCharacterLoaded> Callbacks = MoveTemp(Existing->PendingCallbacks);
+	
+	for (FYapOnCharacterLoaded& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound(TScriptInterface<IYapCharacterInterface>(Character));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapCharacterManager::MarkResident(FName CharacterID, FYapCharacterRegisteredInstance& Instance)
+{
+	if (!Instance.IsSoftRegistered())
+	{
+		return;
+	}
+
+	Instance.ResidentPtr = Instance.GetLoadedCharacter();
+
+	if (Instance.ResidentNode)
+	{
+		if (Instance.ResidentNode == ResidentCharacters.GetTail())
+		{
+			return;
+		}
+
+		// Relink the existing node rather than reallocating it
+		ResidentCharacters.RemoveNode(Instance.ResidentNode, false);
+		ResidentCharacters.AddTail(Instance.ResidentNode);
+	}
+	else
+	{
+		ResidentCharacters.AddTail(CharacterID);
+		Instance.ResidentNode = ResidentCharacters.GetTail();
+	}
+
+	const int32 Limit = FMath::Max(1, UYapProjectSettings::GetCharacterResidencyLimit());
+
+	while (ResidentCharacters.Num() > Limit)
+	{
+		TDoubleLinkedList<FName>::TDoubleLinkedListNode* Oldest = ResidentCharacters.GetHead();
+
+		if (FYapCharacterRegisteredInstance* Released = RegisteredCharacters.Find(Oldest->GetValue()))
+		{
+			UE_LOG(LogYap, VeryVerbose, TEXT("Releasing character <%s>, residency limit reached."), *Oldest->GetValue().ToString());
+			
+			Released->ResidentPtr = nullptr;
+			Released->ResidentNode = nullptr;
+		}
+
+		ResidentCharacters.RemoveNode(Oldest);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapCharacterManager::ReleaseResidency(FYapCharacterRegisteredInstance& Instance)
+{
+	if (Instance.ResidentNode)
+	{
+		ResidentCharacters.RemoveNode(Instance.ResidentNode);
+		Instance.ResidentNode = nullptr;
+	}
+
+	Instance.ResidentPtr = nullptr;
+}
+
 // ================================================================================================
 
 void UYapCharacterManager_BPFL::RegisterCharacter(UObject* WorldContext, FName CharacterID, UObject* CharacterObject, bool bReplaceExisting)
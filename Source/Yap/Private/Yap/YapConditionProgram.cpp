@@ -0,0 +1,161 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapConditionProgram.h"
+
+#include "Yap/YapCondition.h"
+#include "Yap/YapLog.h"
+#include "Yap/YapSubsystem.h"
+#include "Yap/DefaultConditions/YapCondition_MaturitySetting.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+uint32 FYapConditionProgram::MaturityEpoch = 0;
+uint32 FYapConditionProgram::GameEpoch = 0;
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapConditionProgram::Evaluate(TConstArrayView<TObjectPtr<UYapCondition>> Conditions, const UObject* Owner) const
+{
+	if (!IsCompiledFrom(Conditions))
+	{
+		Compile(Conditions, Owner);
+	}
+
+	if (Dependencies == EYapConditionDependency::None)
+	{
+		return true;
+	}
+	
+	const bool bMemoValid = MemoFrame == GFrameCounter
+		&& (!EnumHasAnyFlags(Dependencies, EYapConditionDependency::Maturity) || MemoMaturityEpoch == MaturityEpoch)
+		&& (!EnumHasAnyFlags(Dependencies, EYapConditionDependency::Game) || MemoGameEpoch == GameEpoch);
+
+	if (!bMemoValid)
+	{
+		bMemoResult = Run();
+		MemoFrame = GFrameCounter;
+		MemoMaturityEpoch = MaturityEpoch;
+		MemoGameEpoch = GameEpoch;
+	}
+
+	return bMemoResult;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapConditionProgram::Invalidate(EYapConditionDependency InDependencies)
+{
+	if (EnumHasAnyFlags(InDependencies, EYapConditionDependency::Maturity))
+	{
+		++MaturityEpoch;
+	}
+
+	if (EnumHasAnyFlags(InDependencies, EYapConditionDependency::Game))
+	{
+		++GameEpoch;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapConditionProgram::IsCompiledFrom(TConstArrayView<TObjectPtr<UYapCondition>> Conditions) const
+{
+	// Ops map 1:1 onto the source array, so a changed array is caught cheaply
+	if (Ops.Num() != Conditions.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < Ops.Num(); ++i)
+	{
+		if (Ops[i].Condition != Conditions[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapConditionProgram::Compile(TConstArrayView<TObjectPtr<UYapCondition>> Conditions, const UObject* Owner) const
+{
+	Ops.Reset(Conditions.Num());
+	Dependencies = EYapConditionDependency::None;
+	MemoFrame = MAX_uint64;
+
+	for (UYapCondition* Condition : Conditions)
+	{
+		FOp& Op = Ops.AddDefaulted_GetRef();
+		Op.Condition = Condition;
+		
+		if (!IsValid(Condition))
+		{
+			UE_LOG(LogYap, Warning, TEXT("%s: Ignoring null condition. Clean this up!"), *GetNameSafe(Owner));
+			Op.Op = EOp::Skip;
+		}
+		else if (Condition->GetClass() == UYapCondition_MaturitySetting::StaticClass())
+		{
+			// Exact class match only; a Blueprint child class may override the evaluation
+			Op.Op = EOp::MaturitySetting;
+			Dependencies |= EYapConditionDependency::Maturity;
+		}
+		else
+		{
+			Op.Op = EOp::Script;
+			Dependencies |= EYapConditionDependency::Game;
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapConditionProgram::Run() const
+{
+	for (const FOp& Op : Ops)
+	{
+		switch (Op.Op)
+		{
+			case EOp::MaturitySetting:
+			{
+				const UYapCondition_MaturitySetting* MaturityCondition = static_cast<const UYapCondition_MaturitySetting*>(Op.Condition);
+				
+				const EYapMaturitySetting RequiredSetting = MaturityCondition->GetRequiredSetting();
+				
+				const bool bResult = RequiredSetting == EYapMaturitySetting::Unspecified || RequiredSetting == UYapSubsystem::GetCurrentMaturitySetting(MaturityCondition->GetWorld());
+
+#if WITH_EDITORONLY_DATA
+				Op.Condition->LastEvaluation = bResult;
+#endif
+				
+				if (!bResult)
+				{
+					return false;
+				}
+				
+				break;
+			}
+			case EOp::Script:
+			{
+				if (!Op.Condition->EvaluateCondition_Internal())
+				{
+					return false;
+				}
+
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+#undef LOCTEXT_NAMESPACE
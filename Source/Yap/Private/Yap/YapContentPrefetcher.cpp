@@ -0,0 +1,88 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapContentPrefetcher.h"
+
+#include "FlowAsset.h"
+#include "Engine/StreamableManager.h"
+#include "Yap/YapLog.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapContentPrefetcher::PrefetchFrom(UFlowNode_YapDialogue* StartNode, int32 Depth)
+{
+	if (Depth <= 0 || !IsValid(StartNode))
+	{
+		return;
+	}
+
+	UFlowAsset* FlowAsset = StartNode->GetFlowAsset();
+
+	if (!IsValid(FlowAsset))
+	{
+		return;
+	}
+
+	Frontier.Reset();
+	Visited.Reset();
+
+	Swap(Handles, PreviousHandles);
+	Handles.Reset();
+
+	Frontier.Emplace(StartNode, 0);
+	Visited.Add(StartNode);
+
+	// Breadth-first, so nodes are requested nearest first
+	for (int32 i = 0; i < Frontier.Num(); ++i)
+	{
+		UFlowNode* Node = Frontier[i].Key;
+		const int32 Distance = Frontier[i].Value;
+
+		if (Distance > 0)
+		{
+			if (UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(Node))
+			{
+				// Below the default, so that a node's own preload always goes first
+				const TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority - Distance;
+
+				UE_LOG(LogYap, VeryVerbose, TEXT("%s: Prefetching content of %s (%i nodes ahead)"), *StartNode->GetName(), *DialogueNode->GetName(), Distance);
+
+				DialogueNode->PrefetchContent(Priority, Handles);
+			}
+		}
+
+		if (Distance >= Depth)
+		{
+			continue;
+		}
+
+		for (const FFlowPin& Pin : Node->GetOutputPins())
+		{
+			FConnectedPin OutputConnection = Node->GetConnection(Pin.PinName);
+
+			if (!OutputConnection.NodeGuid.IsValid())
+			{
+				continue;
+			}
+
+			UFlowNode* ConnectedNode = FlowAsset->GetNode(OutputConnection.NodeGuid);
+
+			if (!IsValid(ConnectedNode) || Visited.Contains(ConnectedNode))
+			{
+				continue;
+			}
+
+			Visited.Add(ConnectedNode);
+			Frontier.Emplace(ConnectedNode, Distance + 1);
+		}
+	}
+
+	PreviousHandles.Reset();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+#undef LOCTEXT_NAMESPACE
@@ -113,10 +113,22 @@ void FYapConversation::ReleaseClosingInterlock(UObject* Object)
 
 // ------------------------------------------------------------------------------------------------
 
+void FYapConversation::Suspend()
+{
+    bWantsToOpen = false;
+    bWantsToClose = false;
+    bSuspended = true;
+    
+    State = EYapConversationState::Closed;
+}
+
+// ------------------------------------------------------------------------------------------------
+
 void FYapConversation::FinishOpening(UObject* Instigator)
 {
     bWantsToOpen = false;
     bWantsToClose = false;
+    bSuspended = false;
     
     State = EYapConversationState::Open;
     
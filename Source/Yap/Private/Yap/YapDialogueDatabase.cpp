@@ -0,0 +1,512 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapDialogueDatabase.h"
+
+#include "FlowAsset.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Yap/YapBit.h"
+#include "Yap/YapLog.h"
+#include "Yap/YapStats.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+using namespace YapDialogueDatabase;
+
+// ------------------------------------------------------------------------------------------------
+
+uint32 YapDialogueDatabase::HashName(FName Name)
+{
+	return FCrc::StrCrc32(*Name.ToString().ToLower());
+}
+
+FString YapDialogueDatabase::GetFilename(const FString& PackageFilename)
+{
+	// Package filenames handed out by the cooker may or may not have an extension yet; SetExtension handles both
+	return FPaths::SetExtension(PackageFilename, Extension);
+}
+
+// ================================================================================================
+
+FName FYapDialogueDatabase::FFragmentView::GetAudioID() const
+{
+	return Database->GetName(Fragment->AudioID);
+}
+
+FName FYapDialogueDatabase::FFragmentView::GetDialogueID() const
+{
+	return Database->GetName(Database->Nodes[Fragment->Node].DialogueID);
+}
+
+FGameplayTag FYapDialogueDatabase::FFragmentView::GetSpeakerTag() const
+{
+	return Database->GetTag(Fragment->SpeakerTag);
+}
+
+FGameplayTag FYapDialogueDatabase::FFragmentView::GetDirectedAtTag() const
+{
+	return Database->GetTag(Fragment->DirectedAtTag);
+}
+
+FGameplayTag FYapDialogueDatabase::FFragmentView::GetMoodTag() const
+{
+	return Database->GetTag(Fragment->MoodTag);
+}
+
+FText FYapDialogueDatabase::FFragmentView::GetDialogueText(EYapMaturitySetting MaturitySetting) const
+{
+	return Database->GetText(GetBit(MaturitySetting).DialogueText);
+}
+
+FText FYapDialogueDatabase::FFragmentView::GetTitleText(EYapMaturitySetting MaturitySetting) const
+{
+	return Database->GetText(GetBit(MaturitySetting).TitleText);
+}
+
+const FYapFragmentTimes& FYapDialogueDatabase::FFragmentView::GetTimes(EYapMaturitySetting MaturitySetting) const
+{
+	return GetBit(MaturitySetting).Times;
+}
+
+const FBit& FYapDialogueDatabase::FFragmentView::GetBit(EYapMaturitySetting MaturitySetting) const
+{
+	return Fragment->Bits[MaturitySetting == EYapMaturitySetting::ChildSafe ? 1 : 0];
+}
+
+// ================================================================================================
+
+FYapDialogueDatabase::~FYapDialogueDatabase()
+{
+	// Only counted once Initialize succeeded
+	if (Header)
+	{
+		DEC_MEMORY_STAT_BY(STAT_YapDialogueDatabaseMemory, Size);
+	}
+
+	// The region must be released before the file it was mapped from
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TSharedPtr<const FYapDialogueDatabase> FYapDialogueDatabase::Open(const UFlowAsset* FlowAsset)
+{
+	if (!IsValid(FlowAsset))
+	{
+		return nullptr;
+	}
+
+	// Instances are transient objects; only the template's package has a database next to it
+	const UFlowAsset* TemplateAsset = GetTemplateAsset(FlowAsset);
+
+	FString PackageFilename;
+
+	if (!FPackageName::TryConvertLongPackageNameToFilename(TemplateAsset->GetPackage()->GetName(), PackageFilename))
+	{
+		return nullptr;
+	}
+
+	return OpenFile(GetFilename(PackageFilename));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const UFlowAsset* FYapDialogueDatabase::GetTemplateAsset(const UFlowAsset* FlowAsset)
+{
+	const UFlowAsset* TemplateAsset = FlowAsset ? FlowAsset->GetTemplateAsset() : nullptr;
+
+	return TemplateAsset ? TemplateAsset : FlowAsset;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TSharedPtr<const FYapDialogueDatabase> FYapDialogueDatabase::OpenFile(const FString& Filename)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!PlatformFile.FileExists(*Filename))
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FYapDialogueDatabase> Database = MakeShared<FYapDialogueDatabase>();
+
+	Database->MappedFile.Reset(PlatformFile.OpenMapped(*Filename));
+
+	if (Database->MappedFile.IsValid())
+	{
+		Database->MappedRegion.Reset(Database->MappedFile->MapRegion(0, Database->MappedFile->GetFileSize()));
+	}
+
+	bool bInitialized;
+
+	if (Database->MappedRegion.IsValid())
+	{
+		bInitialized = Database->Initialize(Database->MappedRegion->GetMappedPtr(), Database->MappedRegion->GetMappedSize());
+	}
+	else
+	{
+		// Mapping isn't supported everywhere (e.g. compressed pak entries), fall back to loading the whole file
+		Database->MappedFile.Reset();
+
+		bInitialized = FFileHelper::LoadFileToArray(Database->LoadedData, *Filename) && Database->Initialize(Database->LoadedData.GetData(), Database->LoadedData.Num());
+	}
+
+	if (!bInitialized)
+	{
+		UE_LOG(LogYap, Error, TEXT("Dialogue database <%s> is invalid or from an older version of Yap, ignoring it."), *Filename);
+		return nullptr;
+	}
+
+	return Database;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapDialogueDatabase::Initialize(const uint8* InData, int64 InSize)
+{
+	if (!InData || InSize < sizeof(FHeader))
+	{
+		return false;
+	}
+
+	const FHeader* InHeader = reinterpret_cast<const FHeader*>(InData);
+
+	if (InHeader->Magic != Magic || InHeader->Version != Version)
+	{
+		return false;
+	}
+
+	auto FitsInBlob = [InSize] (uint64 Offset, uint64 Count, uint64 ElementSize)
+	{
+		return Offset % 4 == 0 && Offset + Count * ElementSize <= static_cast<uint64>(InSize);
+	};
+
+	if (!FitsInBlob(InHeader->NodesOffset, InHeader->NumNodes, sizeof(FNode))
+		|| !FitsInBlob(InHeader->FragmentsOffset, InHeader->NumFragments, sizeof(FFragment))
+		|| !FitsInBlob(InHeader->AudioIDsOffset, InHeader->NumAudioIDs, sizeof(FAudioID))
+		|| !FitsInBlob(InHeader->StringsOffset, InHeader->StringsSize, 1)
+		|| InHeader->StringsSize == 0)
+	{
+		return false;
+	}
+
+	Data = InData;
+	Size = InSize;
+	Header = InHeader;
+	Nodes = MakeArrayView(reinterpret_cast<const FNode*>(Data + Header->NodesOffset), Header->NumNodes);
+	Fragments = MakeArrayView(reinterpret_cast<const FFragment*>(Data + Header->FragmentsOffset), Header->NumFragments);
+	AudioIDs = MakeArrayView(reinterpret_cast<const FAudioID*>(Data + Header->AudioIDsOffset), Header->NumAudioIDs);
+
+	INC_MEMORY_STAT_BY(STAT_YapDialogueDatabaseMemory, Size);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FNode* FYapDialogueDatabase::FindNodeRecord(FName DialogueID) const
+{
+	if (DialogueID.IsNone())
+	{
+		return nullptr;
+	}
+
+	const uint32 Hash = HashName(DialogueID);
+
+	for (int32 i = Algo::LowerBoundBy(Nodes, Hash, &FNode::DialogueIDHash); i < Nodes.Num() && Nodes[i].DialogueIDHash == Hash; ++i)
+	{
+		if (GetName(Nodes[i].DialogueID) == DialogueID)
+		{
+			return &Nodes[i];
+		}
+	}
+
+	return nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TArray<FYapDialogueDatabase::FFragmentView, TInlineAllocator<8>> FYapDialogueDatabase::FindNode(FName DialogueID) const
+{
+	TArray<FFragmentView, TInlineAllocator<8>> Result;
+
+	if (const FNode* Node = FindNodeRecord(DialogueID))
+	{
+		Result.Reserve(Node->NumFragments);
+
+		for (uint32 i = 0; i < Node->NumFragments; ++i)
+		{
+			Result.Add({ &Fragments[Node->FirstFragment + i], this });
+		}
+	}
+
+	return Result;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapDialogueDatabase::FFragmentView FYapDialogueDatabase::FindFragment(FName DialogueID, uint8 FragmentIndex) const
+{
+	const FNode* Node = FindNodeRecord(DialogueID);
+
+	if (!Node || FragmentIndex >= Node->NumFragments)
+	{
+		return {};
+	}
+
+	return { &Fragments[Node->FirstFragment + FragmentIndex], this };
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapDialogueDatabase::FFragmentView FYapDialogueDatabase::FindFragmentByAudioID(FName AudioID) const
+{
+	if (AudioID.IsNone())
+	{
+		return {};
+	}
+
+	const uint32 Hash = HashName(AudioID);
+
+	for (int32 i = Algo::LowerBoundBy(AudioIDs, Hash, &FAudioID::AudioIDHash); i < AudioIDs.Num() && AudioIDs[i].AudioIDHash == Hash; ++i)
+	{
+		const FFragment& Fragment = Fragments[AudioIDs[i].Fragment];
+
+		if (GetName(Fragment.AudioID) == AudioID)
+		{
+			return { &Fragment, this };
+		}
+	}
+
+	return {};
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FUtf8StringView FYapDialogueDatabase::GetString(uint32 Offset) const
+{
+	if (Offset >= Header->StringsSize)
+	{
+		return {};
+	}
+
+	const UTF8CHAR* String = reinterpret_cast<const UTF8CHAR*>(Data + Header->StringsOffset + Offset);
+
+	return FUtf8StringView(String, TCString<UTF8CHAR>::Strnlen(String, Header->StringsSize - Offset));
+}
+
+FName FYapDialogueDatabase::GetName(uint32 Offset) const
+{
+	const FUtf8StringView String = GetString(Offset);
+
+	return String.IsEmpty() ? NAME_None : FName(*FString(String.Len(), String.GetData()));
+}
+
+FGameplayTag FYapDialogueDatabase::GetTag(uint32 Offset) const
+{
+	const FName TagName = GetName(Offset);
+
+	return TagName.IsNone() ? FGameplayTag::EmptyTag : FGameplayTag::RequestGameplayTag(TagName, false);
+}
+
+FText FYapDialogueDatabase::GetText(const FTextRef& Text) const
+{
+	const FUtf8StringView Source = GetString(Text.Source);
+
+	if (Source.IsEmpty())
+	{
+		return FText::GetEmpty();
+	}
+
+	const FString SourceString(Source.Len(), Source.GetData());
+
+	const FUtf8StringView Key = GetString(Text.Key);
+
+	// Texts without a key weren't localizable in the first place
+	if (Key.IsEmpty())
+	{
+		return FText::AsCultureInvariant(SourceString);
+	}
+
+	const FUtf8StringView Namespace = GetString(Text.Namespace);
+	const FString NamespaceString(Namespace.Len(), Namespace.GetData());
+	const FString KeyString(Key.Len(), Key.GetData());
+
+	FText Found = FText::FindTextInLiveTable_Advanced(NamespaceString, KeyString, *SourceString);
+
+	if (!Found.IsEmpty())
+	{
+		return Found;
+	}
+
+	// Not in the live table yet (e.g. its localization resource isn't loaded); stays bound to its key, so it picks up the translation once it is
+	return FText::AsLocalizable_Advanced(*NamespaceString, *KeyString, SourceString);
+}
+
+// ================================================================================================
+
+#if WITH_EDITOR
+void FYapDialogueDatabase::Build(const UFlowAsset* FlowAsset, TArray<uint8>& OutData)
+{
+	TArray<const UFlowNode_YapDialogue*> DialogueNodes;
+
+	for (const auto& [Guid, Node] : FlowAsset->GetNodes())
+	{
+		if (const UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(Node))
+		{
+			DialogueNodes.Add(DialogueNode);
+		}
+	}
+
+	// Sorted so that lookups can binary search by hash. Within a hash by DialogueID and then GUID, so that the output doesn't depend on the order
+	// nodes were baked in, and the lowest GUID comes first (and wins lookups) when two nodes share a DialogueID.
+	Algo::Sort(DialogueNodes, [] (const UFlowNode_YapDialogue* A, const UFlowNode_YapDialogue* B)
+	{
+		const uint32 HashA = HashName(A->GetDialogueID());
+		const uint32 HashB = HashName(B->GetDialogueID());
+
+		if (HashA != HashB)
+		{
+			return HashA < HashB;
+		}
+
+		if (A->GetDialogueID() != B->GetDialogueID())
+		{
+			return A->GetDialogueID().LexicalLess(B->GetDialogueID());
+		}
+
+		return A->GetGuid() < B->GetGuid();
+	});
+
+	TArray<uint8> Strings;
+	TMap<FString, uint32> StringOffsets;
+
+	Strings.Add(0);
+
+	auto AddString = [&Strings, &StringOffsets] (const FString& String) -> uint32
+	{
+		if (String.IsEmpty())
+		{
+			return 0;
+		}
+
+		if (const uint32* Existing = StringOffsets.Find(String))
+		{
+			return *Existing;
+		}
+
+		const FTCHARToUTF8 Converted(*String);
+		const uint32 Offset = Strings.Num();
+
+		Strings.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+		Strings.Add(0);
+
+		StringOffsets.Add(String, Offset);
+
+		return Offset;
+	};
+
+	auto AddText = [&AddString] (const FText& Text) -> FTextRef
+	{
+		FTextRef Ref;
+		Ref.Namespace = AddString(FTextInspector::GetNamespace(Text).Get(FString()));
+		Ref.Key = AddString(FTextInspector::GetKey(Text).Get(FString()));
+
+		const FString* Source = FTextInspector::GetSourceString(Text);
+		Ref.Source = AddString(Source ? *Source : Text.ToString());
+
+		return Ref;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FFragment> Fragments;
+	TArray<FAudioID> AudioIDs;
+
+	Nodes.Reserve(DialogueNodes.Num());
+
+	for (const UFlowNode_YapDialogue* DialogueNode : DialogueNodes)
+	{
+		const TArray<FYapFragment>& NodeFragments = DialogueNode->GetFragments();
+		const TArray<FYapFragmentTimes>& BakedTimes = DialogueNode->GetBakedFragmentTimes();
+		const bool bHasBakedTimes = BakedTimes.Num() == NodeFragments.Num() * 2;
+
+		FNode& Node = Nodes.AddDefaulted_GetRef();
+		Node.DialogueIDHash = HashName(DialogueNode->GetDialogueID());
+		Node.DialogueID = AddString(DialogueNode->GetDialogueID().IsNone() ? FString() : DialogueNode->GetDialogueID().ToString());
+		Node.FirstFragment = Fragments.Num();
+		Node.NumFragments = NodeFragments.Num();
+
+		for (int32 i = 0; i < NodeFragments.Num(); ++i)
+		{
+			const FYapFragment& Fragment = NodeFragments[i];
+
+			FFragment& Record = Fragments.AddZeroed_GetRef();
+			Record.AudioID = AddString(Fragment.GetAudioID().IsNone() ? FString() : Fragment.GetAudioID().ToString());
+			Record.SpeakerTag = AddString(Fragment.GetSpeakerTag().ToString());
+			Record.DirectedAtTag = AddString(Fragment.GetDirectedAtTag().ToString());
+			Record.MoodTag = AddString(Fragment.GetMoodTag().ToString());
+			Record.Node = Nodes.Num() - 1;
+
+			int32 BitIndex = 0;
+
+			for (EYapMaturitySetting MaturitySetting : { EYapMaturitySetting::Mature, EYapMaturitySetting::ChildSafe })
+			{
+				const FYapBit& Bit = Fragment.GetBit(nullptr, MaturitySetting);
+
+				FBit& BitRecord = Record.Bits[BitIndex];
+				BitRecord.DialogueText = AddText(Bit.GetDialogueText());
+				BitRecord.TitleText = AddText(Bit.GetTitleText());
+				BitRecord.Times = bHasBakedTimes ? BakedTimes[i * 2 + BitIndex] : Fragment.EvaluateTimes(nullptr, MaturitySetting, EYapLoadContext::DoNotLoad, DialogueNode->GetNodeConfig());
+
+				++BitIndex;
+			}
+
+			if (!Fragment.GetAudioID().IsNone())
+			{
+				AudioIDs.Add({ HashName(Fragment.GetAudioID()), static_cast<uint32>(Fragments.Num() - 1) });
+			}
+		}
+	}
+
+	// By fragment within a hash, so that fragments sharing an AudioID resolve to the first (lowest GUID) node's fragment on every bake
+	Algo::Sort(AudioIDs, [] (const FAudioID& A, const FAudioID& B)
+	{
+		return A.AudioIDHash != B.AudioIDHash ? A.AudioIDHash < B.AudioIDHash : A.Fragment < B.Fragment;
+	});
+
+	// Keep every section 4-byte aligned
+	while (Strings.Num() % 4 != 0)
+	{
+		Strings.Add(0);
+	}
+
+	FHeader Header;
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.NumNodes = Nodes.Num();
+	Header.NumFragments = Fragments.Num();
+	Header.NumAudioIDs = AudioIDs.Num();
+	Header.NodesOffset = sizeof(FHeader);
+	Header.FragmentsOffset = Header.NodesOffset + Nodes.Num() * sizeof(FNode);
+	Header.AudioIDsOffset = Header.FragmentsOffset + Fragments.Num() * sizeof(FFragment);
+	Header.StringsOffset = Header.AudioIDsOffset + AudioIDs.Num() * sizeof(FAudioID);
+	Header.StringsSize = Strings.Num();
+
+	OutData.Reset(Header.StringsOffset + Header.StringsSize);
+	OutData.Append(reinterpret_cast<const uint8*>(&Header), sizeof(FHeader));
+	OutData.Append(reinterpret_cast<const uint8*>(Nodes.GetData()), Nodes.Num() * sizeof(FNode));
+	OutData.Append(reinterpret_cast<const uint8*>(Fragments.GetData()), Fragments.Num() * sizeof(FFragment));
+	OutData.Append(reinterpret_cast<const uint8*>(AudioIDs.GetData()), AudioIDs.Num() * sizeof(FAudioID));
+	OutData.Append(Strings);
+}
+#endif
+
+#undef LOCTEXT_NAMESPACE
@@ -5,6 +5,7 @@
 
 #include "Yap/YapCharacterAsset.h"
 #include "Yap/YapCondition.h"
+#include "Yap/YapStats.h"
 #include "Yap/YapStreamableManager.h"
 #include "Yap/YapSubsystem.h"
 #include "Yap/Enums/YapLoadContext.h"
@@ -34,21 +35,7 @@ bool FYapFragment::CanRun() const
 
 bool FYapFragment::CheckConditions() const
 {
-	for (TObjectPtr<UYapCondition> Condition : Conditions)
-	{
-		if (!IsValid(Condition))
-		{
-			UE_LOG(LogYap, Warning, TEXT("Ignoring null condition. Clean this up!")); // TODO more info
-			continue;
-		}
-
-		if (!Condition->EvaluateCondition_Internal())
-		{
-			return false;
-		}
-	}
-	
-	return true;
+	return ConditionProgram.Evaluate(Conditions, nullptr);
 }
 
 void FYapFragment::ResetOptionalPins()
@@ -57,7 +44,7 @@ void FYapFragment::ResetOptionalPins()
 	bShowOnEndPin = false;
 }
 
-void FYapFragment::PreloadContent(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext)
+void FYapFragment::PreloadContent(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext, TAsyncLoadPriority Priority)
 {
 	ResolveMaturitySetting(World, MaturitySetting);
 
@@ -65,8 +52,8 @@ void FYapFragment::PreloadContent(UWorld* World, EYapMaturitySetting MaturitySet
 #if WITH_EDITOR
 	if (World && GEditor && GEditor->IsPlaySessionInProgress())
 	{
-		SpeakerHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(Speaker.GetTagName());
-		DirectedAtHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(DirectedAt.GetTagName());
+		SpeakerHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(Speaker.GetTagName(), Priority);
+		DirectedAtHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(DirectedAt.GetTagName(), Priority);
 	}
 	else if (GEditor)
 	{
@@ -74,17 +61,34 @@ void FYapFragment::PreloadContent(UWorld* World, EYapMaturitySetting MaturitySet
 		UYapProjectSettings::FindCharacter(DirectedAt, DirectedAtHandle, EYapLoadContext::AsyncEditorOnly);
 	}
 #else
-	SpeakerHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(Speaker.GetTagName());
-	DirectedAtHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(DirectedAt.GetTagName());
+	SpeakerHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(Speaker.GetTagName(), Priority);
+	DirectedAtHandle = UYapSubsystem::GetCharacterManager(World).RequestLoadAsync(DirectedAt.GetTagName(), Priority);
 #endif
 	
 	if (MaturitySetting == EYapMaturitySetting::ChildSafe && bEnableChildSafe)
 	{
-		ChildSafeBit.LoadContent(LoadContext);
+		ChildSafeBit.LoadContent(FragmentID, LoadContext, Priority);
 	}
 	else
 	{
-		MatureBit.LoadContent(LoadContext);
+		MatureBit.LoadContent(FragmentID, LoadContext, Priority);
+	}
+}
+
+void FYapFragment::PrefetchContent(UWorld* World, EYapMaturitySetting MaturitySetting, TAsyncLoadPriority Priority, TArray<TSharedPtr<FStreamableHandle>>& OutHandles) const
+{
+	ResolveMaturitySetting(World, MaturitySetting);
+
+	UYapCharacterManager& CharacterManager = UYapSubsystem::GetCharacterManager(World);
+
+	const FYapBit& Bit = (MaturitySetting == EYapMaturitySetting::ChildSafe && bEnableChildSafe) ? ChildSafeBit : MatureBit;
+	
+	for (TSharedPtr<FStreamableHandle> Handle : { CharacterManager.RequestLoadAsync(Speaker.GetTagName(), Priority), CharacterManager.RequestLoadAsync(DirectedAt.GetTagName(), Priority), Bit.PrefetchContent(Priority) })
+	{
+		if (Handle.IsValid())
+		{
+			OutHandles.Add(MoveTemp(Handle));
+		}
 	}
 }
 
@@ -138,13 +142,13 @@ const TScriptInterface<IYapCharacterInterface> FYapFragment::GetCharacter_Intern
 		return nullptr;
 	}
 
-	return UYapSubsystem::GetCharacterManager(World).FindCharacter(CharacterTag.GetTagName()).GetObject();
+	return UYapSubsystem::GetCharacterManager(World).FindCharacter(CharacterTag.GetTagName(), LoadContext).GetObject();
 }
 
 const FText& FYapFragment::GetDialogueText(UWorld* World, EYapMaturitySetting MaturitySetting) const
 {
 	const FYapBit& Preferredbit = GetBit(World, MaturitySetting);
-	const FYapBit& SecondaryBit = MatureBit; // Always fall back to the mature bit. Never fall back to the child-safe bit.
+	const FYapBit& SecondaryBit = GetBit(World, EYapMaturitySetting::Mature); // Always fall back to the mature bit. Never fall back to the child-safe bit.
 
 	if (Preferredbit.HasDialogueText())
 	{
@@ -157,7 +161,7 @@ const FText& FYapFragment::GetDialogueText(UWorld* World, EYapMaturitySetting Ma
 const FText& FYapFragment::GetTitleText(UWorld* World, EYapMaturitySetting MaturitySetting) const
 {
 	const FYapBit& Preferredbit = GetBit(World, MaturitySetting);
-	const FYapBit& SecondaryBit = MatureBit; // Always fall back to the mature bit. Never fall back to the child-safe bit.
+	const FYapBit& SecondaryBit = GetBit(World, EYapMaturitySetting::Mature); // Always fall back to the mature bit. Never fall back to the child-safe bit.
 
 	if (Preferredbit.HasTitleText())
 	{
@@ -170,7 +174,7 @@ const FText& FYapFragment::GetTitleText(UWorld* World, EYapMaturitySetting Matur
 const UObject* FYapFragment::GetAudioAsset(UWorld* World, EYapMaturitySetting MaturitySetting) const
 {
 	const FYapBit& Preferredbit = GetBit(World, MaturitySetting);
-	const FYapBit& SecondaryBit = MatureBit; // Always fall back to the mature bit. Never fall back to the child-safe bit.
+	const FYapBit& SecondaryBit = GetBit(World, EYapMaturitySetting::Mature); // Always fall back to the mature bit. Never fall back to the child-safe bit.
 
 	if (Preferredbit.HasAudioAsset())
 	{
@@ -189,12 +193,20 @@ const FYapBit& FYapFragment::GetBit(UWorld* World, EYapMaturitySetting MaturityS
 {
 	ResolveMaturitySetting(World, MaturitySetting);
 
-	if (MaturitySetting == EYapMaturitySetting::ChildSafe)
+	const FYapBit& BaseBit = MaturitySetting == EYapMaturitySetting::ChildSafe ? ChildSafeBit : MatureBit;
+
+	if (!FragmentID.IsNone())
 	{
-		return ChildSafeBit;
+		if (const UYapSubsystem* Subsystem = UYapSubsystem::Get(World))
+		{
+			if (const FYapBit* ReplacementBit = Subsystem->GetBitReplacements().FindReplacementBit(FragmentID, MaturitySetting, BaseBit))
+			{
+				return *ReplacementBit;
+			}
+		}
 	}
 	
-	return MatureBit;
+	return BaseBit;
 }
 
 TOptional<float> FYapFragment::GetSpeechTime(UWorld* World, const UYapNodeConfig& NodeConfig) const
@@ -202,23 +214,10 @@ TOptional<float> FYapFragment::GetSpeechTime(UWorld* World, const UYapNodeConfig
 	return GetSpeechTime(World, UYapSubsystem::GetCurrentMaturitySetting(World), EYapLoadContext::Sync, NodeConfig);
 }
 
-bool FYapFragment::IsAwaitingManualAdvance() const
-{
-	return bFragmentAwaitingManualAdvance;
-}
-
-void FYapFragment::SetAwaitingManualAdvance()
-{
-	bFragmentAwaitingManualAdvance = true;
-}
-
-void FYapFragment::ClearAwaitingManualAdvance()
-{
-	bFragmentAwaitingManualAdvance = false;
-}
-
 TOptional<float> FYapFragment::GetSpeechTime(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext, const UYapNodeConfig& NodeConfig) const
 {
+	YAP_SCOPE(STAT_YapGetSpeechTime, "Yap GetSpeechTime", FragmentID, GetSpeakerTag());
+	
 	EYapTimeMode EffectiveTimeMode = GetTimeMode(World, MaturitySetting, NodeConfig);
 
 	if (EffectiveTimeMode == EYapTimeMode::None)
@@ -226,7 +225,7 @@ TOptional<float> FYapFragment::GetSpeechTime(UWorld* World, EYapMaturitySetting
 		return NullOpt;
 	}
 	
-	return GetBit(World, MaturitySetting).GetSpeechTime(World, EffectiveTimeMode, LoadContext, NodeConfig);
+	return GetBit(World, MaturitySetting).GetSpeechTime(World, EffectiveTimeMode, LoadContext, NodeConfig, FragmentID);
 }
 
 float FYapFragment::GetPaddingValue(UWorld* World, const UYapNodeConfig& NodeConfig) const
@@ -238,11 +237,7 @@ float FYapFragment::GetPaddingValue(UWorld* World, const UYapNodeConfig& NodeCon
 	
 	if (Padding.IsSet())
 	{
-		float RawPadding = Padding.GetValue();
-		
-		TOptional<float> SpeechTime = GetSpeechTime(World, NodeConfig);
-
-		return FMath::Max(-SpeechTime.Get(0.0f), RawPadding);
+		return EvaluateTimes(World, EYapMaturitySetting::Unspecified, EYapLoadContext::Sync, NodeConfig).Padding;
 	}
 	
 	return NodeConfig.GetDefaultFragmentPaddingTime();
@@ -257,20 +252,34 @@ bool FYapFragment::GetUsesPadding(UWorld* World, const UYapNodeConfig& NodeConfi
 
 float FYapFragment::GetProgressionTime(UWorld* World, const UYapNodeConfig& NodeConfig) const
 {
-	float SpeechTime = GetSpeechTime(World, NodeConfig).Get(0.0f);
+	return EvaluateTimes(World, EYapMaturitySetting::Unspecified, EYapLoadContext::Sync, NodeConfig).ProgressionTime;
+}
+
+FYapFragmentTimes FYapFragment::EvaluateTimes(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext, const UYapNodeConfig& NodeConfig) const
+{
+	FYapFragmentTimes Times;
+
+	ResolveMaturitySetting(World, MaturitySetting);
 	
-	float PaddingTime;
+	TOptional<float> SpeechTime = GetSpeechTime(World, MaturitySetting, LoadContext, NodeConfig);
+
+	Times.SpeechTime = SpeechTime.IsSet() ? FMath::Max(SpeechTime.GetValue(), 0.0f) : -1.0f;
 	
 	if (Padding.IsSet())
 	{
-		PaddingTime = GetPaddingValue(World, NodeConfig);
+		Times.Padding = IsTimeModeNone() ? 0.0f : FMath::Max(-SpeechTime.Get(0.0f), Padding.GetValue());
 	}
 	else
 	{
-		PaddingTime = NodeConfig.GetDefaultFragmentPaddingTime();
+		Times.Padding = IsTimeModeNone() ? 0.0f : NodeConfig.GetDefaultFragmentPaddingTime();
 	}
 
-	return FMath::Max(SpeechTime + PaddingTime, 0.0f);
+	// Unlike Padding, progression falls back to the default padding even for time mode None
+	const float ProgressionPadding = Padding.IsSet() ? Times.Padding : NodeConfig.GetDefaultFragmentPaddingTime();
+	
+	Times.ProgressionTime = FMath::Max(SpeechTime.Get(0.0f) + ProgressionPadding, 0.0f);
+
+	return Times;
 }
 
 void FYapFragment::IncrementActivations()
@@ -278,14 +287,6 @@ void FYapFragment::IncrementActivations()
 	ActivationCount++;
 }
 
-/*
-void FYapFragment::ReplaceBit(EYapMaturitySetting MaturitySetting, const FYapBitReplacement& ReplacementBit)
-{
-	// TODO: I'd rather use some sort of layers system rather than bulldoze the original data.
-	//Bit = ReplacementBit;
-}
-*/
-
 FFlowPin FYapFragment::GetPromptPin() const
 {
 	if (!PromptPin.IsValid())
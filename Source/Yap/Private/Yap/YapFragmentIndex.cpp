@@ -0,0 +1,202 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapFragmentIndex.h"
+
+#include "Yap/YapLog.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+FYapFragment* FYapFragmentLocation::Get() const
+{
+	UFlowNode_YapDialogue* Node = DialogueNode.Get();
+
+	if (!Node || !Node->Fragments.IsValidIndex(FragmentIndex))
+	{
+		return nullptr;
+	}
+
+	return &Node->Fragments[FragmentIndex];
+}
+
+// ================================================================================================
+
+void FYapFragmentIndex::Register(UFlowNode_YapDialogue* DialogueNode)
+{
+	TArray<FName>* RegisteredIDs = nullptr;
+
+	const TArray<FYapFragment>& Fragments = DialogueNode->GetFragments();
+
+	for (int32 i = 0; i < Fragments.Num(); ++i)
+	{
+		if (i > MAX_uint8)
+		{
+			UE_LOG(LogYap, Error, TEXT("Node [%s] has more than %i fragments! Fragments past that can't be found by their ID."), *GetNameSafe(DialogueNode), MAX_uint8 + 1);
+			break;
+		}
+		
+		const FName FragmentID = Fragments[i].GetFragmentID();
+
+		if (FragmentID.IsNone())
+		{
+			continue;
+		}
+
+		TArray<FYapFragmentLocation, TInlineAllocator<1>>& IDLocations = Locations.FindOrAdd(FragmentID);
+
+		if (IDLocations.Num() > 0)
+		{
+			if (IDLocations.ContainsByPredicate([DialogueNode] (const FYapFragmentLocation& Location) { return Location.DialogueNode == DialogueNode; }))
+			{
+				continue;
+			}
+
+			// Another instance of the same Flow asset registers the same node again, which is fine; a different node using the ID is not
+			const UFlowNode_YapDialogue* ExistingNode = IDLocations[0].DialogueNode.Get();
+			
+			if (ExistingNode && ExistingNode->GetGuid() != DialogueNode->GetGuid())
+			{
+				UE_LOG(LogYap, Warning, TEXT("Tried to register fragment ID [%s] of node [%s] but this ID was already registered by [%s]! Find and fix the duplicate ID usage."), *FragmentID.ToString(), *GetNameSafe(DialogueNode), *GetNameSafe(ExistingNode));
+				continue;
+			}
+		}
+		else
+		{
+			AddToParents(FragmentID);
+		}
+
+		FYapFragmentLocation& Location = IDLocations.AddDefaulted_GetRef();
+		Location.DialogueNode = DialogueNode;
+		Location.FragmentIndex = static_cast<uint8>(i);
+
+		if (!RegisteredIDs)
+		{
+			RegisteredIDs = &NodeFragmentIDs.FindOrAdd(DialogueNode);
+		}
+
+		RegisteredIDs->Add(FragmentID);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapFragmentIndex::Unregister(const UFlowNode_YapDialogue* DialogueNode)
+{
+	TArray<FName> RegisteredIDs;
+
+	if (!NodeFragmentIDs.RemoveAndCopyValue(DialogueNode, RegisteredIDs))
+	{
+		return;
+	}
+
+	for (FName FragmentID : RegisteredIDs)
+	{
+		TArray<FYapFragmentLocation, TInlineAllocator<1>>* IDLocations = Locations.Find(FragmentID);
+
+		if (!IDLocations)
+		{
+			continue;
+		}
+
+		// Other instances of the same Flow asset may still be using the ID
+		IDLocations->RemoveAll([DialogueNode] (const FYapFragmentLocation& Location) { return Location.DialogueNode == DialogueNode; });
+
+		if (IDLocations->IsEmpty())
+		{
+			Locations.Remove(FragmentID);
+			RemoveFromParents(FragmentID);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FYapFragmentLocation* FYapFragmentIndex::Find(FName FragmentID) const
+{
+	const TArray<FYapFragmentLocation, TInlineAllocator<1>>* IDLocations = Locations.Find(FragmentID);
+
+	return IDLocations ? &(*IDLocations)[0] : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapFragmentIndex::FindAll(FName FragmentID, bool bIncludeChildren, TArray<FYapFragmentLocation>& OutLocations) const
+{
+	if (const TArray<FYapFragmentLocation, TInlineAllocator<1>>* IDLocations = Locations.Find(FragmentID))
+	{
+		OutLocations.Append(*IDLocations);
+	}
+
+	if (!bIncludeChildren)
+	{
+		return;
+	}
+
+	if (const TArray<FName>* ChildIDs = Children.Find(FragmentID))
+	{
+		OutLocations.Reserve(OutLocations.Num() + ChildIDs->Num());
+
+		for (FName ChildID : *ChildIDs)
+		{
+			OutLocations.Append(Locations.FindChecked(ChildID));
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapFragmentIndex::Reset()
+{
+	Locations.Empty();
+	Children.Empty();
+	NodeFragmentIDs.Empty();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapFragmentIndex::AddToParents(FName FragmentID)
+{
+	ForEachParent(FragmentID, [this, FragmentID] (FName ParentID)
+	{
+		Children.FindOrAdd(ParentID).Add(FragmentID);
+	});
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapFragmentIndex::RemoveFromParents(FName FragmentID)
+{
+	ForEachParent(FragmentID, [this, FragmentID] (FName ParentID)
+	{
+		if (TArray<FName>* ChildIDs = Children.Find(ParentID))
+		{
+			ChildIDs->RemoveSingleSwap(FragmentID, EAllowShrinking::No);
+
+			if (ChildIDs->IsEmpty())
+			{
+				Children.Remove(ParentID);
+			}
+		}
+	});
+}
+
+// ------------------------------------------------------------------------------------------------
+
+template<typename TVisit>
+void FYapFragmentIndex::ForEachParent(FName FragmentID, TVisit&& Visit)
+{
+	const FString IDString = FragmentID.ToString();
+
+	for (int32 i = 0; i < IDString.Len(); ++i)
+	{
+		if (IDString[i] == TEXT('.'))
+		{
+			Visit(FName(FStringView(*IDString, i)));
+		}
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
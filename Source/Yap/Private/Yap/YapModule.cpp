@@ -3,17 +3,39 @@
 
 #include "Yap/YapModule.h"
 
+#include "Yap/YapAudioDurationCache.h"
+
+#if WITH_EDITOR
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+#endif
+
 #define LOCTEXT_NAMESPACE "Yap"
 
 void FYapModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+#if WITH_EDITOR
+	// Cached audio durations are stale once their audio asset is saved again
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddLambda([] (const FString& PackageFilename, UPackage* Package, FObjectPostSaveContext SaveContext)
+	{
+		if (!SaveContext.IsCooking())
+		{
+			FYapAudioDurationCache::Get().Invalidate(Package->GetFName());
+		}
+	});
+#endif
 }
 
 void FYapModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+#if WITH_EDITOR
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+#endif
 }
 
 #undef LOCTEXT_NAMESPACE
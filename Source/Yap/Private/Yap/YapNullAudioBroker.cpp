@@ -0,0 +1,51 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapNullAudioBroker.h"
+
+#include "Sound/SoundBase.h"
+#include "Yap/YapLog.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+UYapNullAudioBroker::UYapNullAudioBroker()
+{
+	// Common names used by audio middleware assets (e.g. Wwise events)
+	DurationPropertyNames = { "Duration", "MaxDuration", "MaximumDuration" };
+}
+
+// ------------------------------------------------------------------------------------------------
+
+float UYapNullAudioBroker::GetAudioAssetDuration(const UObject* AudioAsset) const
+{
+	if (!AudioAsset)
+	{
+		return -1.0f;
+	}
+
+	if (const USoundBase* Sound = Cast<USoundBase>(AudioAsset))
+	{
+		return Sound->GetDuration();
+	}
+
+	for (const FName& PropertyName : DurationPropertyNames)
+	{
+		const FProperty* Property = AudioAsset->GetClass()->FindPropertyByName(PropertyName);
+
+		if (const FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property))
+		{
+			return FloatProperty->GetPropertyValue_InContainer(AudioAsset);
+		}
+
+		if (const FDoubleProperty* DoubleProperty = CastField<FDoubleProperty>(Property))
+		{
+			return DoubleProperty->GetPropertyValue_InContainer(AudioAsset);
+		}
+	}
+
+	UE_LOG(LogYap, Warning, TEXT("Could not read a duration from audio asset <%s> of class <%s>; add its duration property to the null audio broker's DurationPropertyNames."), *AudioAsset->GetPathName(), *AudioAsset->GetClass()->GetName());
+
+	return -1.0f;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -106,6 +106,24 @@ void UYapProjectSettings::AddAdditionalCharacterClass(TSoftClassPtr<UObject> Cla
 }
 #endif
 
+#if WITH_EDITOR
+UYapProjectSettings::FTestOverrides UYapProjectSettings::ApplyTestOverrides(const FTestOverrides& Overrides)
+{
+	UYapProjectSettings& Settings = Get();
+
+	FTestOverrides Replaced;
+	Replaced.BrokerClass = Settings.BrokerClass;
+	Replaced.DefaultNodeConfig = Settings.DefaultNodeConfig;
+	Replaced.FreeSpeechBudget = Settings.FreeSpeechBudget;
+
+	Settings.BrokerClass = Overrides.BrokerClass;
+	Settings.DefaultNodeConfig = Overrides.DefaultNodeConfig;
+	Settings.FreeSpeechBudget = Overrides.FreeSpeechBudget;
+
+	return Replaced;
+}
+#endif
+
 #if WITH_EDITOR
 const UObject* UYapProjectSettings::FindCharacter(FGameplayTag CharacterTag, TSharedPtr<FStreamableHandle>& Handle, EYapLoadContext LoadContext)
 {
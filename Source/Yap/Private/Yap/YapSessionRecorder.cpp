@@ -0,0 +1,355 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapSessionRecorder.h"
+
+#include "Misc/FileHelper.h"
+#include "Yap/YapLog.h"
+#include "Yap/YapSquirrelNoise.h"
+#include "Yap/YapStats.h"
+#include "Yap/YapSubsystem.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+namespace YapSession
+{
+	static constexpr uint32 Magic = 0x53504159; // "YAPS"
+
+	static constexpr uint32 Version = 1;
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 GlobalSeed;
+		int32 StartNoisePosition;
+		uint32 NumRecords;
+		uint32 RecordSize;
+	};
+
+	static const TCHAR* LexToString(EYapSessionEvent Event)
+	{
+		switch (Event)
+		{
+			case EYapSessionEvent::SpeechBegins:			return TEXT("SpeechBegins");
+			case EYapSessionEvent::SpeechResult:			return TEXT("SpeechResult");
+			case EYapSessionEvent::PromptBroadcast:			return TEXT("PromptBroadcast");
+			case EYapSessionEvent::ConversationOpened:		return TEXT("ConversationOpened");
+			case EYapSessionEvent::ConversationClosed:		return TEXT("ConversationClosed");
+			case EYapSessionEvent::SpeechEnded:				return TEXT("SpeechEnded");
+			case EYapSessionEvent::PromptChosen:			return TEXT("PromptChosen");
+			case EYapSessionEvent::ConversationAdvanced:	return TEXT("ConversationAdvanced");
+			default:										return TEXT("Unknown");
+		}
+	}
+}
+
+// ================================================================================================
+
+void FYapSessionRecorder::Start(const UYapSubsystem& Subsystem)
+{
+	Records.Reset();
+	Records.Reserve(1024);
+
+	StartTime = Subsystem.GetWorld()->GetTimeSeconds();
+	GlobalSeed = YapSquirrel::GetGlobalSeed();
+	StartNoisePosition = Subsystem.GetNoiseGenerator().GetPosition();
+	bRecording = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapSessionRecorder::Stop(const FString& Filename)
+{
+	if (!bRecording)
+	{
+		return false;
+	}
+
+	bRecording = false;
+
+	if (Records.Num() == 0)
+	{
+		return false;
+	}
+
+	YapSession::FHeader Header;
+	Header.Magic = YapSession::Magic;
+	Header.Version = YapSession::Version;
+	Header.GlobalSeed = GlobalSeed;
+	Header.StartNoisePosition = StartNoisePosition;
+	Header.NumRecords = Records.Num();
+	Header.RecordSize = sizeof(FYapSessionRecord);
+
+	TArray<uint8> Data;
+	Data.Reserve(sizeof(Header) + Records.Num() * sizeof(FYapSessionRecord));
+	Data.Append(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	Data.Append(reinterpret_cast<const uint8*>(Records.GetData()), Records.Num() * sizeof(FYapSessionRecord));
+
+	Records.Empty();
+
+	SET_MEMORY_STAT(STAT_YapSessionRecordingMemory, 0);
+
+	if (!FFileHelper::SaveArrayToFile(Data, *Filename))
+	{
+		UE_LOG(LogYap, Error, TEXT("Failed to write dialogue session <%s>!"), *Filename);
+		return false;
+	}
+
+	UE_LOG(LogYap, Display, TEXT("Wrote dialogue session <%s> (%i events)."), *Filename, Header.NumRecords);
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FString FYapSessionRecorder::MakeFilename(const UWorld* World)
+{
+	const FString WorldName = World ? World->GetMapName() : FString(TEXT("Unknown"));
+
+	return FPaths::ProjectSavedDir() / TEXT("Yap") / TEXT("Sessions") / FString::Printf(TEXT("%s_%s.yapsession"), *WorldName, *FDateTime::Now().ToString());
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionRecorder::Record_Internal(const UYapSubsystem& Subsystem, EYapSessionEvent Event, const FGuid& Handle, EYapSpeechCompleteResult Result)
+{
+	// Zeroed so that padding bytes are written deterministically
+	FYapSessionRecord& Record = Records.AddZeroed_GetRef();
+	Record.Time = Subsystem.GetWorld()->GetTimeSeconds() - StartTime;
+	Record.Handle = Handle;
+	Record.NoisePosition = Subsystem.GetNoiseGenerator().GetPosition();
+	Record.Event = Event;
+	Record.Result = Result;
+
+	SET_MEMORY_STAT(STAT_YapSessionRecordingMemory, Records.GetAllocatedSize());
+}
+
+// ================================================================================================
+
+FYapSessionReplayer::~FYapSessionReplayer()
+{
+	End();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapSessionReplayer::Load(const FString& Filename)
+{
+	TArray<uint8> Data;
+
+	if (!FFileHelper::LoadFileToArray(Data, *Filename))
+	{
+		UE_LOG(LogYap, Error, TEXT("Could not read dialogue session <%s>!"), *Filename);
+		return false;
+	}
+
+	if (Data.Num() < sizeof(YapSession::FHeader))
+	{
+		UE_LOG(LogYap, Error, TEXT("Dialogue session <%s> is invalid!"), *Filename);
+		return false;
+	}
+
+	YapSession::FHeader Header;
+	FMemory::Memcpy(&Header, Data.GetData(), sizeof(Header));
+
+	if (Header.Magic != YapSession::Magic || Header.Version != YapSession::Version || Header.RecordSize != sizeof(FYapSessionRecord)
+		|| Data.Num() != sizeof(Header) + static_cast<int64>(Header.NumRecords) * sizeof(FYapSessionRecord))
+	{
+		UE_LOG(LogYap, Error, TEXT("Dialogue session <%s> is invalid or from another version of Yap!"), *Filename);
+		return false;
+	}
+
+	GlobalSeed = Header.GlobalSeed;
+	StartNoisePosition = Header.StartNoisePosition;
+
+	Records.SetNumUninitialized(Header.NumRecords);
+	FMemory::Memcpy(Records.GetData(), Data.GetData() + sizeof(Header), Header.NumRecords * sizeof(FYapSessionRecord));
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionReplayer::Begin(UYapSubsystem& Subsystem)
+{
+	if (!PreviousGlobalSeed.IsSet())
+	{
+		PreviousGlobalSeed = YapSquirrel::GetGlobalSeed();
+	}
+
+	YapSquirrel::SetGlobalSeed(GlobalSeed);
+	Subsystem.GetNoiseGenerator().Jump(StartNoisePosition);
+
+	StartTime = Subsystem.GetWorld()->GetTimeSeconds();
+
+	NextInput = 0;
+	NextOutput = 0;
+	bDiverged = false;
+	AdvanceCursor(NextInput, true);
+	AdvanceCursor(NextOutput, false);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionReplayer::End()
+{
+	if (PreviousGlobalSeed.IsSet())
+	{
+		YapSquirrel::SetGlobalSeed(PreviousGlobalSeed.GetValue());
+		PreviousGlobalSeed.Reset();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionReplayer::Tick(UYapSubsystem& Subsystem)
+{
+	const double Now = Subsystem.GetWorld()->GetTimeSeconds() - StartTime;
+
+	while (NextInput < Records.Num() && Records[NextInput].Time <= Now)
+	{
+		// Copied, issuing the input can re-enter OnOutput but never changes the records
+		const FYapSessionRecord Record = Records[NextInput];
+
+		++NextInput;
+		AdvanceCursor(NextInput, true);
+
+		const FGuid* LiveGuid = FindLiveGuid(Record.Handle);
+
+		if (!LiveGuid)
+		{
+			++NumUnresolvedInputs;
+			Diverge(Now, FString::Printf(TEXT("%s for a handle which never appeared"), YapSession::LexToString(Record.Event)));
+			return;
+		}
+
+		switch (Record.Event)
+		{
+			case EYapSessionEvent::SpeechEnded:
+			{
+				if (const FYapSpeechHandle* Handle = LiveSpeechHandles.Find(*LiveGuid))
+				{
+					FYapSpeechHandle HandleCopy = *Handle;
+					Subsystem.EndSpeech(HandleCopy, Record.Result);
+				}
+				break;
+			}
+			case EYapSessionEvent::PromptChosen:
+			{
+				if (const FYapPromptHandle* Handle = LivePromptHandles.Find(*LiveGuid))
+				{
+					UYapSubsystem::RunPrompt(&Subsystem, *Handle);
+				}
+				break;
+			}
+			case EYapSessionEvent::ConversationAdvanced:
+			{
+				if (const FYapConversationHandle* Handle = LiveConversationHandles.Find(*LiveGuid))
+				{
+					UYapSubsystem::AdvanceConversation(&Subsystem, *Handle);
+				}
+				break;
+			}
+			default:
+			{
+				checkNoEntry();
+			}
+		}
+
+		if (bDiverged)
+		{
+			return;
+		}
+	}
+
+	if (NextOutput < Records.Num() && Now - Records[NextOutput].Time > MaxOutputDelay)
+	{
+		++NumMismatched;
+		Diverge(Now, FString::Printf(TEXT("expected %s at %.3fs but it never happened"), YapSession::LexToString(Records[NextOutput].Event), Records[NextOutput].Time));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionReplayer::OnOutput(const UYapSubsystem& Subsystem, EYapSessionEvent Event, const FGuid& Handle, EYapSpeechCompleteResult Result)
+{
+	if (bDiverged)
+	{
+		return;
+	}
+
+	const double Now = Subsystem.GetWorld()->GetTimeSeconds() - StartTime;
+
+	auto Mismatch = [this, Now] (const FString& Description)
+	{
+		++NumMismatched;
+		Diverge(Now, Description);
+	};
+
+	if (NextOutput >= Records.Num())
+	{
+		Mismatch(FString::Printf(TEXT("unexpected %s after the end of the recording"), YapSession::LexToString(Event)));
+		return;
+	}
+
+	const FYapSessionRecord& Expected = Records[NextOutput];
+
+	++NextOutput;
+	AdvanceCursor(NextOutput, false);
+
+	if (Expected.Event != Event || Expected.Result != Result)
+	{
+		Mismatch(FString::Printf(TEXT("expected %s (result %i) but got %s (result %i)"), YapSession::LexToString(Expected.Event), static_cast<int32>(Expected.Result), YapSession::LexToString(Event), static_cast<int32>(Result)));
+		return;
+	}
+
+	RecordedToLive.Add(Expected.Handle, Handle);
+
+	if (Expected.NoisePosition != Subsystem.GetNoiseGenerator().GetPosition())
+	{
+		++NumNoisePositionMismatches;
+	}
+
+	MaxTimeError = FMath::Max(MaxTimeError, FMath::Abs(Now - Expected.Time));
+	++NumMatched;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapSessionReplayer::Report() const
+{
+	const bool bMatched = NumMismatched == 0 && NumUnresolvedInputs == 0 && NumNoisePositionMismatches == 0;
+
+	UE_LOG(LogYap, Display, TEXT("Dialogue session replay: %i outputs matched, %i mismatched, %i inputs could not be resolved, %i noise position mismatches, max time error %.4fs."), NumMatched, NumMismatched, NumUnresolvedInputs, NumNoisePositionMismatches, MaxTimeError);
+
+	if (!FirstMismatch.IsEmpty())
+	{
+		UE_LOG(LogYap, Warning, TEXT("Dialogue session replay diverged %s"), *FirstMismatch);
+	}
+
+	return bMatched;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionReplayer::AdvanceCursor(int32& Cursor, bool bInputs) const
+{
+	while (Cursor < Records.Num() && Records[Cursor].IsInput() != bInputs)
+	{
+		++Cursor;
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapSessionReplayer::Diverge(double Now, const FString& Description)
+{
+	// Everything after the first divergence would only be a consequence of it
+	if (!bDiverged)
+	{
+		bDiverged = true;
+		FirstMismatch = FString::Printf(TEXT("at %.3fs: %s"), Now, *Description);
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
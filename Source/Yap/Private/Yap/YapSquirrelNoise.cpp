@@ -4,6 +4,7 @@
 
 #include "Yap/YapSquirrelNoise.h"
 #include "Yap/SquirrelNoise5.hpp"
+#include "Math/VectorRegister.h"
 
 /*
  *					WARNING:
@@ -29,6 +30,12 @@ namespace YapSquirrel
 		{
 			return ::SquirrelNoise5(Position++, Seed);
 		}
+
+		// Shared by the single and batched functions, so both round the same way
+		constexpr double RealInRange(const double Real, const double Min, const double Max)
+		{
+			return Min + (Max - Min) * Real;
+		}
 	}
 
 	namespace Math
@@ -106,7 +113,7 @@ namespace YapSquirrel
 		// @todo Min and Max must only cover *half* the double range, or it will cause an overflow in (Max - Min)
 		// look into alternate ways to generate random values that don't have this limit
 
-		return Min + (Max - Min) * NextReal(State);
+		return Impl::RealInRange(NextReal(State), Min, Max);
 	}
 
 	constexpr bool RollChance(FYapSquirrelState& State, double& Roll, const double Chance, const double RollModifier)
@@ -136,6 +143,142 @@ namespace YapSquirrel
 		// Otherwise, return the whole number plus the random weighted bool.
 		return Whole + (Remainder >= NextReal(State));
 	}
+
+	namespace Impl
+	{
+		// Four lanes of ::SquirrelNoise5; must stay bit-identical to it
+		FORCEINLINE VectorRegister4Int SquirrelNoise5x4(const VectorRegister4Int& Positions, const VectorRegister4Int& Seed)
+		{
+			VectorRegister4Int MangledBits = VectorIntMultiply(Positions, VectorIntSet1(static_cast<int32>(0xd2a80a3f)));
+			MangledBits = VectorIntAdd(MangledBits, Seed);
+			MangledBits = VectorIntXor(MangledBits, VectorShiftRightImmLogical(MangledBits, 9));
+			MangledBits = VectorIntAdd(MangledBits, VectorIntSet1(static_cast<int32>(0xa884f197)));
+			MangledBits = VectorIntXor(MangledBits, VectorShiftRightImmLogical(MangledBits, 11));
+			MangledBits = VectorIntMultiply(MangledBits, VectorIntSet1(static_cast<int32>(0x6C736F4B)));
+			MangledBits = VectorIntXor(MangledBits, VectorShiftRightImmLogical(MangledBits, 13));
+			MangledBits = VectorIntAdd(MangledBits, VectorIntSet1(static_cast<int32>(0xB79F3ABB)));
+			MangledBits = VectorIntXor(MangledBits, VectorShiftRightImmLogical(MangledBits, 15));
+			MangledBits = VectorIntMultiply(MangledBits, VectorIntSet1(static_cast<int32>(0x1b56c4f5)));
+			MangledBits = VectorIntXor(MangledBits, VectorShiftRightImmLogical(MangledBits, 17));
+			return MangledBits;
+		}
+	}
+
+	void GenerateUint32(const int32 Position, const uint32 Seed, TArrayView<uint32> Out)
+	{
+		const int32 Num = Out.Num();
+		const int32 NumVectorized = Num & ~3;
+
+		// Positions wrap like the scalar Position++ does, so do the lane math unsigned
+		const uint32 Start = static_cast<uint32>(Position);
+
+		const VectorRegister4Int SeedVector = VectorIntSet1(static_cast<int32>(Seed));
+		const VectorRegister4Int Step = VectorIntSet1(4);
+		VectorRegister4Int Positions = MakeVectorRegisterInt(static_cast<int32>(Start), static_cast<int32>(Start + 1), static_cast<int32>(Start + 2), static_cast<int32>(Start + 3));
+
+		for (int32 i = 0; i < NumVectorized; i += 4)
+		{
+			VectorIntStore(Impl::SquirrelNoise5x4(Positions, SeedVector), &Out[i]);
+			Positions = VectorIntAdd(Positions, Step);
+		}
+
+		for (int32 i = NumVectorized; i < Num; ++i)
+		{
+			Out[i] = ::SquirrelNoise5(static_cast<int32>(Start + static_cast<uint32>(i)), Seed);
+		}
+	}
+
+	int32 ReservePositions(FYapSquirrelState& State, const int32 Count)
+	{
+		const int32 First = State.Position;
+		State.Position = static_cast<int32>(static_cast<uint32>(First) + static_cast<uint32>(FMath::Max(Count, 0)));
+		return First;
+	}
+
+	void GenerateReal(const int32 Position, const uint32 Seed, TArrayView<double> Out)
+	{
+		// Hashed into a stack buffer in chunks, so large batches don't need a second allocation
+		constexpr int32 ChunkSize = 256;
+		uint32 Bits[ChunkSize];
+
+		for (int32 Offset = 0; Offset < Out.Num(); Offset += ChunkSize)
+		{
+			const int32 Num = FMath::Min(ChunkSize, Out.Num() - Offset);
+
+			GenerateUint32(static_cast<int32>(static_cast<uint32>(Position) + static_cast<uint32>(Offset)), Seed, TArrayView<uint32>(Bits, Num));
+
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Out[Offset + i] = ONE_OVER_MAX_UINT * static_cast<double>(Bits[i]);
+			}
+		}
+	}
+
+	void NextUint32Batch(FYapSquirrelState& State, TArrayView<uint32> Out)
+	{
+		GenerateUint32(ReservePositions(State, Out.Num()), GWorldSeed, Out);
+	}
+
+	void NextRealBatch(FYapSquirrelState& State, TArrayView<double> Out)
+	{
+		GenerateReal(ReservePositions(State, Out.Num()), GWorldSeed, Out);
+	}
+
+	void NextInt32Batch(FYapSquirrelState& State, const int32 Max, TArrayView<int32> Out)
+	{
+		if (Max <= 0)
+		{
+			// NextInt32 doesn't consume a position in this case either
+			for (int32& Value : Out)
+			{
+				Value = 0;
+			}
+			return;
+		}
+
+		constexpr int32 ChunkSize = 256;
+		double Reals[ChunkSize];
+
+		for (int32 Offset = 0; Offset < Out.Num(); Offset += ChunkSize)
+		{
+			const int32 Num = FMath::Min(ChunkSize, Out.Num() - Offset);
+
+			NextRealBatch(State, TArrayView<double>(Reals, Num));
+
+			for (int32 i = 0; i < Num; ++i)
+			{
+				Out[Offset + i] = FMath::Min(FMath::TruncToInt(Reals[i] * static_cast<double>(Max)), Max - 1);
+			}
+		}
+	}
+
+	int32 RollChanceBatch(FYapSquirrelState& State, TConstArrayView<double> Chances, const double RollModifier, TArrayView<bool> Out)
+	{
+		check(Chances.Num() == Out.Num());
+
+		constexpr int32 ChunkSize = 256;
+		double Reals[ChunkSize];
+
+		int32 NumSucceeded = 0;
+
+		for (int32 Offset = 0; Offset < Out.Num(); Offset += ChunkSize)
+		{
+			const int32 Num = FMath::Min(ChunkSize, Out.Num() - Offset);
+
+			NextRealBatch(State, TArrayView<double>(Reals, Num));
+
+			for (int32 i = 0; i < Num; ++i)
+			{
+				// As in RollChance
+				const double Roll = Impl::RealInRange(Reals[i], 0.0, 100.0 - RollModifier) + RollModifier;
+				
+				Out[Offset + i] = Roll >= Chances[Offset + i];
+				NumSucceeded += Out[Offset + i];
+			}
+		}
+
+		return NumSucceeded;
+	}
 }
 
 #if WITH_EDITOR
@@ -222,6 +365,23 @@ int32 UYapSquirrel::RoundWithWeightByFraction(const double Value)
 	return YapSquirrel::RoundWithWeightByFraction(State, Value);
 }
 
+void UYapSquirrel::NextRealBatch(const int32 Count, TArray<double>& Values)
+{
+	Values.SetNumUninitialized(FMath::Max(Count, 0));
+	YapSquirrel::NextRealBatch(State, Values);
+}
+
+int32 UYapSquirrel::RollChanceBatch(const TArray<double>& Chances, const double RollModifier, TArray<bool>& Results)
+{
+	Results.SetNumUninitialized(Chances.Num());
+	return YapSquirrel::RollChanceBatch(State, Chances, RollModifier, Results);
+}
+
+int32 UYapSquirrel::ReservePositions(const int32 Count)
+{
+	return YapSquirrel::ReservePositions(State, Count);
+}
+
 void UYapSquirrelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
@@ -0,0 +1,29 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapStats.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+DEFINE_STAT(STAT_YapFireTimers);
+DEFINE_STAT(STAT_YapRunSpeech);
+DEFINE_STAT(STAT_YapBroadcastEvent);
+DEFINE_STAT(STAT_YapAdvanceConversation);
+DEFINE_STAT(STAT_YapRunFragment);
+DEFINE_STAT(STAT_YapBroadcastPrompts);
+DEFINE_STAT(STAT_YapGetSpeechTime);
+DEFINE_STAT(STAT_YapLoadContent);
+DEFINE_STAT(STAT_YapFindCharacter);
+
+DEFINE_STAT(STAT_YapScheduledTimers);
+DEFINE_STAT(STAT_YapSyncLoads);
+DEFINE_STAT(STAT_YapCulledFreeSpeech);
+
+DEFINE_STAT(STAT_YapDialogueDatabaseMemory);
+DEFINE_STAT(STAT_YapSessionRecordingMemory);
+
+LLM_DEFINE_TAG(Yap);
+
+UE_TRACE_CHANNEL_DEFINE(YapChannel);
+
+#undef LOCTEXT_NAMESPACE
@@ -5,7 +5,9 @@
 
 #include "Yap/YapSubsystem.h"
 
+#include "Yap/YapBitReplacementRegister.h"
 #include "Yap/YapBroker.h"
+#include "Yap/YapDialogueDatabase.h"
 #include "Yap/YapFragment.h"
 #include "Yap/YapLog.h"
 #include "Yap/Interfaces/IYapConversationHandler.h"
@@ -16,9 +18,12 @@
 #include "Yap/Enums/YapLoadContext.h"
 #include "Yap/Interfaces/IYapFreeSpeechHandler.h"
 #include "Yap/Nodes/FlowNode_YapDialogue.h"
-#include "TimerManager.h"
+#include "Yap/YapTimingWheel.h"
 
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/GameInstance.h"
 #include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
 #include "Yap/YapCharacterManager.h"
 
 #define LOCTEXT_NAMESPACE "Yap"
@@ -31,41 +36,190 @@ bool UYapSubsystem::bGetGameMaturitySettingWarningIssued = false;
 
 //FYapConversation UYapSubsystem::NullConversation;
 
+/** Tags trace scopes with the dialogue node which started a speech. */
+static FName GetSpeechOwnerDialogueID(const UObject* SpeechOwner)
+{
+	const UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(SpeechOwner);
+
+	return DialogueNode ? DialogueNode->GetDialogueID() : NAME_None;
+}
+
 // ------------------------------------------------------------------------------------------------
 
-FYap__ActiveSpeechContainer* FYap__ActiveSpeechMap::AddSpeech(FYapSpeechHandle Handle, FName SpeakerID, UObject* SpeechOwner, UObject* ConversationOwner)
+int32 FYap__ActiveSpeechMap::ResolveSpeechSlot(const FYapSpeechHandle& Handle) const
+{
+	const int32 SlotIndex = Handle.GetSlotIndex();
+	
+	if (SlotIndex != INDEX_NONE)
+	{
+		if (SpeechSlots.IsValidIndex(SlotIndex))
+		{
+			const FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+
+			if (Slot.bOccupied && Slot.Generation == Handle.GetSlotGeneration())
+			{
+				return SlotIndex;
+			}
+		}
+
+		// Stale handle; the speech it was made for has already ended
+		return INDEX_NONE;
+	}
+
+	// Handle was built without going through AddSpeech, fall back to the guid
+	if (const int32* FoundSlot = SpeechSlotsByGuid.Find(Handle.GetGuid()))
+	{
+		return *FoundSlot;
+	}
+	
+	return INDEX_NONE;
+}
+
+FYap__ActiveSpeechContainer* FYap__ActiveSpeechMap::FindContainer(const FYapSpeechHandle& Handle)
+{
+	const int32 SlotIndex = ResolveSpeechSlot(Handle);
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &SpeechSlots[SlotIndex].Container;
+}
+
+void FYap__ActiveSpeechMap::LinkSpeechByOwner(int32 SlotIndex)
+{
+	FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+	
+	int32& Head = SpeechHeadsByOwner.FindOrAdd(Slot.Container.SpeechOwner, INDEX_NONE);
+
+	Slot.PrevByOwner = INDEX_NONE;
+	Slot.NextByOwner = Head;
+
+	if (Head != INDEX_NONE)
+	{
+		SpeechSlots[Head].PrevByOwner = SlotIndex;
+	}
+
+	Head = SlotIndex;
+}
+
+void FYap__ActiveSpeechMap::UnlinkSpeechByOwner(int32 SlotIndex)
+{
+	FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+
+	if (Slot.PrevByOwner != INDEX_NONE)
+	{
+		SpeechSlots[Slot.PrevByOwner].NextByOwner = Slot.NextByOwner;
+	}
+	else if (Slot.NextByOwner != INDEX_NONE)
+	{
+		SpeechHeadsByOwner[Slot.Container.SpeechOwner] = Slot.NextByOwner;
+	}
+	else
+	{
+		SpeechHeadsByOwner.Remove(Slot.Container.SpeechOwner);
+	}
+	
+	if (Slot.NextByOwner != INDEX_NONE)
+	{
+		SpeechSlots[Slot.NextByOwner].PrevByOwner = Slot.PrevByOwner;
+	}
+
+	Slot.PrevByOwner = INDEX_NONE;
+	Slot.NextByOwner = INDEX_NONE;
+}
+
+void FYap__ActiveSpeechMap::LinkSpeechBySpeaker(int32 SlotIndex)
+{
+	FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+	
+	int32& Head = SpeechHeadsBySpeakerID.FindOrAdd(Slot.Container.SpeakerID, INDEX_NONE);
+
+	Slot.PrevBySpeaker = INDEX_NONE;
+	Slot.NextBySpeaker = Head;
+
+	if (Head != INDEX_NONE)
+	{
+		SpeechSlots[Head].PrevBySpeaker = SlotIndex;
+	}
+
+	Head = SlotIndex;
+}
+
+void FYap__ActiveSpeechMap::UnlinkSpeechBySpeaker(int32 SlotIndex)
 {
-	if (AllSpeech.Contains(Handle))
+	FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+
+	if (Slot.PrevBySpeaker != INDEX_NONE)
+	{
+		SpeechSlots[Slot.PrevBySpeaker].NextBySpeaker = Slot.NextBySpeaker;
+	}
+	else if (Slot.NextBySpeaker != INDEX_NONE)
+	{
+		SpeechHeadsBySpeakerID[Slot.Container.SpeakerID] = Slot.NextBySpeaker;
+	}
+	else
+	{
+		SpeechHeadsBySpeakerID.Remove(Slot.Container.SpeakerID);
+	}
+	
+	if (Slot.NextBySpeaker != INDEX_NONE)
+	{
+		SpeechSlots[Slot.NextBySpeaker].PrevBySpeaker = Slot.PrevBySpeaker;
+	}
+
+	Slot.PrevBySpeaker = INDEX_NONE;
+	Slot.NextBySpeaker = INDEX_NONE;
+}
+
+FYap__ActiveSpeechContainer* FYap__ActiveSpeechMap::AddSpeech(FYapSpeechHandle& Handle, FName SpeakerID, UObject* SpeechOwner, UObject* ConversationOwner)
+{
+	if (SpeechSlotsByGuid.Contains(Handle.GetGuid()))
 	{
 		UE_LOG(LogYap, Warning, TEXT("Tried to add speech handle more than once, ignoring! <%s>"), *Handle.ToString());
 		return nullptr;
 	}
+
+	int32 SlotIndex;
+
+	if (FreeSpeechSlots.Num() > 0)
+	{
+		SlotIndex = FreeSpeechSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = SpeechSlots.AddDefaulted();
+	}
+
+	FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+	Slot.bOccupied = true;
+	
+	Handle.SlotIndex = SlotIndex;
+	Handle.SlotGeneration = Slot.Generation;
+	Slot.Handle = Handle;
+
+	SpeechSlotsByGuid.Add(Handle.GetGuid(), SlotIndex);
 	
-	FYap__ActiveSpeechContainer& NewSpeechContainer = AllSpeech.Add(Handle);
+	FYap__ActiveSpeechContainer& NewSpeechContainer = Slot.Container;
 
 	if (SpeakerID != NAME_None)
 	{
-		FYapSpeechHandlesArray& HandlesContainer = ContainersBySpeakerID.FindOrAdd(SpeakerID);
-		HandlesContainer.Handles.Add(Handle);
 		NewSpeechContainer.SpeakerID = SpeakerID;
+		LinkSpeechBySpeaker(SlotIndex);
 	}
 
 	if (IsValid(SpeechOwner))
 	{
-		FYapSpeechHandlesArray& HandlesContainer = ContainersByOwner.FindOrAdd(SpeechOwner);
-		HandlesContainer.Handles.Add(Handle);
 		NewSpeechContainer.SpeechOwner = SpeechOwner;
+		LinkSpeechByOwner(SlotIndex);
 	}
 
 	if (ConversationOwner)
 	{
-		if (FYapConversationHandle* ConversationHandle = ConversationsByOwner.Find(ConversationOwner))
+		if (FYapConversation* Conversation = FindConversationByOwner(ConversationOwner))
 		{
-			NewSpeechContainer.ConversationHandle = *ConversationHandle;
-
-			FYapConversation* Conversation = Conversations.Find(*ConversationHandle);
-
-			check(Conversation);
+			NewSpeechContainer.ConversationHandle = Conversation->GetHandle();
 			
 			Conversation->AddRunningFragment(Handle);
 		}
@@ -78,18 +232,75 @@ FYap__ActiveSpeechContainer* FYap__ActiveSpeechMap::AddSpeech(FYapSpeechHandle H
 	return &NewSpeechContainer;
 }
 
+// ------------------------------------------------------------------------------------------------
+
+int32 FYap__ActiveSpeechMap::ResolveConversationSlot(const FYapConversationHandle& ConversationHandle) const
+{
+	const int32 SlotIndex = ConversationHandle.GetSlotIndex();
+	
+	if (SlotIndex != INDEX_NONE)
+	{
+		if (ConversationSlots.IsValidIndex(SlotIndex))
+		{
+			const FYap__ConversationSlot& Slot = ConversationSlots[SlotIndex];
+
+			if (Slot.bOccupied && Slot.Generation == ConversationHandle.GetSlotGeneration())
+			{
+				return SlotIndex;
+			}
+		}
+	}
+
+	// Conversation handles are derived from owner + name, so a handle from an earlier run of the same conversation is still meaningful; find it by guid
+	if (!ConversationHandle.IsValid())
+	{
+		return INDEX_NONE;
+	}
+	
+	for (int32 i = 0; i < ConversationSlots.Num(); ++i)
+	{
+		if (ConversationSlots[i].bOccupied && ConversationSlots[i].Conversation.GetHandle() == ConversationHandle)
+		{
+			return i;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
 FYapConversation& FYap__ActiveSpeechMap::AddConversation(FName ConversationName, UObject* ConversationOwner, FYapConversationHandle& ConversationHandle)
 {
 	ConversationHandle = FYapConversationHandle(ConversationOwner, ConversationName);
 
-	if (FYapConversation* ExistingConversation = Conversations.Find(ConversationHandle))
+	const int32 ExistingSlot = ResolveConversationSlot(ConversationHandle);
+	
+	if (ExistingSlot != INDEX_NONE)
 	{
-		return *ExistingConversation;
+		FYapConversation& ExistingConversation = ConversationSlots[ExistingSlot].Conversation;
+		ConversationHandle = ExistingConversation.GetHandle();
+		return ExistingConversation;
 	}
 
-	ConversationsByOwner.Add(ConversationOwner, ConversationHandle);
+	int32 SlotIndex;
+
+	if (FreeConversationSlots.Num() > 0)
+	{
+		SlotIndex = FreeConversationSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = ConversationSlots.AddDefaulted();
+	}
+
+	FYap__ConversationSlot& Slot = ConversationSlots[SlotIndex];
+	Slot.bOccupied = true;
+
+	ConversationHandle.SlotIndex = SlotIndex;
+	ConversationHandle.SlotGeneration = Slot.Generation;
+	
+	ConversationSlotsByOwner.Add(ConversationOwner, SlotIndex);
 	
-	FYapConversation& Conversation = Conversations.Add(ConversationHandle);
+	FYapConversation& Conversation = Slot.Conversation;
 	Conversation.SetConversationHandle(ConversationHandle);
 	Conversation.SetConversationName(UYapSubsystem::Yap_UnnamedConvo);
 
@@ -98,204 +309,737 @@ FYapConversation& FYap__ActiveSpeechMap::AddConversation(FName ConversationName,
 
 void FYap__ActiveSpeechMap::RemoveConversation(FYapConversationHandle ConversationHandle)
 {
-	int32 Removed = Conversations.Remove(ConversationHandle);
+	const int32 SlotIndex = ResolveConversationSlot(ConversationHandle);
 	
-	if (Removed == 0)
+	if (SlotIndex == INDEX_NONE)
 	{
 		UE_LOG(LogYap, Warning, TEXT("Tried to remove conversation <%s> but converation was not found!"), *ConversationHandle.ToString());
+		return;
 	}
 
-	for (auto It = ConversationsByOwner.CreateIterator(); It; ++It)
+	for (auto It = ConversationSlotsByOwner.CreateIterator(); It; ++It)
 	{
-		if (It.Value() == ConversationHandle)
+		if (It.Value() == SlotIndex)
 		{
 			It.RemoveCurrent();
 		}
 	}
+
+	FYap__ConversationSlot& Slot = ConversationSlots[SlotIndex];
+	Slot.Conversation = FYapConversation();
+	Slot.bOccupied = false;
+	++Slot.Generation;
+
+	FreeConversationSlots.Push(SlotIndex);
+}
+
+FYapConversation* FYap__ActiveSpeechMap::FindConversationByOwner(const UObject* Owner)
+{
+	if (int32* SlotIndex = ConversationSlotsByOwner.Find(Owner))
+	{
+		return &ConversationSlots[*SlotIndex].Conversation;
+	}
+
+	return nullptr;
+}
+
+FYapConversationHandle* FYap__ActiveSpeechMap::FindConversationHandleByOwner(const UObject* Owner)
+{
+	if (FYapConversation* Conversation = FindConversationByOwner(Owner))
+	{
+		return &Conversation->GetHandle();
+	}
+
+	return nullptr;
+}
+
+FYapConversation* FYap__ActiveSpeechMap::FindConversation(const FYapConversationHandle& ConversationHandle)
+{
+	const int32 SlotIndex = ResolveConversationSlot(ConversationHandle);
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &ConversationSlots[SlotIndex].Conversation;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FName FYap__ActiveSpeechMap::FindSpeakerID(const FYapSpeechHandle& Handle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		return Container->SpeakerID;
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to find speaker ID for handle but handle was not found! <%s>"), *Handle.ToString());
+		return NAME_None;
+	}
+}
+
+FYapTimerHandle FYap__ActiveSpeechMap::FindTimerHandle(const FYapSpeechHandle& Handle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		return Container->SpeechTimerHandle;
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to find timer handle for handle but handle was not found! <%s>"), *Handle.ToString());
+		return {};
+	}
+}
+
+FYapSpeechEvent FYap__ActiveSpeechMap::FindSpeechFinishedEvent(const FYapSpeechHandle& Handle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		return Container->OnSpeechFinish;
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to find speech finish event for handle but handle was not found! <%s>"), *Handle.ToString());
+		return {};
+	}
+}
+
+const FYapSpeechEvent* FYap__ActiveSpeechMap::FindSpeechFinishedEventView(const FYapSpeechHandle& Handle) const
+{
+	const int32 SlotIndex = ResolveSpeechSlot(Handle);
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return &SpeechSlots[SlotIndex].Container.OnSpeechFinish;
+}
+
+FYapSpeechEvent FYap__ActiveSpeechMap::TakeSpeechFinishedEvent(const FYapSpeechHandle& Handle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		return MoveTemp(Container->OnSpeechFinish);
+	}
+
+	UE_LOG(LogYap, Warning, TEXT("Tried to take speech finish event for handle but handle was not found! <%s>"), *Handle.ToString());
+	
+	return {};
+}
+
+FYapConversationHandle FYap__ActiveSpeechMap::FindSpeechConversationHandle(const FYapSpeechHandle& Handle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		return Container->ConversationHandle;
+	}
+
+	UE_LOG(LogYap, Warning, TEXT("Tried to find conversation for handle but handle was not found! <%s>"), *Handle.ToString());
+
+	return {};
+}
+
+UObject* FYap__ActiveSpeechMap::FindSpeechOwner(const FYapSpeechHandle& Handle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	return Container ? Container->SpeechOwner.Get() : nullptr;
+}
+
+bool FYap__ActiveSpeechMap::IsSpeechRunning(const FYapSpeechHandle& Handle)
+{
+	return ResolveSpeechSlot(Handle) != INDEX_NONE;
+}
+
+void FYap__ActiveSpeechMap::RemoveSpeech(const FYapSpeechHandle& Handle)
+{
+	const int32 SlotIndex = ResolveSpeechSlot(Handle);
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FYap__ActiveSpeechSlot& Slot = SpeechSlots[SlotIndex];
+
+	if (Slot.Container.SpeechOwner)
+	{
+		UnlinkSpeechByOwner(SlotIndex);
+	}
+
+	if (Slot.Container.SpeakerID != NAME_None)
+	{
+		UnlinkSpeechBySpeaker(SlotIndex);
+	}
+
+	SpeechSlotsByGuid.Remove(Slot.Handle.GetGuid());
+	
+	if (Slot.Container.ConversationHandle.IsValid())
+	{
+		if (FYapConversation* Conversation = FindConversation(Slot.Container.ConversationHandle))
+		{
+			Conversation->RemoveRunningSpeech(Slot.Handle);
+		}
+	}
+
+	// Release the slot; bumping the generation makes any outstanding copies of the handle stale
+	Slot.Handle = FYapSpeechHandle();
+	Slot.Container = FYap__ActiveSpeechContainer();
+	Slot.bOccupied = false;
+	++Slot.Generation;
+
+	FreeSpeechSlots.Push(SlotIndex);
+}
+
+void FYap__ActiveSpeechMap::BindToSpeechFinish(const FYapSpeechHandle& Handle, FYapSpeechEventDelegate Delegate)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		Container->OnSpeechFinish.Add(Delegate);
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to bind to speech finish but handle was not found! <%s>"), *Handle.ToString());
+	}
+}
+
+void FYap__ActiveSpeechMap::UnbindToSpeechFinish(const FYapSpeechHandle& Handle, FYapSpeechEventDelegate Delegate)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		Container->OnSpeechFinish.Remove(Delegate);
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to unbind from speech finish but handle was not found! <%s>"), *Handle.ToString());
+	}
+}
+
+void FYap__ActiveSpeechMap::SetTimer(const FYapSpeechHandle& Handle, FYapTimerHandle TimerHandle)
+{
+	FYap__ActiveSpeechContainer* Container = FindContainer(Handle);
+
+	if (Container)
+	{
+		Container->SpeechTimerHandle = TimerHandle;
+	}
+	else
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to set timer for speech but handle was not found! <%s>"), *Handle.ToString());
+	}
+}
+
+TArray<FYapSpeechHandle> FYap__ActiveSpeechMap::GetHandles(FName SpeakerID)
+{
+	TArray<FYapSpeechHandle> Handles;
+
+	GetHandles(SpeakerID, Handles);
+
+	return Handles;
+}
+
+TArray<FYapSpeechHandle> FYap__ActiveSpeechMap::GetHandles(UObject* SpeechOwner)
+{
+	TArray<FYapSpeechHandle> Handles;
+
+	GetHandles(SpeechOwner, Handles);
+
+	return Handles;
+}
+
+TArray<FYapSpeechHandle> FYap__ActiveSpeechMap::GetHandles(const FYapConversationHandle& ConversationHandle)
+{
+	if (FYapConversation* Conversation = FindConversation(ConversationHandle))
+	{
+		return Conversation->GetRunningFragments();
+	}
+	
+	return { };
+}
+
+void FYap__ActiveSpeechMap::ForEachHandle(FName SpeakerID, TFunctionRef<void(const FYapSpeechHandle&)> Visitor) const
+{
+	if (const int32* Head = SpeechHeadsBySpeakerID.Find(SpeakerID))
+	{
+		for (int32 SlotIndex = *Head; SlotIndex != INDEX_NONE; SlotIndex = SpeechSlots[SlotIndex].NextBySpeaker)
+		{
+			Visitor(SpeechSlots[SlotIndex].Handle);
+		}
+	}
+}
+
+void FYap__ActiveSpeechMap::ForEachHandle(const UObject* SpeechOwner, TFunctionRef<void(const FYapSpeechHandle&)> Visitor) const
+{
+	if (const int32* Head = SpeechHeadsByOwner.Find(SpeechOwner))
+	{
+		for (int32 SlotIndex = *Head; SlotIndex != INDEX_NONE; SlotIndex = SpeechSlots[SlotIndex].NextByOwner)
+		{
+			Visitor(SpeechSlots[SlotIndex].Handle);
+		}
+	}
+}
+
+void FYap__ActiveSpeechMap::ForEachHandle(const FYapConversationHandle& ConversationHandle, TFunctionRef<void(const FYapSpeechHandle&)> Visitor) const
+{
+	const int32 SlotIndex = ResolveConversationSlot(ConversationHandle);
+
+	if (SlotIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	const TArray<FYapSpeechHandle>& RunningSpeech = ConversationSlots[SlotIndex].Conversation.GetRunningFragments();
+	
+	for (int32 i = RunningSpeech.Num() - 1; i >= 0; --i)
+	{
+		Visitor(RunningSpeech[i]);
+	}
+}
+
+// ================================================================================================
+
+void FYap__PromptRegistry::Register(const FYapPromptHandle& Handle, const FYapConversationHandle& Conversation, const UObject* MenuOwner)
+{
+	FYap__PromptEntry& Entry = Prompts.Add(Handle);
+	Entry.Conversation = Conversation;
+	Entry.MenuOwner = MenuOwner;
+
+	if (MenuOwner)
+	{
+		PromptsByMenuOwner.FindOrAdd(MenuOwner).Add(Handle);
+	}
+	
+	++TotalRegistered;
+	HighWaterMark = FMath::Max(HighWaterMark, Prompts.Num());
+}
+
+const FYapConversationHandle* FYap__PromptRegistry::FindConversation(const FYapPromptHandle& Handle) const
+{
+	if (const FYap__PromptEntry* Entry = Prompts.Find(Handle))
+	{
+		return &Entry->Conversation;
+	}
+
+	return nullptr;
+}
+
+void FYap__PromptRegistry::ReleaseMenuOf(const FYapPromptHandle& Handle)
+{
+	const FYap__PromptEntry* Entry = Prompts.Find(Handle);
+
+	if (!Entry)
+	{
+		return;
+	}
+
+	TArray<FYapPromptHandle> MenuPrompts;
+	
+	if (PromptsByMenuOwner.RemoveAndCopyValue(Entry->MenuOwner, MenuPrompts))
+	{
+		for (const FYapPromptHandle& MenuPrompt : MenuPrompts)
+		{
+			Prompts.Remove(MenuPrompt);
+		}
+	}
+
+	Prompts.Remove(Handle);
+}
+
+void FYap__PromptRegistry::ReleaseMenu(const UObject* MenuOwner)
+{
+	TArray<FYapPromptHandle> MenuPrompts;
+	
+	if (PromptsByMenuOwner.RemoveAndCopyValue(MenuOwner, MenuPrompts))
+	{
+		for (const FYapPromptHandle& MenuPrompt : MenuPrompts)
+		{
+			Prompts.Remove(MenuPrompt);
+		}
+	}
 }
 
-FYapConversation* FYap__ActiveSpeechMap::FindConversationByOwner(const UObject* Owner)
+void FYap__PromptRegistry::ReleaseConversation(const FYapConversationHandle& Conversation)
 {
-	if (FYapConversationHandle* Handle = ConversationsByOwner.Find(Owner))
+	// Only live prompts are in here, so this stays short
+	TArray<FYapPromptHandle, TInlineAllocator<8>> ToRelease;
+	
+	for (const auto& [Handle, Entry] : Prompts)
 	{
-		return Conversations.Find(*Handle);
+		if (Entry.Conversation == Conversation)
+		{
+			ToRelease.Add(Handle);
+		}
 	}
 
-	return nullptr;
+	for (const FYapPromptHandle& Handle : ToRelease)
+	{
+		Release(Handle);
+	}
 }
 
-FYapConversationHandle* FYap__ActiveSpeechMap::FindConversationHandleByOwner(const UObject* Owner)
+bool FYap__PromptRegistry::HasConversationPrompts(const FYapConversationHandle& Conversation) const
 {
-	return ConversationsByOwner.Find(Owner);
+	for (const auto& [Handle, Entry] : Prompts)
+	{
+		if (Entry.Conversation == Conversation)
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
-FYapConversation* FYap__ActiveSpeechMap::FindConversation(const FYapConversationHandle& ConversationHandle)
+void FYap__PromptRegistry::Reset()
 {
-	return Conversations.Find(ConversationHandle);
+	Prompts.Empty();
+	PromptsByMenuOwner.Empty();
 }
 
-FName FYap__ActiveSpeechMap::FindSpeakerID(const FYapSpeechHandle& Handle)
+void FYap__PromptRegistry::Release(const FYapPromptHandle& Handle)
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	FYap__PromptEntry Entry;
 
-	if (Container)
+	if (!Prompts.RemoveAndCopyValue(Handle, Entry))
 	{
-		return Container->SpeakerID;
+		return;
 	}
-	else
+
+	if (TArray<FYapPromptHandle>* MenuPrompts = PromptsByMenuOwner.Find(Entry.MenuOwner))
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to find speaker ID for handle but handle was not found! <%s>"), *Handle.ToString());
-		return NAME_None;
+		MenuPrompts->RemoveSingleSwap(Handle, EAllowShrinking::No);
+
+		if (MenuPrompts->Num() == 0)
+		{
+			PromptsByMenuOwner.Remove(Entry.MenuOwner);
+		}
 	}
 }
 
-FTimerHandle FYap__ActiveSpeechMap::FindTimerHandle(const FYapSpeechHandle& Handle)
+// ================================================================================================
+
+void FYap__ConversationScheduler::Add(const FYapConversationHandle& Handle, const FYapConversationRequest& Request, double Now)
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	FYap__ConversationRequest& Entry = Pending.Add(Handle);
+	Entry.Handle = Handle;
+	Entry.Request = Request;
+	Entry.Sequence = NextSequence++;
+	Entry.ExpireTime = Request.Timeout > 0.0f ? Now + Request.Timeout : 0.0;
 
-	if (Container)
+	PendingHighWaterMark = FMath::Max(PendingHighWaterMark, Pending.Num());
+
+	if (Request.bDeferred)
 	{
-		return Container->SpeechTimerHandle;
+		Deferred.Add(Handle);
+
+		// The timeout runs from the request, not from the flush
+		PushExpiry(Entry);
 	}
 	else
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to find timer handle for handle but handle was not found! <%s>"), *Handle.ToString());
-		return {};
+		Push(Entry);
 	}
 }
 
-FYapSpeechEvent FYap__ActiveSpeechMap::FindSpeechFinishedEvent(const FYapSpeechHandle& Handle)
+// ------------------------------------------------------------------------------------------------
+
+bool FYap__ConversationScheduler::Remove(const FYapConversationHandle& Handle)
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	if (Active.IsValid() && Active == Handle)
+	{
+		Active.Invalidate();
+		ActiveRequest = FYapConversationRequest();
+		return true;
+	}
 
-	if (Container)
+	if (Pending.Remove(Handle) > 0)
 	{
-		return Container->OnSpeechFinish;
+		CompactIfNeeded();
+		return true;
 	}
-	else
+
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FYap__ConversationRequest* FYap__ConversationScheduler::PeekNext()
+{
+	while (PriorityHeap.Num() > 0 && !IsCurrent(PriorityHeap.HeapTop()))
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to find speech finish event for handle but handle was not found! <%s>"), *Handle.ToString());
-		return {};
+		PriorityHeap.HeapPopDiscard(FByPriority(), EAllowShrinking::No);
 	}
+
+	return PriorityHeap.Num() > 0 ? Pending.Find(PriorityHeap.HeapTop().Handle) : nullptr;
 }
 
-FYapConversationHandle FYap__ActiveSpeechMap::FindSpeechConversationHandle(const FYapSpeechHandle& Handle)
+// ------------------------------------------------------------------------------------------------
+
+bool FYap__ConversationScheduler::ActivateNext(FYapConversationHandle& OutHandle)
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	if (Active.IsValid())
+	{
+		return false;
+	}
 
-	if (Container)
+	const FYap__ConversationRequest* Next = PeekNext();
+
+	if (!Next)
 	{
-		return Container->ConversationHandle;
+		return false;
 	}
 
-	UE_LOG(LogYap, Warning, TEXT("Tried to find conversation for handle but handle was not found! <%s>"), *Handle.ToString());
+	Active = Next->Handle;
+	ActiveRequest = Next->Request;
+	
+	Pending.Remove(Active);
+	PriorityHeap.HeapPopDiscard(FByPriority(), EAllowShrinking::No);
 
-	return {};
-}
+	++TotalActivated;
 
-bool FYap__ActiveSpeechMap::IsSpeechRunning(const FYapSpeechHandle& Handle)
-{
-	return AllSpeech.Contains(Handle);
+	OutHandle = Active;
+	return true;
 }
 
-void FYap__ActiveSpeechMap::RemoveSpeech(const FYapSpeechHandle& Handle)
-{
-	FYap__ActiveSpeechContainer Container;
+// ------------------------------------------------------------------------------------------------
 
-	if (AllSpeech.RemoveAndCopyValue(Handle, Container))
-	{		
-		ContainersByOwner[Container.SpeechOwner].Handles.Remove(Handle);
-		ContainersBySpeakerID[Container.SpeakerID].Handles.Remove(Handle);
-		
-		if (ContainersByOwner[Container.SpeechOwner].Handles.Num() == 0)
-		{
-			ContainersByOwner.Remove(Container.SpeechOwner);
-		}
+bool FYap__ConversationScheduler::FlushDeferred()
+{
+	if (Deferred.IsEmpty())
+	{
+		return false;
+	}
 
-		if (ContainersBySpeakerID[Container.SpeakerID].Handles.Num() == 0)
-		{
-			ContainersBySpeakerID.Remove(Container.SpeakerID);
-		}
-		
-		if (Container.ConversationHandle.IsValid())
+	for (const FYapConversationHandle& Handle : Deferred)
+	{
+		// May have been closed or timed out before it was ever considered
+		if (const FYap__ConversationRequest* Entry = Pending.Find(Handle))
 		{
-			if (FYapConversation* Conversation = Conversations.Find(Container.ConversationHandle))
-			{
-				Conversation->RemoveRunningSpeech(Handle);
-			}
+			PriorityHeap.HeapPush({ Entry->Handle, Entry->Sequence, Entry->Request.Priority, Entry->ExpireTime }, FByPriority());
 		}
 	}
+
+	Deferred.Reset();
+	return true;
 }
 
-void FYap__ActiveSpeechMap::BindToSpeechFinish(const FYapSpeechHandle& Handle, FYapSpeechEventDelegate Delegate)
+// ------------------------------------------------------------------------------------------------
+
+bool FYap__ConversationScheduler::RequeueActive()
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	if (!Active.IsValid())
+	{
+		return false;
+	}
 
-	if (Container)
+	FYap__ConversationRequest& Entry = Pending.Add(Active);
+	Entry.Handle = Active;
+	Entry.Request = ActiveRequest;
+	Entry.Request.bDeferred = false;
+	Entry.Request.Timeout = 0.0f;
+	Entry.Sequence = NextSequence++;
+	Entry.ExpireTime = 0.0;
+
+	PendingHighWaterMark = FMath::Max(PendingHighWaterMark, Pending.Num());
+
+	Active.Invalidate();
+	ActiveRequest = FYapConversationRequest();
+
+	Push(Entry);
+	
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYap__ConversationScheduler::RemoveExpired(double Now, TArray<FYapConversationHandle>& OutExpired)
+{
+	while (ExpiryHeap.Num() > 0 && ExpiryHeap.HeapTop().ExpireTime <= Now)
 	{
-		Container->OnSpeechFinish.Add(Delegate);
+		FHeapEntry Entry;
+		ExpiryHeap.HeapPop(Entry, FByExpiry(), EAllowShrinking::No);
+
+		if (IsCurrent(Entry))
+		{
+			Pending.Remove(Entry.Handle);
+			OutExpired.Add(Entry.Handle);
+
+			++TotalExpired;
+		}
 	}
-	else
+
+	if (OutExpired.Num() > 0)
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to bind to speech finish but handle was not found! <%s>"), *Handle.ToString());
+		CompactIfNeeded();
 	}
 }
 
-void FYap__ActiveSpeechMap::UnbindToSpeechFinish(const FYapSpeechHandle& Handle, FYapSpeechEventDelegate Delegate)
+// ------------------------------------------------------------------------------------------------
+
+void FYap__ConversationScheduler::Reset()
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	Active.Invalidate();
+	ActiveRequest = FYapConversationRequest();
+	Pending.Empty();
+	Deferred.Empty();
+	PriorityHeap.Empty();
+	ExpiryHeap.Empty();
+}
 
-	if (Container)
+// ------------------------------------------------------------------------------------------------
+
+void FYap__ConversationScheduler::Push(const FYap__ConversationRequest& Entry)
+{
+	const FHeapEntry HeapEntry { Entry.Handle, Entry.Sequence, Entry.Request.Priority, Entry.ExpireTime };
+
+	PriorityHeap.HeapPush(HeapEntry, FByPriority());
+
+	PushExpiry(Entry);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYap__ConversationScheduler::PushExpiry(const FYap__ConversationRequest& Entry)
+{
+	if (Entry.ExpireTime > 0.0)
 	{
-		Container->OnSpeechFinish.Remove(Delegate);
+		ExpiryHeap.HeapPush({ Entry.Handle, Entry.Sequence, Entry.Request.Priority, Entry.ExpireTime }, FByExpiry());
 	}
-	else
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYap__ConversationScheduler::IsCurrent(const FHeapEntry& Entry) const
+{
+	const FYap__ConversationRequest* Request = Pending.Find(Entry.Handle);
+
+	return Request && Request->Sequence == Entry.Sequence;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYap__ConversationScheduler::CompactIfNeeded()
+{
+	if (PriorityHeap.Num() + ExpiryHeap.Num() < 2 * Pending.Num() + 64)
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to unbind from speech finish but handle was not found! <%s>"), *Handle.ToString());
+		return;
 	}
+
+	PriorityHeap.RemoveAllSwap([this] (const FHeapEntry& Entry) { return !IsCurrent(Entry); }, EAllowShrinking::No);
+	PriorityHeap.Heapify(FByPriority());
+
+	ExpiryHeap.RemoveAllSwap([this] (const FHeapEntry& Entry) { return !IsCurrent(Entry); }, EAllowShrinking::No);
+	ExpiryHeap.Heapify(FByExpiry());
 }
 
-void FYap__ActiveSpeechMap::SetTimer(const FYapSpeechHandle& Handle, FTimerHandle TimerHandle)
+// ================================================================================================
+
+bool FYap__FreeSpeechBudget::Admit(const UWorld* World, FName SpeakerID, const FVector* SpeakerLocation)
 {
-	FYap__ActiveSpeechContainer* Container = AllSpeech.Find(Handle);
+	const int32 Budget = UYapProjectSettings::GetFreeSpeechBudget();
 
-	if (Container)
+	if (Budget > 0 && Running.Num() >= Budget)
 	{
-		Container->SpeechTimerHandle = TimerHandle;
+		++TotalCulled;
+		return false;
 	}
-	else
+
+	const double Now = World->GetTimeSeconds();
+	const float Cooldown = UYapProjectSettings::GetFreeSpeechSpeakerCooldown();
+	const bool bUsesCooldown = Cooldown > 0.0f && SpeakerID != NAME_None;
+
+	if (bUsesCooldown)
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to set timer for speech but handle was not found! <%s>"), *Handle.ToString());
+		const double* LastTime = LastSpeechTimes.Find(SpeakerID);
+
+		if (LastTime && Now - *LastTime < Cooldown)
+		{
+			++TotalCulled;
+			return false;
+		}
 	}
-}
 
-TArray<FYapSpeechHandle> FYap__ActiveSpeechMap::GetHandles(FName SpeakerID)
-{
-	FYapSpeechHandlesArray* Container = ContainersBySpeakerID.Find(SpeakerID);
+	const float CullDistance = UYapProjectSettings::GetFreeSpeechCullDistance();
 
-	if (Container)
+	if (CullDistance > 0.0f && SpeakerLocation)
 	{
-		return Container->Handles;
+		UpdateListener(World);
+
+		if (bHasListener && FVector::DistSquared(*SpeakerLocation, ListenerLocation) > FMath::Square(CullDistance))
+		{
+			++TotalCulled;
+			return false;
+		}
 	}
 
-	return { };
+	if (bUsesCooldown)
+	{
+		LastSpeechTimes.Add(SpeakerID, Now);
+
+		if (LastSpeechTimes.Num() > PruneThreshold)
+		{
+			for (auto It = LastSpeechTimes.CreateIterator(); It; ++It)
+			{
+				if (Now - It.Value() >= Cooldown)
+				{
+					It.RemoveCurrent();
+				}
+			}
+
+			PruneThreshold = FMath::Max(256, LastSpeechTimes.Num() * 2);
+		}
+	}
+
+	return true;
 }
 
-TArray<FYapSpeechHandle> FYap__ActiveSpeechMap::GetHandles(UObject* SpeechOwner)
+// ------------------------------------------------------------------------------------------------
+
+void FYap__FreeSpeechBudget::Reset()
 {
-	FYapSpeechHandlesArray* Container = ContainersByOwner.Find(SpeechOwner);
+	Running.Empty();
+	LastSpeechTimes.Empty();
+	PruneThreshold = 256;
+	bHasListener = false;
+	ListenerFrame = MAX_uint64;
+}
 
-	if (Container)
+// ------------------------------------------------------------------------------------------------
+
+void FYap__FreeSpeechBudget::UpdateListener(const UWorld* World)
+{
+	if (ListenerFrame == GFrameCounter)
 	{
-		return Container->Handles;
+		return;
 	}
 
-	return { };
-}
+	ListenerFrame = GFrameCounter;
+	bHasListener = false;
 
-TArray<FYapSpeechHandle> FYap__ActiveSpeechMap::GetHandles(const FYapConversationHandle& ConversationHandle)
-{
-	return { };
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+
+	if (PlayerController && PlayerController->PlayerCameraManager)
+	{
+		ListenerLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		bHasListener = true;
+	}
 }
 
 // ================================================================================================
@@ -365,7 +1109,7 @@ void UYapSubsystem::RegisterConversationHandler(UObject* NewHandler, FYapDialogu
 
 	if (NewHandler->Implements<UYapConversationHandler>())
 	{
-		Get(NewHandler->GetWorld())->FindOrAddConversationHandlerArray(NodeType).AddUnique(NewHandler);
+		Get(NewHandler->GetWorld())->FindOrAddConversationHandlerArray(NodeType).AddHandler<UYapConversationHandler, IYapConversationHandler>(NewHandler);
 	}
 	else
 	{
@@ -390,10 +1134,10 @@ void UYapSubsystem::UnregisterConversationHandler(UObject* HandlerToRemove, FYap
 		return;
 	}
 	
-	Array->Remove(HandlerToRemove);
+	Array->RemoveHandler(HandlerToRemove);
 
 	
-	if (Array->IsEmpty())
+	if (Array->Array.IsEmpty())
 	{
 		Get(HandlerToRemove->GetWorld())->ConversationHandlers.Remove(NodeType.Get());
 	}
@@ -411,7 +1155,7 @@ void UYapSubsystem::RegisterFreeSpeechHandler(UObject* NewHandler, FYapDialogueN
 	
 	if (NewHandler->Implements<UYapFreeSpeechHandler>())
 	{
-		Get(NewHandler->GetWorld())->FindOrAddFreeSpeechHandlerArray(NodeType).AddUnique(NewHandler);
+		Get(NewHandler->GetWorld())->FindOrAddFreeSpeechHandlerArray(NodeType).AddHandler<UYapFreeSpeechHandler, IYapFreeSpeechHandler>(NewHandler);
 	}
 	else
 	{
@@ -436,9 +1180,9 @@ void UYapSubsystem::UnregisterFreeSpeechHandler(UObject* HandlerToRemove, FYapDi
 		return;
 	}
 
-	Array->Remove(HandlerToRemove);
+	Array->RemoveHandler(HandlerToRemove);
 	
-	if (Array->IsEmpty())
+	if (Array->Array.IsEmpty())
 	{
 		// For some reason my implicit type conversion doesn't work for TArray funcs
 		Get(HandlerToRemove->GetWorld())->FreeSpeechHandlers.Remove(NodeType.Get());
@@ -532,7 +1276,7 @@ EYapMaturitySetting UYapSubsystem::GetCurrentMaturitySetting(UWorld* World)
 	
 	UYapBroker& Broker = GetBroker(World);
 
-	MaturitySetting = Broker.GetMaturitySetting();
+	MaturitySetting = Broker.GetMaturitySetting_Internal();
 
 	// Something went wrong... we will hard-code default to mature.
 	if (MaturitySetting == EYapMaturitySetting::Unspecified)
@@ -558,34 +1302,82 @@ EYapMaturitySetting UYapSubsystem::GetCurrentMaturitySetting(UWorld* World)
 
 // ------------------------------------------------------------------------------------------------
 
-void UYapSubsystem::RegisterTaggedFragment(const FGameplayTag& FragmentTag, UFlowNode_YapDialogue* DialogueNode)
+void UYapSubsystem::RegisterTaggedFragments(UFlowNode_YapDialogue* DialogueNode)
+{
+	TaggedFragments.Register(DialogueNode);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::UnregisterTaggedFragments(const UFlowNode_YapDialogue* DialogueNode)
+{
+	TaggedFragments.Unregister(DialogueNode);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapFragment* UYapSubsystem::FindTaggedFragment(const FGameplayTag& FragmentTag)
+{
+	const FYapFragmentLocation* Location = TaggedFragments.Find(FragmentTag.GetTagName());
+
+	return Location ? Location->Get() : nullptr;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::FindTaggedFragments(const FGameplayTag& FragmentTag, TArray<FYapFragmentLocation>& OutLocations, bool bIncludeChildren) const
+{
+	TaggedFragments.FindAll(FragmentTag.GetTagName(), bIncludeChildren, OutLocations);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::SetBitReplacement(const FGameplayTag& FragmentTag, const FYapBitReplacement& Replacement, EYapBitReplacementLayer Layer)
 {
-	if (TaggedFragments.Contains(FragmentTag))
+	if (!FragmentTag.IsValid())
 	{
-		UE_LOG(LogYap, Warning, TEXT("Tried to register tagged fragment with tag [%s] but this tag was already registered! Find and fix the duplicate tag usage."), *FragmentTag.ToString()); // TODO if I pass in the full fragment I could log the dialogue text to make this easier for designers?
+		UE_LOG(LogYap, Warning, TEXT("Tried to set a bit replacement without a fragment tag, ignoring!"));
 		return;
 	}
-	
-	TaggedFragments.Add(FragmentTag, DialogueNode);
+
+	if (UYapBitReplacementRegister::IsPersistentLayer(Layer) && BitReplacementRegister.IsValid())
+	{
+		BitReplacementRegister->Set(Layer, FragmentTag.GetTagName(), Replacement);
+		return;
+	}
+
+	BitReplacements.Set(Layer, FragmentTag.GetTagName(), Replacement);
 }
 
 // ------------------------------------------------------------------------------------------------
 
-FYapFragment* UYapSubsystem::FindTaggedFragment(const FGameplayTag& FragmentTag)
+void UYapSubsystem::RemoveBitReplacement(const FGameplayTag& FragmentTag, EYapBitReplacementLayer Layer)
 {
-	UFlowNode_YapDialogue** DialoguePtr = TaggedFragments.Find(FragmentTag);
+	if (UYapBitReplacementRegister::IsPersistentLayer(Layer) && BitReplacementRegister.IsValid())
+	{
+		BitReplacementRegister->Remove(Layer, FragmentTag.GetTagName());
+		return;
+	}
+
+	BitReplacements.Remove(Layer, FragmentTag.GetTagName());
+}
+
+// ------------------------------------------------------------------------------------------------
 
-	if (DialoguePtr)
+void UYapSubsystem::SetBitReplacementLayer(EYapBitReplacementLayer Layer, TMap<FName, FYapBitReplacement> Replacements)
+{
+	if (UYapBitReplacementRegister::IsPersistentLayer(Layer) && BitReplacementRegister.IsValid())
 	{
-		return (*DialoguePtr)->FindTaggedFragment(FragmentTag);
+		BitReplacementRegister->SetLayer(Layer, MoveTemp(Replacements));
+		return;
 	}
 
-	return nullptr;
+	BitReplacements.SetLayer(Layer, MoveTemp(Replacements));
 }
 
 // ------------------------------------------------------------------------------------------------
 
-FYapConversation& UYapSubsystem::OpenConversation(FName ConversationName, UObject* ConversationOwner)
+FYapConversation& UYapSubsystem::OpenConversation(FName ConversationName, UObject* ConversationOwner, const FYapConversationRequest& Request)
 {
 	if (!ConversationName.IsValid())
 	{
@@ -595,11 +1387,11 @@ FYapConversation& UYapSubsystem::OpenConversation(FName ConversationName, UObjec
 	FYapConversationHandle NewHandle;
 	FYapConversation& NewConversation = ActiveSpeechMap.AddConversation(ConversationName, ConversationOwner, NewHandle);
 
-	ConversationQueue.EmplaceAt(0, NewHandle);
-	
-	if (ConversationQueue.Num() == 1)
+	ConversationScheduler.Add(NewHandle, Request, GetWorld()->GetTimeSeconds());
+
+	if (!Request.bDeferred)
 	{
-		StartOpeningConversation(NewConversation);
+		UpdateConversationSchedule();
 	}
 
 	return NewConversation;
@@ -613,7 +1405,7 @@ EYapConversationState UYapSubsystem::CloseConversation(FYapConversationHandle& H
 
 	if (ConversationPtr)
 	{
-		check(ConversationQueue.Contains(Handle));
+		check(ConversationScheduler.Contains(Handle));
 
 		return StartClosingConversation(Handle);
 	}
@@ -689,6 +1481,8 @@ bool UYapSubsystem::StartOpeningConversation(FYapConversation& Conversation)
 	// Game code may add opening locks to the conversation here
 	BroadcastEventHandlerFunc<YAP_BROADCAST_EVT_TARGS(YapConversationHandler, OnConversationOpened, Execute_K2_ConversationOpened)>(HandlerArray, Data, Conversation.GetHandle());
 
+	RecordSessionEvent(EYapSessionEvent::ConversationOpened, Conversation.GetHandle());
+	
 	Conversation.StartOpening(this);
 
 	return true;
@@ -704,9 +1498,13 @@ EYapConversationState UYapSubsystem::StartClosingConversation(FYapConversationHa
 
 		if (ConversationPtr->GetState() == EYapConversationState::Closed)
 		{
-			ConversationQueue.Remove(Handle);
+			RecordSessionEvent(EYapSessionEvent::ConversationClosed, Handle);
+			
+			ConversationScheduler.Remove(Handle);
 
 			ActiveSpeechMap.RemoveConversation(Handle);
+
+			PromptRegistry.ReleaseConversation(Handle);
 			
 			Handle.Invalidate();
 			
@@ -723,51 +1521,120 @@ EYapConversationState UYapSubsystem::StartClosingConversation(FYapConversationHa
 	}
 	else
 	{
-		UE_LOG(LogYap, Error, TEXT("Failed to close conversation {s}, conversation does not exist!"));
-		return EYapConversationState::Undefined;
+		UE_LOG(LogYap, Error, TEXT("Failed to close conversation {s}, conversation does not exist!"));
+		return EYapConversationState::Undefined;
+	}
+}
+
+const FYapConversationHandle& UYapSubsystem::GetActiveConversation()
+{
+	return ConversationScheduler.GetActive();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::StartNextQueuedConversation()
+{
+	FYapConversationHandle NextHandle;
+
+	if (!ConversationScheduler.ActivateNext(NextHandle))
+	{
+		return;
+	}
+
+	// Not through the handle overload; that one refuses to open the conversation which is already active, which this now is
+	if (FYapConversation* ConversationPtr = ActiveSpeechMap.FindConversation(NextHandle))
+	{
+		(void) StartOpeningConversation(*ConversationPtr);
 	}
 }
 
-const FYapConversationHandle& UYapSubsystem::GetActiveConversation()
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::UpdateConversationSchedule()
 {
-	int32 Index = ConversationQueue.Num() - 1;
+	if (!ConversationScheduler.GetActive().IsValid())
+	{
+		StartNextQueuedConversation();
+		return;
+	}
+
+	const FYap__ConversationRequest* Next = ConversationScheduler.PeekNext();
 
-	if (Index == INDEX_NONE)
+	if (!Next || !Next->Request.bPreempt || Next->Request.Priority <= ConversationScheduler.GetActivePriority())
 	{
-		return FYapConversationHandle::GetNullHandle();
+		return;
 	}
-		
-	return ConversationQueue[ConversationQueue.Num() - 1];
+
+	const FYapConversationHandle& ActiveHandle = ConversationScheduler.GetActive();
+	
+	FYapConversation* ActivePtr = ActiveSpeechMap.FindConversation(ActiveHandle);
+
+	// Only preempt at a speech boundary; otherwise this is checked again next tick
+	if (!ActivePtr || ActivePtr->GetState() != EYapConversationState::Open || ActivePtr->GetRunningFragments().Num() > 0 || PromptRegistry.HasConversationPrompts(ActiveHandle))
+	{
+		return;
+	}
+	
+	UE_LOG(LogYap, Display, TEXT("Subsystem: Conversation %s preempted by %s"), *ActivePtr->GetConversationName().ToString(), *Next->Handle.ToString());
+
+	SuspendActiveConversation(*ActivePtr);
+
+	StartNextQueuedConversation();
 }
 
 // ------------------------------------------------------------------------------------------------
 
-void UYapSubsystem::StartNextQueuedConversation()
+void UYapSubsystem::SuspendActiveConversation(FYapConversation& Conversation)
+{
+	const FYapConversationHandle Handle = Conversation.GetHandle();
+
+	ConversationScheduler.RequeueActive();
+
+	Conversation.Suspend();
+
+	// The flow is not closed; its dialogue nodes wait for the conversation to open again (see UFlowNode_YapDialogue::WaitForSuspendedConversation)
+	Conversation.OnConversationDropped.Broadcast(this, Handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::DropConversationRequest(const FYapConversationHandle& Handle)
 {
-	if (ConversationQueue.Num() == 0)
+	FYapConversation* ConversationPtr = ActiveSpeechMap.FindConversation(Handle);
+
+	if (!ConversationPtr)
 	{
 		return;
 	}
-	else
-	{
-		StartOpeningConversation(ConversationQueue[ConversationQueue.Num() - 1]);	
-	}
+
+	UE_LOG(LogYap, Display, TEXT("Subsystem: Conversation %s timed out waiting for its turn, dropping it"), *ConversationPtr->GetConversationName().ToString());
+
+	ConversationPtr->OnConversationDropped.Broadcast(this, Handle);
+
+	ActiveSpeechMap.RemoveConversation(Handle);
+
+	PromptRegistry.ReleaseConversation(Handle);
 }
 
 // ------------------------------------------------------------------------------------------------
 
 void UYapSubsystem::OnActiveConversationClosed(UObject* Instigator, FYapConversationHandle Handle)
 {	
-	ConversationQueue.Remove(Handle);
+	RecordSessionEvent(EYapSessionEvent::ConversationClosed, Handle);
+	
+	ConversationScheduler.Remove(Handle);
 	
 	ActiveSpeechMap.RemoveConversation(Handle);
+
+	PromptRegistry.ReleaseConversation(Handle);
 	
 	StartNextQueuedConversation();
 }
 
 // ------------------------------------------------------------------------------------------------
 
-FYapPromptHandle UYapSubsystem::BroadcastPrompt(const FYapData_PlayerPromptCreated& Data, FYapDialogueNodeClassType NodeType)
+FYapPromptHandle UYapSubsystem::BroadcastPrompt(const FYapData_PlayerPromptCreated& Data, FYapDialogueNodeClassType NodeType, const UObject* MenuOwner)
 {
 	FYapPromptHandle Handle(NodeType);
 
@@ -782,7 +1649,9 @@ FYapPromptHandle UYapSubsystem::BroadcastPrompt(const FYapData_PlayerPromptCreat
 		return NullHandle;
 	}
 	
-	PromptHandleConversationTags.Add(Handle, ConversationHandle);
+	PromptRegistry.Register(Handle, ConversationHandle, MenuOwner);
+
+	RecordSessionEvent(EYapSessionEvent::PromptBroadcast, Handle);
 
 	auto* HandlerArray = FindConversationHandlerArray(NodeType);
 
@@ -804,21 +1673,27 @@ void UYapSubsystem::OnFinishedBroadcastingPrompts(const FYapData_PlayerPromptsRe
 
 void UYapSubsystem::RunSpeech(const FYapData_SpeechBegins& SpeechData, FYapDialogueNodeClassType NodeType, const FYapSpeechHandle& SpeechHandle)
 {
-	TArray<FYapSpeechHandle> ActiveSpeechHandle = ActiveSpeechMap.GetHandles(SpeechData.SpeakerID);
-
+	YAP_SCOPE(STAT_YapRunSpeech, "Yap RunSpeech", GetSpeechOwnerDialogueID(ActiveSpeechMap.FindSpeechOwner(SpeechHandle)), SpeechData.SpeakerID);
+	
 	UFlowNode_YapDialogue* CDO = NodeType.Get()->GetDefaultObject<UFlowNode_YapDialogue>();
 	const UYapNodeConfig& Config = CDO->GetNodeConfig();
 
+	RecordSessionEvent(EYapSessionEvent::SpeechBegins, SpeechHandle);
+
 	if (!Config.DialoguePlayback.bPermitOverlappingSpeech)
 	{
-		for (int32 i = ActiveSpeechHandle.Num() - 1; i >= 0; --i)
+		// Completing speech mutates the map, so gather first; handles come back newest first
+		TArray<FYapSpeechHandle, TInlineAllocator<8>> ActiveSpeechHandles;
+		ActiveSpeechMap.GetHandles(SpeechData.SpeakerID, ActiveSpeechHandles);
+		
+		for (const FYapSpeechHandle& ActiveSpeechHandle : ActiveSpeechHandles)
 		{
-			if (ActiveSpeechHandle[i] == SpeechHandle)
+			if (ActiveSpeechHandle == SpeechHandle)
 			{
 				continue;
 			}
 			
-			OnSpeechComplete(ActiveSpeechHandle[i], true);
+			OnSpeechComplete(ActiveSpeechHandle, true);
 		}
 	}
 
@@ -829,19 +1704,17 @@ void UYapSubsystem::RunSpeech(const FYapData_SpeechBegins& SpeechData, FYapDialo
 		
 		if (ConversationHandle.IsValid())
 		{
-			if (FYapSpeechHandlesArray* FragileHandles = FragileSpeechHandles.Find(ConversationHandle))
+			FYapSpeechHandlesArray FragileHandles;
+			
+			if (FragileSpeechHandles.RemoveAndCopyValue(ConversationHandle, FragileHandles))
 			{
-				TArray<FYapSpeechHandle> FragileHandlesCopy = FragileHandles->Handles;
-
-				for (FYapSpeechHandle& Handle : FragileHandlesCopy)
+				for (FYapSpeechHandle& Handle : FragileHandles.Handles)
 				{
 					if (ActiveSpeechMap.IsSpeechRunning(Handle))
 					{
 						CancelSpeech(this, Handle);
 					}
 				}
-
-				FragileSpeechHandles.Remove(ConversationHandle);
 			}
 		}
 		
@@ -851,6 +1724,8 @@ void UYapSubsystem::RunSpeech(const FYapData_SpeechBegins& SpeechData, FYapDialo
 	}
 	else
 	{
+		FreeSpeechBudget.AddRunning(SpeechHandle);
+		
 		auto* HandlerArray = FindFreeSpeechHandlerArray(NodeType);
 		
 		BroadcastEventHandlerFunc<YAP_BROADCAST_EVT_TARGS(YapFreeSpeechHandler, OnTalkSpeechBegins, Execute_K2_TalkSpeechBegins)>(HandlerArray, SpeechData, SpeechHandle);
@@ -858,11 +1733,11 @@ void UYapSubsystem::RunSpeech(const FYapData_SpeechBegins& SpeechData, FYapDialo
 
 	if (SpeechData.SpeechTime > 0)
 	{
-		FTimerHandle SpeechTimerHandle;
-		FTimerDelegate Delegate = FTimerDelegate::CreateUObject(this, &ThisClass::OnSpeechComplete, SpeechHandle, true, EYapSpeechCompleteResult::Normal);
-		GetWorld()->GetTimerManager().SetTimer(SpeechTimerHandle, Delegate, SpeechData.SpeechTime, false);
-
-		ActiveSpeechMap.SetTimer(SpeechHandle, SpeechTimerHandle);
+		FYapTimerPayload Payload;
+		Payload.Event = EYapTimerEvent::SpeechComplete;
+		Payload.SpeechHandle = SpeechHandle;
+		
+		ActiveSpeechMap.SetTimer(SpeechHandle, TimingWheel.Schedule(SpeechData.SpeechTime, Payload));
 	}
 	else
 	{
@@ -870,6 +1745,28 @@ void UYapSubsystem::RunSpeech(const FYapData_SpeechBegins& SpeechData, FYapDialo
 	}
 }
 
+void UYapSubsystem::PrefetchAhead(UFlowNode_YapDialogue* DialogueNode)
+{
+	ContentPrefetcher.PrefetchFrom(DialogueNode, UYapProjectSettings::GetPrefetchLookAheadDepth());
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapTimerHandle UYapSubsystem::StartPaddingTimer(UFlowNode_YapDialogue* DialogueNode, const FYapSpeechHandle& Handle, float PaddingTime)
+{
+	FYapTimerPayload Payload;
+	Payload.Event = EYapTimerEvent::PaddingComplete;
+	Payload.SpeechHandle = Handle;
+	Payload.Target = DialogueNode;
+
+	return TimingWheel.Schedule(PaddingTime, Payload);
+}
+
+void UYapSubsystem::ClearTimer(FYapTimerHandle& TimerHandle)
+{
+	TimingWheel.Cancel(TimerHandle);
+}
+
 void UYapSubsystem::MarkConversationSpeechAsFragile(const FYapSpeechHandle& Handle)
 {
 	FYapConversationHandle ConversationHandle = ActiveSpeechMap.FindSpeechConversationHandle(Handle);
@@ -933,6 +1830,7 @@ void UYapSubsystem::RunPrompt(UObject* WorldContext, const FYapPromptHandle& Han
 	if (!IsValid(WorldContext))
 	{
 		UE_LOG(LogYap, Error, TEXT("Tried to call UYapSubsystem::RunPrompt with a null world context, ignoring!"));
+		return;
 	}
 	
 	if (!Handle.IsValid())
@@ -942,36 +1840,124 @@ void UYapSubsystem::RunPrompt(UObject* WorldContext, const FYapPromptHandle& Han
 	}
 
 	UYapSubsystem* Subsystem = Get(WorldContext);
+
+	if (!Subsystem)
+	{
+		return;
+	}
+
+	// Every prompt is registered with its conversation; prompts which were already chosen, replaced by a newer menu or outlived their conversation are gone
+	const FYapConversationHandle* ConversationHandle = Subsystem->PromptRegistry.FindConversation(Handle);
+
+	if (!ConversationHandle)
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to run prompt <%s>, but it can no longer be chosen, ignoring!"), *Handle.GetGuid().ToString());
+		return;
+	}
+
+	const FYapConversation* Conversation = GetConversationByHandle(WorldContext, *ConversationHandle);
+
+	if (!Conversation)
+	{
+		UE_LOG(LogYap, Warning, TEXT("Tried to run prompt <%s>, but its conversation no longer exists, ignoring!"), *Handle.GetGuid().ToString());
+		Subsystem->PromptRegistry.ReleaseMenuOf(Handle);
+		return;
+	}
+
+	Subsystem->RecordSessionEvent(EYapSessionEvent::PromptChosen, Handle);
 	
 	// Broadcast to game listeners
 	FYapData_PlayerPromptChosen Data;
 
-	FYapConversationHandle* ConversationHandle = Subsystem->PromptHandleConversationTags.Find(Handle);
+	auto* HandlerArray = Subsystem->FindConversationHandlerArray(Conversation->GetNodeType());
+
+	BroadcastEventHandlerFunc<YAP_BROADCAST_EVT_TARGS(YapConversationHandler, OnConversationPlayerPromptChosen, Execute_K2_ConversationPlayerPromptChosen)>(HandlerArray, Data, Handle);
+
+	// The rest of the menu can no longer be chosen
+	Subsystem->PromptRegistry.ReleaseMenuOf(Handle);
+	
+	// Broadcast to Yap systems
+	Subsystem->OnPromptChosen.Broadcast(Subsystem, Handle);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::ReleasePrompts(const UObject* MenuOwner)
+{
+	PromptRegistry.ReleaseMenu(MenuOwner);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::StartSessionRecording()
+{
+	SessionRecorder.Start(*this);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FString UYapSubsystem::StopSessionRecording(const FString& Filename)
+{
+	const FString OutputFilename = Filename.IsEmpty() ? FYapSessionRecorder::MakeFilename(GetWorld()) : Filename;
+
+	return SessionRecorder.Stop(OutputFilename) ? OutputFilename : FString();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool UYapSubsystem::ReplaySession(const FString& Filename)
+{
+	TUniquePtr<FYapSessionReplayer> NewReplayer = MakeUnique<FYapSessionReplayer>();
 
-	if (ConversationHandle)
+	if (!NewReplayer->Load(Filename))
 	{
-		const FYapConversation* Conversation = GetConversationByHandle(WorldContext, *ConversationHandle);
+		return false;
+	}
 
-		if (Conversation)
-		{
-			auto* HandlerArray = Subsystem->FindConversationHandlerArray(Conversation->GetNodeType());
-		
-			BroadcastEventHandlerFunc<YAP_BROADCAST_EVT_TARGS(YapConversationHandler, OnConversationPlayerPromptChosen, Execute_K2_ConversationPlayerPromptChosen)>(HandlerArray, Data, Handle);
-		}
-		else
-		{
-			// TODO error handling!
-		}
+	// Ending a replay which is still running restores the game's seed first, so the new replay saves that one
+	if (SessionReplayer.IsValid())
+	{
+		SessionReplayer->End();
 	}
-	else
+
+	SessionReplayer = MoveTemp(NewReplayer);
+	SessionReplayer->Begin(*this);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+template<typename THandle>
+void UYapSubsystem::RecordSessionEvent(EYapSessionEvent Event, const THandle& Handle, EYapSpeechCompleteResult Result)
+{
+	SessionRecorder.Record(*this, Event, Handle.GetGuid(), Result);
+
+	if (SessionReplayer.IsValid() && Event < EYapSessionEvent::SpeechEnded)
 	{
-		auto* HandlerArray = Subsystem->FindFreeSpeechHandlerArray(Handle.GetNodeType());
-	
-		BroadcastEventHandlerFunc<YAP_BROADCAST_EVT_TARGS(YapConversationHandler, OnConversationPlayerPromptChosen, Execute_K2_ConversationPlayerPromptChosen)>(HandlerArray, Data, Handle);
+		SessionReplayer->RegisterLiveHandle(Handle);
+		SessionReplayer->OnOutput(*this, Event, Handle.GetGuid(), Result);
 	}
+}
 
-	// Broadcast to Yap systems
-	Subsystem->OnPromptChosen.Broadcast(Subsystem, Handle);
+// ------------------------------------------------------------------------------------------------
+
+TSharedPtr<const FYapDialogueDatabase> UYapSubsystem::GetDialogueDatabase(const UFlowAsset* FlowAsset) const
+{
+	if (!FPlatformProperties::RequiresCookedData() || !IsValid(FlowAsset))
+	{
+		return nullptr;
+	}
+
+	// Running flows are instances of the asset on disk; all of them share its database
+	const UFlowAsset* TemplateAsset = FYapDialogueDatabase::GetTemplateAsset(FlowAsset);
+
+	if (const TSharedPtr<const FYapDialogueDatabase>* Existing = DialogueDatabases.Find(TemplateAsset))
+	{
+		return *Existing;
+	}
+
+	return DialogueDatabases.Add(TemplateAsset, FYapDialogueDatabase::Open(TemplateAsset));
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1002,7 +1988,8 @@ bool UYapSubsystem::CancelSpeech(UObject* SpeechOwner)
 
 	if (Subsystem)
 	{
-		TArray<FYapSpeechHandle> Handles = Subsystem->ActiveSpeechMap.GetHandles(SpeechOwner);
+		TArray<FYapSpeechHandle, TInlineAllocator<8>> Handles;
+		Subsystem->ActiveSpeechMap.GetHandles(SpeechOwner, Handles);
 
 		for (FYapSpeechHandle& Handle : Handles)
 		{
@@ -1043,7 +2030,8 @@ bool UYapSubsystem::AdvanceSpeech(UObject* SpeechOwner)
 
 	if (Subsystem)
 	{
-		TArray<FYapSpeechHandle> Handles = Subsystem->ActiveSpeechMap.GetHandles(SpeechOwner);
+		TArray<FYapSpeechHandle, TInlineAllocator<8>> Handles;
+		Subsystem->ActiveSpeechMap.GetHandles(SpeechOwner, Handles);
 
 		for (FYapSpeechHandle& Handle : Handles)
 		{
@@ -1070,12 +2058,14 @@ bool UYapSubsystem::EndSpeech(FYapSpeechHandle& Handle, EYapSpeechCompleteResult
 
 	FYapSpeechHandle HandleCopy = Handle;
 	Handle.Invalidate();
+
+	RecordSessionEvent(EYapSessionEvent::SpeechEnded, HandleCopy, Result);
 	
-	FTimerHandle TimerHandle = ActiveSpeechMap.FindTimerHandle(HandleCopy);
+	FYapTimerHandle TimerHandle = ActiveSpeechMap.FindTimerHandle(HandleCopy);
 	
 	if (TimerHandle.IsValid())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(TimerHandle);
+		ClearTimer(TimerHandle);
 
 		FYapSpeechEvent Evt;
 
@@ -1107,6 +2097,10 @@ void UYapSubsystem::AdvanceConversation(UObject* Instigator, const FYapConversat
 		UE_LOG(LogYap, Warning, TEXT("UYapSubsystem::AdvanceConversation - could not find conversation for handle {%s}"), *ConversationHandle.ToString());
 		return;
 	}
+
+	YAP_SCOPE(STAT_YapAdvanceConversation, "Yap AdvanceConversation", ConversationPtr->GetConversationName(), FName(NAME_None));
+	
+	Subsystem->RecordSessionEvent(EYapSessionEvent::ConversationAdvanced, ConversationHandle);
 	
 	TArray<FYapSpeechHandle> RunningFragments = ConversationPtr->GetRunningFragments();
 	
@@ -1126,17 +2120,22 @@ void UYapSubsystem::AdvanceConversation(UObject* Instigator, const FYapConversat
 
 bool UYapSubsystem::EmitSpeechResult(const FYapSpeechHandle& Handle, EYapSpeechCompleteResult Result)
 {	
-	FYapSpeechEvent Evt = ActiveSpeechMap.FindSpeechFinishedEvent(Handle);
+	// The speech is removed before broadcasting, so move the event out rather than copying its invocation list
+	FYapSpeechEvent Evt = ActiveSpeechMap.TakeSpeechFinishedEvent(Handle);
 
-	FTimerHandle Timer = ActiveSpeechMap.FindTimerHandle(Handle);
+	FYapTimerHandle Timer = ActiveSpeechMap.FindTimerHandle(Handle);
 
 	ActiveSpeechMap.RemoveSpeech(Handle);
+
+	FreeSpeechBudget.RemoveRunning(Handle);
+
+	RecordSessionEvent(EYapSessionEvent::SpeechResult, Handle, Result);
 	
 	Evt.Broadcast(this, Handle, Result);
 	
 	if (Timer.IsValid())
 	{
-		GetWorld()->GetTimerManager().ClearTimer(Timer);
+		ClearTimer(Timer);
 	}
 	
 	return true;
@@ -1144,6 +2143,55 @@ bool UYapSubsystem::EmitSpeechResult(const FYapSpeechHandle& Handle, EYapSpeechC
 
 // ------------------------------------------------------------------------------------------------
 
+bool UYapSubsystem::AdmitFreeSpeech(FName SpeakerID, const UObject* LocationContext)
+{
+	const AActor* SpeakerActor = nullptr;
+
+	// Locations are only needed for distance culling
+	if (UYapProjectSettings::GetFreeSpeechCullDistance() > 0.0f)
+	{
+		if (const UYapCharacterComponent* CharacterComponent = FindCharacterComponent(GetWorld(), SpeakerID))
+		{
+			SpeakerActor = CharacterComponent->GetOwner();
+		}
+		else if (const AActor* Actor = Cast<AActor>(LocationContext))
+		{
+			SpeakerActor = Actor;
+		}
+		else if (const UActorComponent* Component = Cast<UActorComponent>(LocationContext))
+		{
+			SpeakerActor = Component->GetOwner();
+		}
+	}
+
+	const FVector SpeakerLocation = SpeakerActor ? SpeakerActor->GetActorLocation() : FVector::ZeroVector;
+
+	if (FreeSpeechBudget.Admit(GetWorld(), SpeakerID, SpeakerActor ? &SpeakerLocation : nullptr))
+	{
+		return true;
+	}
+
+	INC_DWORD_STAT(STAT_YapCulledFreeSpeech);
+	
+	UE_LOG(LogYap, VeryVerbose, TEXT("Subsystem: Culled free speech from %s"), *SpeakerID.ToString());
+	
+	return false;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::CullSpeech(const FYapSpeechHandle& Handle)
+{
+	FYapTimerPayload Payload;
+	Payload.Event = EYapTimerEvent::SpeechCulled;
+	Payload.SpeechHandle = Handle;
+
+	// Cancelling the speech before then clears the timer along with it
+	ActiveSpeechMap.SetTimer(Handle, TimingWheel.Schedule(0.0f, Payload));
+}
+
+// ------------------------------------------------------------------------------------------------
+
 void UYapSubsystem::RegisterCharacterComponent(UYapCharacterComponent* YapCharacterComponent)
 {
 	AActor* Actor = YapCharacterComponent->GetOwner();
@@ -1157,6 +2205,8 @@ void UYapSubsystem::RegisterCharacterComponent(UYapCharacterComponent* YapCharac
 	YapCharacterComponents.Add(YapCharacterComponent->GetCharacterID(), YapCharacterComponent);
 	
 	RegisteredYapCharacterActors.Add(Actor);
+
+	CharacterGrid.Add(YapCharacterComponent);
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1167,48 +2217,40 @@ void UYapSubsystem::UnregisterCharacterComponent(UYapCharacterComponent* YapChar
 
 	YapCharacterComponents.Remove(YapCharacterComponent->GetCharacterID());
 	RegisteredYapCharacterActors.Remove(Actor);
+
+	CharacterGrid.Remove(YapCharacterComponent);
 }
 
 // ------------------------------------------------------------------------------------------------
 
-TArray<TObjectPtr<UObject>>& UYapSubsystem::FindOrAddConversationHandlerArray(FYapDialogueNodeClassType NodeType)
+FYapHandlersArray& UYapSubsystem::FindOrAddConversationHandlerArray(FYapDialogueNodeClassType NodeType)
 {	
-	return ConversationHandlers.FindOrAdd(NodeType).Array;
+	return ConversationHandlers.FindOrAdd(NodeType);
 }
 
 // ------------------------------------------------------------------------------------------------
 
-TArray<TObjectPtr<UObject>>* UYapSubsystem::FindConversationHandlerArray(FYapDialogueNodeClassType NodeType)
+FYapHandlersArray* UYapSubsystem::FindConversationHandlerArray(FYapDialogueNodeClassType NodeType)
 {
 	FYapHandlersArray* Handlers = ConversationHandlers.Find(NodeType.Get());
 
-	if (Handlers)
-	{
-		return &Handlers->Array;
-	}
-
-	return nullptr;
+	return Handlers;
 }
 
 // ------------------------------------------------------------------------------------------------
 
-TArray<TObjectPtr<UObject>>& UYapSubsystem::FindOrAddFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType)
+FYapHandlersArray& UYapSubsystem::FindOrAddFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType)
 {
-	return FreeSpeechHandlers.FindOrAdd(NodeType).Array;
+	return FreeSpeechHandlers.FindOrAdd(NodeType);
 }
 
 // ------------------------------------------------------------------------------------------------
 
-TArray<TObjectPtr<UObject>>* UYapSubsystem::FindFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType)
+FYapHandlersArray* UYapSubsystem::FindFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType)
 {
 	FYapHandlersArray* Handlers = FreeSpeechHandlers.Find(NodeType.Get());
 
-	if (Handlers)
-	{
-		return &Handlers->Array;
-	}
-
-	return nullptr;
+	return Handlers;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1231,17 +2273,64 @@ FYapSpeechHandle UYapSubsystem::GetNewSpeechHandle(FGuid Guid, FName SpeakerID,
 
 void UYapSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	Super::Initialize(Collection);
+	
+	// 1/60s steps and 1024 buckets covers ~17 seconds per revolution; longer timers just wait for their tick to come around
+	TimingWheel.Initialize(1.0f / 60.0f, 1024);
+
+	CharacterGrid.Initialize(UYapProjectSettings::GetCharacterGridCellSize());
+	
 	Broker = NewObject<UYapBroker>(this, UYapProjectSettings::GetBrokerClass());
 
 	bGetGameMaturitySettingWarningIssued = false;
 
 	NoiseGenerator = NewObject<UYapSquirrel>(this);
+
+	// Persistent replacement layers live on the game instance, so that they survive map travel
+	if (const UGameInstance* GameInstance = GetWorld()->GetGameInstance())
+	{
+		if (UYapBitReplacementRegister* Register = GameInstance->GetSubsystem<UYapBitReplacementRegister>())
+		{
+			Register->AddWorldSubsystem(this);
+			BitReplacementRegister = Register;
+		}
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
 
 void UYapSubsystem::Deinitialize()
 {
+	TimingWheel.Reset();
+
+	PromptRegistry.Reset();
+
+	ConversationScheduler.Reset();
+
+	FreeSpeechBudget.Reset();
+
+	CharacterGrid.Reset();
+
+	TaggedFragments.Reset();
+
+	if (BitReplacementRegister.IsValid())
+	{
+		BitReplacementRegister->RemoveWorldSubsystem(this);
+		BitReplacementRegister.Reset();
+	}
+	
+	BitReplacements.Reset();
+
+	DialogueDatabases.Empty();
+
+	if (SessionRecorder.IsRecording())
+	{
+		StopSessionRecording();
+	}
+
+	SessionReplayer.Reset();
+	
+	Super::Deinitialize();
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -1252,6 +2341,93 @@ void UYapSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 	{
 		Broker->Initialize_Internal();
 	}
+
+	if (UYapProjectSettings::GetRecordSessions() && InWorld.IsGameWorld())
+	{
+		StartSessionRecording();
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	
+	SCOPE_CYCLE_COUNTER(STAT_YapFireTimers);
+	LLM_SCOPE_BYTAG(Yap);
+
+	TimingWheel.Advance(DeltaTime, [this] (const FYapTimerPayload& Payload)
+	{
+		OnTimerExpired(Payload);
+	});
+
+	SET_DWORD_STAT(STAT_YapScheduledTimers, TimingWheel.Num());
+
+	CharacterGrid.Update();
+
+	TArray<FYapConversationHandle> ExpiredConversations;
+	ConversationScheduler.RemoveExpired(GetWorld()->GetTimeSeconds(), ExpiredConversations);
+
+	for (const FYapConversationHandle& Handle : ExpiredConversations)
+	{
+		DropConversationRequest(Handle);
+	}
+
+	ConversationScheduler.FlushDeferred();
+
+	// A preempting request waits for a speech boundary of the active conversation, which may only come on a later tick
+	UpdateConversationSchedule();
+
+	if (SessionReplayer.IsValid())
+	{
+		SessionReplayer->Tick(*this);
+
+		if (SessionReplayer->IsFinished())
+		{
+			SessionReplayer->Report();
+			SessionReplayer->End();
+			SessionReplayer.Reset();
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+TStatId UYapSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UYapSubsystem, STATGROUP_Tickables);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void UYapSubsystem::OnTimerExpired(const FYapTimerPayload& Payload)
+{
+	switch (Payload.Event)
+	{
+		case EYapTimerEvent::SpeechComplete:
+		{
+			OnSpeechComplete(Payload.SpeechHandle, true, EYapSpeechCompleteResult::Normal);
+			break;
+		}
+		case EYapTimerEvent::PaddingComplete:
+		{
+			if (UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(Payload.Target.Get()))
+			{
+				DialogueNode->OnPaddingComplete(Payload.SpeechHandle);
+			}
+			break;
+		}
+		case EYapTimerEvent::SpeechCulled:
+		{
+			EmitSpeechResult(Payload.SpeechHandle, EYapSpeechCompleteResult::Culled);
+			break;
+		}
+		default:
+		{
+			checkNoEntry();
+		}
+	}
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -42,6 +42,44 @@ void FYapText::UpdateInternalWordCount()
 	WordCount = NewWordCount;
 }
 
+int32 FYapText::UpdateInternalWordCounts(TConstArrayView<FYapText*> Texts)
+{
+	TArray<FText> SourceTexts;
+	SourceTexts.Reserve(Texts.Num());
+
+	for (const FYapText* Text : Texts)
+	{
+		SourceTexts.Add(Text->Text);
+	}
+
+	TArray<int32> NewWordCounts;
+	NewWordCounts.SetNumZeroed(Texts.Num());
+	
+	const UYapBroker& Broker = UYapSubsystem::GetBroker_Editor();
+
+	Broker.CalculateWordCounts(SourceTexts, NewWordCounts);
+
+	int32 NumChanged = 0;
+	
+	for (int32 i = 0; i < Texts.Num(); ++i)
+	{
+		int32 NewWordCount = SourceTexts[i].IsEmptyOrWhitespace() ? 0 : NewWordCounts[i];
+		
+		if (NewWordCount < 0)
+		{
+			UE_LOG(LogYap, Error, TEXT("Could not calculate word count!"));
+		}
+
+		if (Texts[i]->WordCount != NewWordCount)
+		{
+			Texts[i]->WordCount = NewWordCount;
+			++NumChanged;
+		}
+	}
+
+	return NumChanged;
+}
+
 void FYapText::Clear()
 {
 	Text = FText::GetEmpty();
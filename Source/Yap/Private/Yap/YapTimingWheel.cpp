@@ -0,0 +1,183 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Yap/YapTimingWheel.h"
+
+#define LOCTEXT_NAMESPACE "Yap"
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapTimingWheel::Initialize(float InResolution, int32 InNumBuckets)
+{
+	check(InResolution > 0.0f);
+	check(InNumBuckets > 0);
+
+	Reset();
+
+	Resolution = InResolution;
+
+	Buckets.Init(INDEX_NONE, FMath::RoundUpToPowerOfTwo(InNumBuckets));
+}
+
+void FYapTimingWheel::Reset()
+{
+	Entries.Empty();
+	FreeEntries.Empty();
+	Expired.Empty();
+
+	for (int32& Head : Buckets)
+	{
+		Head = INDEX_NONE;
+	}
+
+	Remainder = 0.0;
+	CurrentTick = 0;
+	NumScheduled = 0;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapTimerHandle FYapTimingWheel::Schedule(float Delay, const FYapTimerPayload& Payload)
+{
+	check(Buckets.Num() > 0);
+
+	int32 EntryIndex;
+
+	if (FreeEntries.Num() > 0)
+	{
+		EntryIndex = FreeEntries.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		EntryIndex = Entries.AddDefaulted();
+	}
+
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Payload = Payload;
+	Entry.ExpireTick = CurrentTick + FMath::Max<int64>(1, FMath::CeilToInt64((Remainder + Delay) / Resolution));
+	Entry.bScheduled = true;
+
+	Link(EntryIndex);
+
+	++NumScheduled;
+
+	return FYapTimerHandle(EntryIndex, Entry.Generation);
+}
+
+bool FYapTimingWheel::Cancel(FYapTimerHandle& Handle)
+{
+	const FEntry* Entry = FindEntry(Handle);
+
+	const int32 EntryIndex = Handle.GetIndex();
+
+	Handle.Invalidate();
+
+	if (!Entry)
+	{
+		return false;
+	}
+
+	// Entries collected for firing during Advance are already unlinked
+	if (Entry->Bucket != INDEX_NONE)
+	{
+		Unlink(EntryIndex);
+	}
+
+	Release(EntryIndex);
+
+	return true;
+}
+
+bool FYapTimingWheel::IsScheduled(const FYapTimerHandle& Handle) const
+{
+	return FindEntry(Handle) != nullptr;
+}
+
+float FYapTimingWheel::GetTimeRemaining(const FYapTimerHandle& Handle) const
+{
+	const FEntry* Entry = FindEntry(Handle);
+
+	if (!Entry)
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(0.0f, static_cast<float>((Entry->ExpireTick - CurrentTick) * Resolution - Remainder));
+}
+
+// ------------------------------------------------------------------------------------------------
+
+const FYapTimingWheel::FEntry* FYapTimingWheel::FindEntry(const FYapTimerHandle& Handle) const
+{
+	if (!Entries.IsValidIndex(Handle.GetIndex()))
+	{
+		return nullptr;
+	}
+
+	const FEntry& Entry = Entries[Handle.GetIndex()];
+
+	if (!Entry.bScheduled || Entry.Generation != Handle.GetGeneration())
+	{
+		return nullptr;
+	}
+
+	return &Entry;
+}
+
+void FYapTimingWheel::Link(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+
+	const int32 Bucket = Entry.ExpireTick & (Buckets.Num() - 1);
+
+	Entry.Bucket = Bucket;
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Buckets[Bucket];
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = EntryIndex;
+	}
+
+	Buckets[Bucket] = EntryIndex;
+}
+
+void FYapTimingWheel::Unlink(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		Buckets[Entry.Bucket] = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+	Entry.Bucket = INDEX_NONE;
+}
+
+void FYapTimingWheel::Release(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+
+	Entry.Payload = FYapTimerPayload();
+	Entry.bScheduled = false;
+	++Entry.Generation;
+
+	--NumScheduled;
+
+	FreeEntries.Push(EntryIndex);
+}
+
+// ------------------------------------------------------------------------------------------------
+
+#undef LOCTEXT_NAMESPACE
@@ -20,6 +20,8 @@ class YAP_API UYapCondition_MaturitySetting : public UYapCondition
 public:
 	bool EvaluateCondition_Implementation() const override;
 
+	EYapMaturitySetting GetRequiredSetting() const { return RequiredSetting; }
+
 #if WITH_EDITOR
 	FLinearColor GetColor_Implementation() const override;
 	
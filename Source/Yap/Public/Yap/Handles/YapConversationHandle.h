@@ -20,6 +20,8 @@ struct YAP_API FYapConversationHandle
 {
     GENERATED_BODY()
 
+    friend struct FYap__ActiveSpeechMap;
+
     // ------------------------------------------
     // CONSTRUCTION
     // ------------------------------------------
@@ -39,6 +41,14 @@ private:
     UPROPERTY(Transient, meta = (IgnoreForMemberInitializationTest))
     FGuid Guid;
 
+    /** Slot in the subsystem's conversation table, stamped when the conversation is added. */
+    UPROPERTY(Transient)
+    int32 SlotIndex = INDEX_NONE;
+
+    /** Generation of the slot at the time this conversation was added; on a mismatch the subsystem falls back to finding the conversation by guid. */
+    UPROPERTY(Transient)
+    uint32 SlotGeneration = 0;
+
     // ------------------------------------------
     // API
     // ------------------------------------------
@@ -47,8 +57,12 @@ public:
     bool IsValid() const { return Guid.IsValid(); }
     
     const FGuid& GetGuid() const { return Guid; }
+
+    int32 GetSlotIndex() const { return SlotIndex; }
+
+    uint32 GetSlotGeneration() const { return SlotGeneration; }
     
-    void Invalidate() { Guid.Invalidate(); }
+    void Invalidate() { Guid.Invalidate(); SlotIndex = INDEX_NONE; SlotGeneration = 0; }
     
     bool operator== (const FYapConversationHandle& Other) const;
 
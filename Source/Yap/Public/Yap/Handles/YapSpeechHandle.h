@@ -15,6 +15,7 @@ enum class EYapSpeechCompleteResult : uint8
     Normal,
     Cancelled,
     Advanced,
+    Culled,
 };
 
 /**
@@ -26,6 +27,8 @@ struct YAP_API FYapSpeechHandle
 {
     GENERATED_BODY()
 
+    friend struct FYap__ActiveSpeechMap;
+
   //  friend class UYapSpeechHandleBFL;
     
     // ------------------------------------------
@@ -53,6 +56,14 @@ private:
 
     UPROPERTY(Transient)
     bool bActive = true;
+
+    /** Slot in the subsystem's active speech table, stamped when the speech is registered. Lets the subsystem find the speech without a guid lookup. */
+    UPROPERTY(Transient)
+    int32 SlotIndex = INDEX_NONE;
+
+    /** Generation of the slot at the time this speech was registered; a mismatch means the speech has already ended. */
+    UPROPERTY(Transient)
+    uint32 SlotGeneration = 0;
     
     // ------------------------------------------
     // API
@@ -63,6 +74,10 @@ public:
 
     const FGuid& GetGuid() const { return Guid; }
 
+    int32 GetSlotIndex() const { return SlotIndex; }
+
+    uint32 GetSlotGeneration() const { return SlotGeneration; }
+
     bool SkipDialogue();
 
     void Invalidate();
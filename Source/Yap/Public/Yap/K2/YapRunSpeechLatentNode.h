@@ -32,7 +32,7 @@ protected:
 	FYapSpeechHandle _Handle;
 	
 public:
-	/** Executed when the node is either succeeded OR advanced. */
+	/** Executed when the node is either succeeded OR advanced, or if the free speech budget culled the speech. */
 	UPROPERTY(BlueprintAssignable, DisplayName = "Finished")
 	FDelayOutputPin Finished;
 
@@ -87,4 +87,9 @@ protected:
 	static TArray<TSoftClassPtr<UObject>> StaticTest();
 	
 	void Activate() override;
+
+protected:
+	void OnSpeakerLoaded(TScriptInterface<IYapCharacterInterface> Speaker);
+
+	void StartSpeech();
 };
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Nodes/FlowNode.h"
+#include "Yap/YapConversation.h"
 
 #include "FlowNode_YapConversation_Open.generated.h"
 
@@ -14,6 +15,7 @@ UCLASS(NotBlueprintable, meta = (DisplayName = "Yap Conversation Start", Keyword
 class YAP_API UFlowNode_YapConversation_Open : public UFlowNode
 {
 	GENERATED_BODY()
+
 public:
 	UFlowNode_YapConversation_Open();
 	
@@ -26,6 +28,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Default")
 	FGameplayTag ConversationName;
 
+	/** How this conversation competes with other conversations. If the request times out, the Dropped output is triggered instead. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Default")
+	FYapConversationRequest Scheduling;
+
 	// ==========================================
 	// API
 	// ==========================================
@@ -33,11 +39,20 @@ public:
 
 	void ExecuteInput(const FName& PinName) override;
 
+	const FYapConversationRequest& GetScheduling() const { return Scheduling; }
+
+	void SetScheduling(const FYapConversationRequest& NewScheduling) { Scheduling = NewScheduling; }
+
 protected:
 	UFUNCTION()
 	void FinishNode(UObject* Instigator, FYapConversationHandle Handle);
 
 	void FinishNode_Internal();
+
+	UFUNCTION()
+	void OnDropped(UObject* Instigator, FYapConversationHandle Handle);
+
+	static FName DroppedPinName;
 	
 #if WITH_EDITOR
 public:
@@ -9,6 +9,7 @@
 #include "Yap/Handles/YapConversationHandle.h"
 #include "Yap/Handles/YapPromptHandle.h"
 #include "Yap/Handles/YapSpeechHandle.h"
+#include "Yap/YapTimingWheel.h"
 #include "Engine/TimerHandle.h"
 #include "FlowNode_YapDialogue.generated.h"
 
@@ -66,6 +67,90 @@ struct FYapFragmentRunData
 	FTimerHandle PaddingTimerHandle;
 };
 
+// ------------------------------------------------------------------------------------------------
+/**
+ * Runtime state of one fragment within one activation of a dialogue node.
+ */
+struct FYapDialogueFragmentRunState
+{
+	EYapFragmentRunState RunState = EYapFragmentRunState::Idle;
+
+	/** When did this activation start the fragment? Kept after the activation ends, for the editor's run highlights. */
+	double StartTime = -1.0;
+
+	/** When did this activation finish the fragment? Kept after the activation ends, for the editor's run highlights. */
+	double EndTime = -1.0;
+
+	bool bAwaitingManualAdvance = false;
+
+	/** How many times this activation ran the fragment. The fragment itself counts every activation for its activation limit. */
+	int32 Activations = 0;
+};
+
+// ------------------------------------------------------------------------------------------------
+/**
+ * Runtime state of one activation of a dialogue node. Talk nodes can be entered again while they are still running (e.g. the same bark node
+ * fired by a crowd of NPCs); every activation takes a context from the node's pool instead of each needing its own copy of the node.
+ */
+struct FYapDialogueNodeContext
+{
+	/** Slot of this context in the node's pool. */
+	int32 Index = INDEX_NONE;
+
+	/** Set from entering the node until it triggers an output. Fragments can keep running after that, e.g. speech past a negative padding. */
+	bool bActive = false;
+
+	bool bForceAdvanceOnSpeechComplete = false;
+
+	/** The focused fragment is done and waits for the conversation to be advanced. */
+	bool bAwaitingManualAdvance = false;
+
+	/** The conversation was preempted; this activation continues once it opens again. */
+	bool bWaitingForConversation = false;
+
+	/** Character loads this activation waits for before it runs its fragment or broadcasts its prompts. */
+	int32 PendingCharacterLoads = 0;
+
+	/** Tells the character load callbacks of this activation from those of an earlier one. */
+	uint32 CharacterLoadSerial = 0;
+
+	/** Set when the character loads finished, so the resumed fragment doesn't wait again for a character which failed to load. */
+	bool bCharactersLoaded = false;
+
+	/** Fragment to run when the activation resumes, or INDEX_NONE to broadcast prompts. */
+	int32 ResumeFragmentIndex = INDEX_NONE;
+
+	/** The most recent running fragment */
+	TOptional<uint8> FocusedFragmentIndex;
+
+	/** The most recent running speech handle */
+	FYapSpeechHandle FocusedSpeechHandle;
+
+	/** Conversation which the running fragments are part of, or None for free speech. */
+	FName InConversation;
+
+	/** Handle of the conversation above, so that advancing another conversation doesn't advance this activation. */
+	FYapConversationHandle ConversationHandle;
+
+	/** Per-fragment state of this activation, indexed like the node's fragments. */
+	TArray<FYapDialogueFragmentRunState> FragmentStates;
+
+	/** Fragment of each prompt broadcast by this activation. */
+	TMap<FYapPromptHandle, uint8> PromptIndices;
+
+	/** Fragments which are either speaking or in padding time will be in here */
+	TMap<FYapSpeechHandle, uint8> RunningFragments;
+
+	/** Fragments which are in active speech (including after passing a negative padding time) will be in here */
+	TSet<FYapSpeechHandle> SpeakingFragments;
+
+	/** Fragments waiting on their padding timer, with the timer. */
+	TMap<FYapSpeechHandle, FYapTimerHandle> FragmentsInPadding;
+
+	/** Clears the state for the next activation, keeping allocations. */
+	void Reset();
+};
+
 // TODO this class is utterly hilarious and needs to be busted out into separate smaller classes that handle each mode (Talk, Talk and Advance, Prompt ... and sequencing modes Run All, Select One, Select Random, etc)
 // I haven't figured out a great way to architect it yet since it's 2D. This class just kept growing. Spaghet!
 
@@ -85,6 +170,7 @@ class YAP_API UFlowNode_YapDialogue : public UFlowNode
 	friend class UFlowGraphNode_YapDialogue;
 #endif
 	friend struct FYapDialogueActiveSmartObject;
+	friend struct FYapFragmentLocation;
 
 	// TODO should I get rid of this?
 	friend class UYapSubsystem;
@@ -143,6 +229,10 @@ protected:
     UPROPERTY(EditAnywhere, Category = "Default")
 	TArray<FYapFragment> Fragments;
 
+	/** Times of every fragment for both maturity settings, baked when cooking (see GetFragmentTimes). Always empty in the editor, where fragments can change at any time. */
+	UPROPERTY()
+	TArray<FYapFragmentTimes> BakedFragmentTimes;
+
 	/** Whether the dialogue data of this bit can be edited. Dialogue should be locked after exporting a .PO file for translators to make it harder to accidentally edit source text. */
 	// Placeholder - not implemented yet
 	//UPROPERTY()
@@ -158,39 +248,23 @@ protected:
     UPROPERTY(Transient, BlueprintReadOnly, Category = "Default")
 	int32 NodeActivationCount = 0;
 
-	UPROPERTY(Transient)
-	bool bForceAdvanceOnSpeechComplete = false;
-	
-	/** The most recent running fragment */
-	UPROPERTY(Transient)
-	TOptional<uint8> FocusedFragmentIndex;
-
-	/** Flow doesn't give me a nice way to prevent entering this node twice. */
-	UPROPERTY(Transient)
-	bool bNodeActive = false;
-	
-	/**  */
-	UPROPERTY(Transient)
-	TMap<FYapPromptHandle, uint8> PromptIndices;
-
-	/** The most recent running speech handle */
-	UPROPERTY(Transient)
-	FYapSpeechHandle FocusedSpeechHandle;
+	/** Pool of activation contexts, see FYapDialogueNodeContext. Indirect, so contexts stay put when a re-entrant activation grows the pool. */
+	TIndirectArray<FYapDialogueNodeContext> Contexts;
 
-	/** Fragments which are either speaking or in padding time will be in here */
-	UPROPERTY(Transient)
-	TMap<FYapSpeechHandle, uint8> RunningFragments;
+	/** Pooled contexts which can be handed to the next activation. */
+	TArray<int32> FreeContexts;
 
-	/** Fragments which are in active speech (including after passing a negative padding time) will be in here */
-	UPROPERTY(Transient)
-	TSet<FYapSpeechHandle> SpeakingFragments;
+	/** Context of every running speech of this node. */
+	TMap<FYapSpeechHandle, int32> SpeechContexts;
 
-	/**  */
-	UPROPERTY(Transient)
-	TSet<FYapSpeechHandle> FragmentsInPadding;
+	/** Contexts which entered the node and have not triggered an output yet. */
+	int32 NumActiveContexts = 0;
 
 	UPROPERTY(Transient)
 	int32 LastRanFragment = INDEX_NONE;
+
+	/** Flattened, memoized form of Conditions. */
+	FYapConditionProgram ConditionProgram;
 	
 	// ============================================================================================
 	// PUBLIC API
@@ -235,10 +309,19 @@ public:
 	/**  */
 	bool GetFragmentAutoAdvance(uint8 FragmentIndex, bool bInConversation) const;
 
-	int32 GetRunningFragmentIndex() const { return FocusedFragmentIndex.Get(INDEX_NONE); }
+	/** Focused fragment of the first running activation, or INDEX_NONE. */
+	int32 GetRunningFragmentIndex() const;
+
+	/** How many activations of this node are running at once. */
+	int32 GetNumActiveInstances() const { return NumActiveContexts; }
+
+	/** State of the fragment in the activation which started it most recently, or null if no activation has started it. */
+	const FYapDialogueFragmentRunState* FindLatestFragmentRunState(uint8 FragmentIndex) const;
+
+	/** Is any activation of this node waiting on a manual advance from this fragment? */
+	bool IsFragmentAwaitingManualAdvance(uint8 FragmentIndex) const;
 	
-	// TODO this sucks can I register the fragments some other way instead
-	/** Finds the first fragment on this dialogue containing a tag. */
+	/** Finds the first fragment on this dialogue whose fragment ID is the tag's name. Use UYapSubsystem::FindTaggedFragment to search every running node. */
 	FYapFragment* FindTaggedFragment(const FGameplayTag& Tag);
 
 protected:
@@ -278,6 +361,9 @@ protected:
 	/** UFlowNodeBase override */
 	void InitializeInstance() override;
 
+	/** UFlowNodeBase override */
+	void DeinitializeInstance() override;
+
 	/** UFlowNodeBase override */
 	void ExecuteInput(const FName& PinName) override;
 
@@ -293,21 +379,44 @@ protected:
 
 	bool CheckConditions();
 
-	bool TryBroadcastPrompts();
+	/** Takes a context from the pool for a new activation. */
+	FYapDialogueNodeContext& AcquireContext();
+
+	/** Returns a context to the pool once it is neither active nor running any fragments. */
+	void TryReleaseContext(FYapDialogueNodeContext& Context);
 
-	void RunPrompt(uint8 Uint8);
+	FYapDialogueNodeContext* FindSpeechContext(const FYapSpeechHandle& Handle);
+
+	/** Counts a run of the fragment both for this activation and towards the fragment's activation limit. */
+	void IncrementActivations(FYapDialogueNodeContext& Context, uint8 FragmentIndex);
+
+	bool TryBroadcastPrompts(FYapDialogueNodeContext& Context);
+
+	void RunPrompt(FYapDialogueNodeContext& Context, uint8 FragmentIndex);
 	
-	bool TryStartFragments();
+	bool TryStartFragments(FYapDialogueNodeContext& Context);
 
-	bool RunFragment(uint8 FragmentIndex);
+	bool RunFragment(FYapDialogueNodeContext& Context, uint8 FragmentIndex);
 
-	void AddRunningFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+	/** If the flow's conversation was preempted, holds the activation until the conversation opens again. Returns true if it is held. */
+	bool WaitForSuspendedConversation(FYapDialogueNodeContext& Context, int32 FragmentIndex);
 
-	void RemoveRunningFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+	/** Starts async loads of the characters which the fragment (or every prompt, for INDEX_NONE) needs. Returns true if the activation is held until they are loaded. */
+	bool WaitForCharacters(FYapDialogueNodeContext& Context, int32 FragmentIndex);
 
-	void OnConversationSpeech(FName Name);
+	void OnCharacterLoaded(TScriptInterface<IYapCharacterInterface> Character, int32 ContextIndex, uint32 Serial);
 
-	FName InConversation;
+	/** Runs the fragment or broadcasts the prompts which a held activation was waiting to. */
+	void ResumeActivation(FYapDialogueNodeContext& Context);
+
+	/** Completes a fragment whose free speech was culled by the subsystem's free speech budget, without evaluating or broadcasting it. */
+	void RunCulledFragment(FYapDialogueNodeContext& Context, uint8 FragmentIndex);
+
+	void AddRunningFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+
+	void RemoveRunningFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+
+	void OnConversationSpeech(FName Name);
 	
 public:
 	/** This gets run by the subsystem when the actual speaking finishes */
@@ -319,14 +428,13 @@ public:
 	void OnPaddingComplete(FYapSpeechHandle Handle);
 
 	/** Called when a fragment is done running - speech is done AND padding is done */
-	UFUNCTION()
-	void FinishFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+	void FinishFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex);
 
 	/** This should be called whenever speech finishes OR padding finishes */
-	void TryAdvanceFromFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+	void TryAdvanceFromFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex);
 
 	/** Forcefully begins playing the next fragment or triggers the output node */
-	void AdvanceFromFragment(const FYapSpeechHandle& Handle, uint8 FragmentIndex);
+	void AdvanceFromFragment(FYapDialogueNodeContext& Context, const FYapSpeechHandle& Handle, uint8 FragmentIndex);
 	
 	bool IsBypassPinRequired() const;
 
@@ -361,8 +469,11 @@ protected:
 
 	UFUNCTION()
 	void OnAdvanceConversation(UObject* Instigator, FYapConversationHandle Handle);
+
+	UFUNCTION()
+	void OnConversationResumed(UObject* Instigator, FYapConversationHandle Handle);
 	
-	void FinishNode(FName OutputPinToTrigger);
+	void FinishNode(FYapDialogueNodeContext& Context, FName OutputPinToTrigger);
 
 	void SetActive();
 
@@ -377,6 +488,11 @@ public:
 #endif
 	
 	float GetPadding(uint8 FragmentIndex) const;
+
+	/** Speech, padding and progression time of a fragment for the current maturity setting. Cooked nodes read these from their baked table. */
+	FYapFragmentTimes GetFragmentTimes(uint8 FragmentIndex) const;
+
+	const TArray<FYapFragmentTimes>& GetBakedFragmentTimes() const { return BakedFragmentTimes; }
 	
 #if WITH_EDITOR
 public:
@@ -434,9 +550,18 @@ public:
 
 	void PreSave(FObjectPreSaveContext SaveContext) override;
 
+	/** Fills BakedFragmentTimes. Audio assets are loaded to read their durations. */
+	void BakeFragmentTimes();
+
+	/** Writes the dialogue database of the owning Flow asset next to it (see FYapDialogueDatabase). */
+	void CookAdditionalFilesOverride(const TCHAR* PackageFilename, const ITargetPlatform* TargetPlatform, TFunctionRef<void(const TCHAR* Filename, void* Data, int64 Size)> WriteAdditionalFile) override;
+
 	void FixNode(UEdGraphNode* NewGraphNode) override;
 	
 #endif // WITH_EDITOR
 	
 	void PreloadContent() override;
+
+	/** Issues async loads for the audio and characters of all fragments for the subsystem's look-ahead prefetcher. The handles go to OutHandles; the fragments keep their own from PreloadContent. */
+	void PrefetchContent(TAsyncLoadPriority Priority, TArray<TSharedPtr<FStreamableHandle>>& OutHandles);
 };
@@ -21,6 +21,10 @@ protected:
 
     UPROPERTY(EditAnywhere, Category = "Default")
 	FYapBitReplacement NewData;
+
+	/** Layer to put the replacement on. Higher layers win over lower ones. Only the RuntimeMod layer is cleared on map travel. */
+    UPROPERTY(EditAnywhere, Category = "Default")
+	EYapBitReplacementLayer Layer = EYapBitReplacementLayer::RuntimeMod;
 	
 public:
 	UFlowNode_YapReplaceFragment();
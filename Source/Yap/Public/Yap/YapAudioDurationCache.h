@@ -0,0 +1,54 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "UObject/SoftObjectPath.h"
+
+/**
+ * Durations of dialogue audio assets, so that reading a duration doesn't require loading the audio asset first.
+ *
+ * The cache file is written by the YapAudioDurations commandlet, which stores the hash of every audio package alongside its duration and only
+ * resolves durations again for packages whose content changed. In the editor, entries are dropped when their package is saved.
+ *
+ * To use the cache in packaged builds, add the folder containing the cache file (Content/Yap/Cache) to "Additional Non-Asset Directories To Package".
+ */
+class YAP_API FYapAudioDurationCache
+{
+public:
+	static FYapAudioDurationCache& Get();
+
+	/** Returns the cached duration of an audio asset, if there is one. */
+	TOptional<float> Find(const FSoftObjectPath& AudioAsset) const;
+
+	static FString GetFilename();
+
+#if WITH_EDITOR
+	/** Hash of the audio asset's package at the time its duration was resolved, or null if it isn't cached. */
+	const FString* FindHash(const FSoftObjectPath& AudioAsset) const;
+
+	void Set(const FSoftObjectPath& AudioAsset, float Duration, const FString& PackageHash);
+
+	/** Removes every entry which isn't in the given set. Returns the number of entries removed. */
+	int32 Prune(const TSet<FSoftObjectPath>& KeepAudioAssets);
+
+	/** Drops every entry of an audio package, e.g. because it was saved. */
+	void Invalidate(FName PackageName);
+
+	bool Save() const;
+#endif
+
+private:
+	void Load();
+
+	struct FEntry
+	{
+		float Duration = -1.0f;
+
+		FString PackageHash;
+	};
+
+	mutable FRWLock Lock;
+
+	TMap<FSoftObjectPath, FEntry> Entries;
+};
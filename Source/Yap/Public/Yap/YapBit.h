@@ -6,6 +6,7 @@
 #include "YapLog.h"
 #include "YapText.h"
 #include "Yap/Globals/YapEditorWarning.h"
+#include "Engine/StreamableManager.h"
 
 #include "YapBit.generated.h"
 
@@ -13,6 +14,7 @@ struct FStreamableHandle;
 class UFlowNode_YapDialogue;
 struct FYapBitReplacement;
 enum class EYapTimeMode : uint8;
+enum class EYapMaturitySetting : uint8;
 enum class EYapLoadContext : uint8;
 struct FGameplayTag;
 class UYapNodeConfig;
@@ -102,15 +104,27 @@ public:
 
 	bool HasAudioAsset() const;
 
+	/** Is a load of the audio asset requested by LoadContent still in flight? */
+	bool IsAudioAssetLoading() const;
+
+	/** Can the audio time be read without loading anything? True without audio, once the asset is loaded, or once its duration is cached. */
+	bool IsAudioTimeReady() const;
+
 	/** Getter for audio asset. This function will force a sync-load if the audio asset isn't loaded yet! */
 	template<class T>
 	const T* GetAudioAsset() const;
 
-	/** Loads the audio asset. */
-	void LoadContent(EYapLoadContext LoadContext) const;
+	/** Loads the audio asset. Priority only applies to async loads. FragmentID of the owning fragment only tags the profiler scope. */
+	void LoadContent(FName FragmentID, EYapLoadContext LoadContext, TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority) const;
+
+	/** Starts an async load of the audio asset and gives the handle to the caller, leaving AudioAssetHandle alone. Null if there is nothing to load. */
+	TSharedPtr<FStreamableHandle> PrefetchContent(TAsyncLoadPriority Priority) const;
 	
 	/** Gets the evaluated time duration to be used for this bit (incorporating project default settings and fallbacks) */
-	TOptional<float> GetSpeechTime(UWorld* World, EYapTimeMode TimeMode, EYapLoadContext LoadContext, const UYapNodeConfig& Config) const;
+	TOptional<float> GetSpeechTime(UWorld* World, EYapTimeMode TimeMode, EYapLoadContext LoadContext, const UYapNodeConfig& Config, FName FragmentID = NAME_None) const;
+
+	/** Overwrites the text, audio and manual time of this bit with the replacement's fields for the given maturity setting. */
+	void ApplyReplacement(const FYapBitReplacement& Replacement, EYapMaturitySetting MaturitySetting);
 
 	// --------------------------------------------------------------------------------------------
 	// INTERNAL API
@@ -124,7 +138,7 @@ protected:
 	TOptional<float> GetTextTime(const UYapNodeConfig& NodeConfig) const;
 
 	/** Gets the current time of the audio asset. */
-	TOptional<float> GetAudioTime(UObject* WorldContext, EYapLoadContext LoadContext) const;
+	TOptional<float> GetAudioTime(UObject* WorldContext, EYapLoadContext LoadContext, FName FragmentID = NAME_None) const;
 
 #if WITH_EDITOR
 	// --------------------------------------------------------------------------------------------
@@ -140,6 +154,19 @@ public:
 	
 	void SetManualTime(float NewValue) { ManualTime = NewValue; }
 
+	/** Collects pointers to this bit's texts, for batch processing. */
+	void GatherTexts(TArray<FYapText*>& OutTexts) { OutTexts.Add(&DialogueText); OutTexts.Add(&TitleText); }
+
+	const FString& GetDialogueLocalizationComments() const { return DialogueLocalizationComments; }
+
+	const FString& GetTitleTextLocalizationComments() const { return TitleTextLocalizationComments; }
+
+	const FString& GetStageDirections() const { return StageDirections; }
+
+	const TArray<FString>& GetPreviousMsgctxt() const { return PreviousMsgctxt; }
+
+	const TArray<FString>& GetPreviousMsgid() const { return PreviousMsgid; }
+
 private:
 	void RecalculateTextWordCount(FText& Text, float& CachedTime);
 
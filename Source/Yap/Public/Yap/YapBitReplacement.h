@@ -5,11 +5,24 @@
 
 #include "GameplayTagContainer.h"
 #include "Yap/YapBit.h"
+#include "Yap/YapFragment.h"
 #include "Yap/Enums/YapTimeMode.h"
 #include "YapBitReplacement.generated.h"
 
 class UObject;
 class UYapCharacterAsset;
+enum class EYapMaturitySetting : uint8;
+
+/** Layers of bit replacements. Where several layers replace the same field of a fragment, the highest layer wins. */
+UENUM(BlueprintType)
+enum class EYapBitReplacementLayer : uint8
+{
+	Base				UMETA(ToolTip = "Replacements shipped with the base game."),
+	DLC					UMETA(DisplayName = "DLC", ToolTip = "Replacements shipped with downloadable content."),
+	LocalizationPatch	UMETA(ToolTip = "Replacements shipped with localization patches."),
+	RuntimeMod			UMETA(ToolTip = "Replacements made at runtime, by mods or by the Replace Fragment node. Unlike the other layers, these are kept per world and cleared when the world ends."),
+	COUNT				UMETA(Hidden)
+};
 
 // TODO -- URGENT -- we need a details customization for FYapText. So that whenever you set the text, it caches the length.
 USTRUCT()
@@ -68,6 +81,12 @@ struct FYapBitReplacement
 	/**  */
 	UPROPERTY(EditAnywhere, Category = "Default")
 	TOptional<float> ManualTime = 0;
+
+	/** Overwrites every field which is set in Other. */
+	void Overlay(const FYapBitReplacement& Other);
+
+	/** Does this replace anything speech time is evaluated from (dialogue text, audio or manual time)? */
+	bool ChangesTimes() const;
 };
 
 inline FYapBitReplacement::FYapBitReplacement()
@@ -96,3 +115,67 @@ inline FYapBitReplacement::FYapBitReplacement()
 
 	ManualTime.Reset();
 }
+
+// ================================================================================================
+
+/**
+ * Stack of bit replacement layers, keyed by fragment ID. Whenever a layer changes, the affected fragments are resolved through every layer into
+ * one flat table, so playback only does a single lookup no matter how many layers there are. The replaced bit of a fragment is built from its
+ * original bit the first time it is played after a change.
+ *
+ * Layers can sit on top of a parent's, e.g. a world's runtime mods on top of the game instance's base, DLC and localization patch layers. The
+ * flat table then also holds everything the parent replaces, and the parent's owner has to pass on its changes with ResolveParentChanges.
+ */
+struct YAP_API FYapBitReplacementLayers
+{
+	void Set(EYapBitReplacementLayer Layer, FName FragmentID, const FYapBitReplacement& Replacement);
+
+	void Remove(EYapBitReplacementLayer Layer, FName FragmentID);
+
+	/** Replaces the whole contents of a layer, e.g. when a DLC is mounted. Returns the fragment IDs which were or are now on the layer. */
+	TSet<FName> SetLayer(EYapBitReplacementLayer Layer, TMap<FName, FYapBitReplacement>&& Replacements);
+
+	TSet<FName> ClearLayer(EYapBitReplacementLayer Layer) { return SetLayer(Layer, {}); }
+
+	/** Empties every layer. Keeps the parent, whose replacements stay resolved. */
+	void Reset();
+
+	/** Resolves the parent's replacements beneath this one's from now on. The parent must outlive this, or be unset first. */
+	void SetParent(const FYapBitReplacementLayers* InParent);
+
+	/** Re-resolves fragments whose replacement changed in the parent. */
+	void ResolveParentChanges(const TSet<FName>& FragmentIDs);
+
+	bool Contains(FName FragmentID) const { return Resolved.Contains(FragmentID); }
+
+	/** The bit to play instead of BaseBit, or nullptr if no layer replaces this fragment. */
+	const FYapBit* FindReplacementBit(FName FragmentID, EYapMaturitySetting MaturitySetting, const FYapBit& BaseBit) const;
+
+	/**
+	 * Times of a fragment whose replacement changes its text, audio or manual time, which baked times don't know about. Unset until the caller
+	 * evaluates and stores them; cleared whenever the replacement changes. Null if the fragment's baked times still hold.
+	 */
+	TOptional<FYapFragmentTimes>* FindReplacementTimes(FName FragmentID, EYapMaturitySetting MaturitySetting) const;
+
+private:
+	struct FResolvedReplacement
+	{
+		FYapBitReplacement Replacement;
+
+		/** Replaced mature and child-safe bits, built on first use. */
+		mutable TOptional<FYapBit> Bits[2];
+
+		/** Evaluated mature and child-safe times, see FindReplacementTimes. */
+		mutable TOptional<FYapFragmentTimes> Times[2];
+	};
+
+	/** Re-resolves one fragment through the parent and all layers. */
+	void Resolve(FName FragmentID);
+
+	const FYapBitReplacementLayers* Parent = nullptr;
+
+	TMap<FName, FYapBitReplacement> Layers[static_cast<uint8>(EYapBitReplacementLayer::COUNT)];
+
+	/** Boxed, so bits handed out by FindReplacementBit stay put when other fragments are resolved. */
+	TMap<FName, TUniquePtr<FResolvedReplacement>> Resolved;
+};
@@ -0,0 +1,51 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Yap/YapBitReplacement.h"
+
+#include "YapBitReplacementRegister.generated.h"
+
+class UYapSubsystem;
+
+/**
+ * Holds the Base, DLC and LocalizationPatch bit replacement layers for the whole game instance, so they survive map travel. Runtime mods stay
+ * on each world's Yap subsystem, which resolves them on top of these layers. Use the Yap subsystem's bit replacement functions rather than
+ * this directly; they pick the right place for the layer.
+ */
+UCLASS()
+class YAP_API UYapBitReplacementRegister : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+	friend class UYapSubsystem;
+
+public:
+	void Deinitialize() override;
+
+	const FYapBitReplacementLayers& GetBitReplacements() const { return BitReplacements; }
+
+	/** Is the layer kept here rather than per world? */
+	static bool IsPersistentLayer(EYapBitReplacementLayer Layer) { return Layer != EYapBitReplacementLayer::RuntimeMod; }
+
+protected:
+	void Set(EYapBitReplacementLayer Layer, FName FragmentID, const FYapBitReplacement& Replacement);
+
+	void Remove(EYapBitReplacementLayer Layer, FName FragmentID);
+
+	void SetLayer(EYapBitReplacementLayer Layer, TMap<FName, FYapBitReplacement>&& Replacements);
+
+	/** Resolves the world's runtime mods on top of this register's layers until the world's subsystem goes away. */
+	void AddWorldSubsystem(UYapSubsystem* Subsystem);
+
+	void RemoveWorldSubsystem(UYapSubsystem* Subsystem);
+
+	/** Passes changed fragments on to every world's layers. */
+	void ResolveInWorlds(const TSet<FName>& FragmentIDs);
+
+	FYapBitReplacementLayers BitReplacements;
+
+	TArray<TWeakObjectPtr<UYapSubsystem>> WorldSubsystems;
+};
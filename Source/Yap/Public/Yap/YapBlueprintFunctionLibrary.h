@@ -57,6 +57,34 @@ public:
 	/**  */
 	UFUNCTION(BlueprintCallable, Category = "Yap|Character", meta = (WorldContext = "WorldContext"))
 	static AActor* FindYapCharacterActor(UObject* WorldContext, FName CharacterID);
+
+	/** Actors of all registered characters within Radius of Center. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Character", meta = (WorldContext = "WorldContext"))
+	static TArray<AActor*> FindYapCharactersInRadius(UObject* WorldContext, FVector Center, float Radius);
+
+	/** Actors of all registered characters within Range of Origin and within HalfAngle degrees of Direction, e.g. what the player is looking at. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Character", meta = (WorldContext = "WorldContext"))
+	static TArray<AActor*> FindYapCharactersInCone(UObject* WorldContext, FVector Origin, FVector Direction, float HalfAngle, float Range);
+
+	/** Actors of up to Count registered characters nearest to Center, nearest first. A MaxRadius of zero places no limit on distance. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Character", meta = (WorldContext = "WorldContext"))
+	static TArray<AActor*> FindNearestYapCharacters(UObject* WorldContext, FVector Center, int32 Count = 1, float MaxRadius = 0.0f);
+
+	/** Dialogue conditions are only evaluated once per frame. Call this if game state read by your conditions changes and dialogue needs to see it within the same frame. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Conditions")
+	static void InvalidateConditions();
+
+	/** Starts recording every dialogue event of this world. Use this to capture a session for reproducing a bug or for benchmarking. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Debug", meta = (WorldContext = "WorldContext"))
+	static void StartSessionRecording(UObject* WorldContext);
+
+	/** Stops recording and writes the session to Saved/Yap/Sessions. Returns the written file, or an empty string if nothing was recorded. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Debug", meta = (WorldContext = "WorldContext"))
+	static FString StopSessionRecording(UObject* WorldContext);
+
+	/** Replays a recorded session from now on. Results are logged when the replay finishes. */
+	UFUNCTION(BlueprintCallable, Category = "Yap|Debug", meta = (WorldContext = "WorldContext"))
+	static bool ReplaySession(UObject* WorldContext, const FString& Filename);
 };
 
 
@@ -10,11 +10,28 @@
 #include "YapBroker.generated.h"
 
 enum class EYapMaturitySetting : uint8;
+class IBreakIterator;
 class UYapCharacterAsset;
 struct FYapPromptHandle;
 
 #define LOCTEXT_NAMESPACE "Yap"
 
+/** Which K2 overridables a broker class implements. Built once per broker instance, so calls don't have to search the class for script implementations every time. */
+struct FYapBrokerCapabilities
+{
+	bool bInitialize = false;
+	bool bGetMaturitySetting = false;
+	bool bGetPlaybackSpeed = false;
+	bool bCalculateWordCount = false;
+	bool bCalculateTextTime = false;
+	bool bGetAudioAssetDuration = false;
+#if WITH_EDITOR
+	bool bPreviewAudioAsset = false;
+#endif
+};
+
+// ================================================================================================
+
 /** Required class for brokering Yap to your game. Create a child class of this and implement the functions as needed. Then set Yap's project settings to use your class.
  *
  * Do ***NOT*** call Super or Parent function implementations when overriding any functions in this class. */
@@ -32,17 +49,16 @@ public:
 	// STATE DATA
 	// ================================================================================================
 private:
-	// These will be initialized during BeginPlay and keep track of whether there is a K2 function
-	// implementation to call, if the C++ implementation is not overridden. If the C++ implementation
-	// is overridden, it will supersede. This is "backwards" compared to normal BNE's but if you're
-	// overriding this class in C++ you won't want to override further in BP.
-	static TOptional<bool> bImplemented_Initialize;
-	static TOptional<bool> bImplemented_GetMaturitySetting;
-	static TOptional<bool> bImplemented_GetPlaybackSpeed;
-	static TOptional<bool> bImplemented_GetAudioAssetDuration;
-#if WITH_EDITOR
-	static TOptional<bool> bImplemented_PreviewAudioAsset;
-#endif
+	// This will be built during initialization (or on first use, for the CDO used by the editor) and keeps track of whether
+	// there is a K2 function implementation to call, if the C++ implementation is not overridden. If the C++ implementation
+	// is overridden, it will supersede. This is "backwards" compared to normal BNE's but if you're overriding this class in
+	// C++ you won't want to override further in BP. It is per-instance so that different broker classes never share it.
+	mutable TOptional<FYapBrokerCapabilities> Capabilities;
+
+	// Settings are read at most once per frame, unless the game notifies a change
+	mutable uint64 CachedSettingsFrame = MAX_uint64;
+	mutable EYapMaturitySetting CachedMaturitySetting {};
+	mutable float CachedPlaybackSpeed = 1.0f;
 	
 	// Some of these functions may be ran on tick by the editor or during play.
 	// We want to log errors, but not spam the log on tick, only on the first occurrence.
@@ -136,6 +152,11 @@ public:
 	 * Provides a word count estimate of a given piece of FText. A default implementation of this function exists. */
 	virtual int32 CalculateWordCount(const FText& Text) const;
 
+	/** OPTIONAL FUNCTION - Do NOT call Super when overriding.
+	 * Batch version of CalculateWordCount, used by cooking and by bulk recounts in the editor. The default implementation counts in parallel with one break iterator per worker,
+	 * or calls K2_CalculateWordCount for each text on the game thread if your Blueprint implements it. If you override CalculateWordCount in C++, override this too. */
+	virtual void CalculateWordCounts(TConstArrayView<FText> Texts, TArrayView<int32> OutWordCounts) const;
+
 	/** OPTIONAL FUNCTION - Do NOT call Super when overriding - rarely needed, overridable through C++ only.
 	 * Use this to read your game's settings (e.g. text playback speed) and determine the duration a dialogue should run for.
 	 * The default implementation of this function will use your project setting TextWordsPerMinute multiplied by GetPlaybackSpeed. */
@@ -163,6 +184,21 @@ private:
 	// ============================================================================================
 public:
 	void Initialize_Internal();
+
+	const FYapBrokerCapabilities& GetCapabilities() const;
+
+	/** Default word counting. Uses a line-break iterator to avoid counting the whitespace between the words. */
+	static int32 CountWords(const FString& String, IBreakIterator& LineBreakIterator);
+
+	/** Same as GetMaturitySetting, but only calls into the broker once per frame. */
+	EYapMaturitySetting GetMaturitySetting_Internal() const;
+
+	/** Same as GetPlaybackSpeed, but only calls into the broker once per frame. */
+	float GetPlaybackSpeed_Internal() const;
+
+	/** Call this when your game's maturity or playback speed settings change. Yap only reads them once per frame otherwise, so a change made mid-frame would not be seen until the next frame. */
+	UFUNCTION(BlueprintCallable, Category = "Yap")
+	void NotifySettingsChanged();
 	
 #if WITH_EDITOR
 public:
@@ -181,13 +217,11 @@ public:
 
 	// non-const variant
 	template<auto TFunction, typename ...TArgs>
-	auto CallK2Function(FString FunctionName, TOptional<bool>& bImplemented, bool& bWarned, bool bLogWarnings, TArgs&&... Args) -> typename TResolveFunctionReturn<decltype(TFunction), TArgs...>::Type
+	auto CallK2Function(FString FunctionName, bool bImplemented, bool& bWarned, bool bLogWarnings, TArgs&&... Args) -> typename TResolveFunctionReturn<decltype(TFunction), TArgs...>::Type
 	{
 		using TReturn = typename TResolveFunctionReturn<decltype(TFunction), TArgs...>::Type;
-		
-		check(bImplemented.IsSet());
 
-		if (bImplemented.GetValue())
+		if (bImplemented)
 		{
 			return (this->*TFunction)(std::forward<TArgs>(Args)...);
 		}
@@ -207,7 +241,7 @@ public:
 
 	// const variant, exactly the same. Just call the non-const variant.
 	template<auto TFunction, typename ...TArgs>
-	auto CallK2Function(FString FunctionName, TOptional<bool>& bImplemented, bool& bWarned, bool bLogWarnings, TArgs&&... Args) const -> typename TResolveFunctionReturn<decltype(TFunction), TArgs...>::Type
+	auto CallK2Function(FString FunctionName, bool bImplemented, bool& bWarned, bool bLogWarnings, TArgs&&... Args) const -> typename TResolveFunctionReturn<decltype(TFunction), TArgs...>::Type
 	{
 		return (const_cast<UYapBroker*>(this))->CallK2Function<TFunction, TArgs...>(FunctionName, bImplemented, bWarned, bLogWarnings, Args...);
 	}
@@ -0,0 +1,123 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "UObject/ObjectKey.h"
+
+class UYapCharacterComponent;
+
+// ================================================================================================
+
+/**
+ * Uniform 2D hash grid of the actors of registered character components, for proximity queries without visiting every character.
+ * Cells are square in XY and unbounded in Z; queries still test the full 3D distance. Locations are refreshed by Update, which only
+ * moves an entry between cells when it crossed a cell border.
+ */
+struct YAP_API FYapCharacterGrid
+{
+	void Initialize(float InCellSize);
+
+	void Reset();
+
+	void Add(UYapCharacterComponent* Component);
+
+	void Remove(const UYapCharacterComponent* Component);
+
+	/** Re-reads every character's location and drops characters which were destroyed without unregistering. */
+	void Update();
+
+	/** Characters within Radius of Center. */
+	void QueryRadius(const FVector& Center, float Radius, TArray<UYapCharacterComponent*>& OutComponents) const;
+
+	/** Characters within Range of Origin and within HalfAngleDegrees of Direction. */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float HalfAngleDegrees, float Range, TArray<UYapCharacterComponent*>& OutComponents) const;
+
+	/** Up to Count characters nearest to Center, nearest first. A MaxRadius of zero searches every character. */
+	void QueryNearest(const FVector& Center, int32 Count, float MaxRadius, TArray<UYapCharacterComponent*>& OutComponents) const;
+
+	/** Location of the character as of the last Update. */
+	const FVector* FindLocation(const UYapCharacterComponent* Component) const;
+
+	int32 Num() const { return ComponentToEntry.Num(); }
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UYapCharacterComponent> Component;
+
+		/** Kept so the lookup can be removed after the component is gone. */
+		TObjectKey<UYapCharacterComponent> Key;
+
+		FVector Location = FVector::ZeroVector;
+
+		FIntPoint Cell = FIntPoint::ZeroValue;
+
+		bool bUsed = false;
+	};
+
+	float CellSize = 2000.0f;
+
+	TArray<FEntry> Entries;
+
+	TArray<int32> FreeEntries;
+
+	TMap<TObjectKey<UYapCharacterComponent>, int32> ComponentToEntry;
+
+	/** Entries in each occupied cell. Empty cells are removed. */
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	FIntPoint GetCell(const FVector& Location) const;
+
+	void LinkToCell(int32 EntryIndex);
+
+	void UnlinkFromCell(int32 EntryIndex);
+
+	void RemoveEntry(int32 EntryIndex);
+
+	/** Calls Visit(EntryIndex) for every entry in cells overlapping the box of Center +- Extent in XY. */
+	template<typename TVisit>
+	void ForEachEntryInBox(const FVector& Center, float Extent, TVisit&& Visit) const;
+};
+
+// ------------------------------------------------------------------------------------------------
+
+template<typename TVisit>
+void FYapCharacterGrid::ForEachEntryInBox(const FVector& Center, float Extent, TVisit&& Visit) const
+{
+	const FIntPoint MinCell = GetCell(Center - FVector(Extent, Extent, 0.0));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Extent, Extent, 0.0));
+
+	// With few characters and a large box it's cheaper to test the occupied cells than to visit every cell in the box
+	const int64 NumBoxCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+
+	if (NumBoxCells > Cells.Num())
+	{
+		for (const TPair<FIntPoint, TArray<int32>>& Cell : Cells)
+		{
+			if (Cell.Key.X >= MinCell.X && Cell.Key.X <= MaxCell.X && Cell.Key.Y >= MinCell.Y && Cell.Key.Y <= MaxCell.Y)
+			{
+				for (int32 EntryIndex : Cell.Value)
+				{
+					Visit(EntryIndex);
+				}
+			}
+		}
+
+		return;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			if (const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y)))
+			{
+				for (int32 EntryIndex : *Cell)
+				{
+					Visit(EntryIndex);
+				}
+			}
+		}
+	}
+}
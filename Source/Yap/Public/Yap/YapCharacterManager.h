@@ -4,7 +4,10 @@
 #pragma once
 
 #include "Yap/YapLog.h"
+#include "Yap/Enums/YapLoadContext.h"
 #include "Interfaces/IYapCharacterInterface.h"
+#include "Containers/List.h"
+#include "Engine/StreamableManager.h"
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 5
 	#include "InstancedStruct.h"
@@ -19,6 +22,18 @@ class IYapCharacterInterface;
 struct FStreamableHandle;
 struct FYapCharacterRuntimeDefinition;
 
+/** Result of a non-blocking character lookup. */
+enum class EYapCharacterLoadState : uint8
+{
+	NotRegistered,
+	Pending, // An async load is in flight; the callback will be executed when it finishes
+	Loaded,
+};
+
+DECLARE_DELEGATE_OneParam(FYapOnCharacterLoaded, TScriptInterface<IYapCharacterInterface>);
+
+// ================================================================================================
+
 USTRUCT()
 struct FYapCharacterRegisteredInstance
 {
@@ -43,13 +58,33 @@ private:
 	UPROPERTY()
 	TObjectPtr<UObject> CharacterHardPtr;
 
+	/** Keeps a soft-registered character loaded while it is in the manager's residency list. */
+	UPROPERTY(Transient)
+	TObjectPtr<UObject> ResidentPtr;
+
+	/** This character's entry in the manager's residency list, or null if it isn't in it. */
+	TDoubleLinkedList<FName>::TDoubleLinkedListNode* ResidentNode = nullptr;
+
+	/** Load started by the manager itself, see UYapCharacterManager::FindCharacter. */
+	TSharedPtr<FStreamableHandle> PendingLoad;
+
+	TArray<FYapOnCharacterLoaded> PendingCallbacks;
+
+	friend class UYapCharacterManager;
+	
 public:
-	TSharedPtr<FStreamableHandle> RequestLoadAsync();
+	TSharedPtr<FStreamableHandle> RequestLoadAsync(TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority);
 
 	TSharedPtr<FStreamableHandle> RequestLoad();
 
-	// Used by speech functions; resolves the soft or hard ptr, whatever was set, loads and returns it
-	UObject* GetLoadedCharacter();
+	// Used by speech functions; resolves the soft or hard ptr, whatever was set, and returns it if it is in memory. Never loads.
+	UObject* GetLoadedCharacter() const;
+
+	// Sync-loads the character if it isn't in memory yet. This will hitch, only use it when the character is needed immediately.
+	UObject* LoadCharacterSync();
+
+	// Soft-registered characters are subject to the manager's residency limit, hard-registered ones are always resident
+	bool IsSoftRegistered() const { return !IsValid(CharacterHardPtr) && !CharacterSoftPtr.IsNull(); }
 
 	// Utility access for registration
 	UObject* GetHardPtr() const { return CharacterHardPtr; }
@@ -75,6 +110,9 @@ protected:
 	UPROPERTY()
 	TMap<FName, FYapCharacterRegisteredInstance> RegisteredCharacters;
 
+	/** Soft-registered characters which the manager is keeping loaded, least recently used first. Bounded by the project's character residency limit. Each instance holds its own node, so touching a character is O(1). */
+	TDoubleLinkedList<FName> ResidentCharacters;
+
 public:
 	void RegisterCharacter(FName CharacterID, const FYapCharacterRuntimeDefinition& CharacterDefinition, bool bReplaceExisting = false);
 
@@ -132,14 +170,37 @@ public:
 	void UnregisterCharacter(FName CharacterID);
 
 	/***
-	 * Use this function to locate a character asset for a character ID.
+	 * Use this function to locate a character asset for a character ID. Never blocks; if the character isn't in memory yet, an async load is started and OnLoaded is executed when it finishes.
+	 * 
+	 * @param CharacterID ID of the character to try and find
+	 * @param OutCharacter Set to the character if it is already loaded
+	 * @param OnLoaded Optional. Only executed if the result is Pending.
+	 */
+	EYapCharacterLoadState FindCharacter(FName CharacterID, TScriptInterface<IYapCharacterInterface>& OutCharacter, FYapOnCharacterLoaded OnLoaded = FYapOnCharacterLoaded());
+
+	/***
+	 * Use this function to locate a character asset for a character ID. By default this blocks to load a character which isn't in memory yet. Pass Async to start
+	 * an async load and get null back instead, or DoNotLoad to only return characters which are already loaded.
 	 * 
 	 * @param CharacterID ID of the character to try and find
+	 * @param LoadContext How to handle characters which aren't loaded
 	 */
-	TScriptInterface<IYapCharacterInterface> FindCharacter(FName CharacterID);
+	TScriptInterface<IYapCharacterInterface> FindCharacter(FName CharacterID, EYapLoadContext LoadContext = EYapLoadContext::Sync);
 
 	/** Initiates a load and gives back a handle. Caller is responsible to hold onto the handle while they're using the character. */
-	TSharedPtr<FStreamableHandle> RequestLoadAsync(FName CharacterID);
+	TSharedPtr<FStreamableHandle> RequestLoadAsync(FName CharacterID, TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority);
+
+protected:
+	/** Adds or replaces a registration. Callbacks waiting on a replaced character are handed the new one, once it is loaded if needed. */
+	void AddRegistration(FName CharacterID, FYapCharacterRegisteredInstance&& Instance);
+	
+	void OnCharacterLoaded(FName CharacterID);
+
+	/** Moves a soft-registered character to the back of the residency list, releasing the least recently used characters beyond the limit. */
+	void MarkResident(FName CharacterID, FYapCharacterRegisteredInstance& Instance);
+
+	/** Takes a character out of the residency list, e.g. before its registration is replaced or removed. */
+	void ReleaseResidency(FYapCharacterRegisteredInstance& Instance);
 };
 
 // ================================================================================================
@@ -0,0 +1,71 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+class UYapCondition;
+
+/** What a condition's result can depend on. Memoized results are discarded when one of their dependencies is invalidated. */
+enum class EYapConditionDependency : uint8
+{
+	None		= 0,
+	Maturity	= 1 << 0, // Invalidated by UYapBroker::NotifySettingsChanged
+	Game		= 1 << 1, // Anything a Blueprint or custom condition reads; invalidated by UYapBlueprintFunctionLibrary::InvalidateConditions
+};
+
+ENUM_CLASS_FLAGS(EYapConditionDependency);
+
+// ================================================================================================
+
+/**
+ * Flattened form of an array of conditions. Built-in conditions are evaluated with direct calls instead of going through their BlueprintNativeEvent,
+ * and the combined result is memoized for the rest of the frame, until one of its dependencies is invalidated. This keeps prompt menus and talk
+ * sequencing, which check the same conditions many times per frame, from paying the full cost every time.
+ * 
+ * The program recompiles itself whenever the condition array it is evaluated with has changed.
+ */
+struct YAP_API FYapConditionProgram
+{
+	/** Returns true if all conditions pass (AND evaluation). Null conditions are ignored. */
+	bool Evaluate(TConstArrayView<TObjectPtr<UYapCondition>> Conditions, const UObject* Owner) const;
+
+	/** Discards memoized results which depend on any of the given dependencies. */
+	static void Invalidate(EYapConditionDependency Dependencies);
+
+private:
+	enum class EOp : uint8
+	{
+		Skip,
+		MaturitySetting,
+		Script,
+	};
+
+	struct FOp
+	{
+		EOp Op = EOp::Skip;
+
+		UYapCondition* Condition = nullptr;
+	};
+
+	mutable TArray<FOp> Ops;
+
+	mutable EYapConditionDependency Dependencies = EYapConditionDependency::None;
+
+	mutable uint64 MemoFrame = MAX_uint64;
+
+	mutable uint32 MemoMaturityEpoch = 0;
+
+	mutable uint32 MemoGameEpoch = 0;
+	
+	mutable bool bMemoResult = false;
+
+	static uint32 MaturityEpoch;
+	
+	static uint32 GameEpoch;
+
+	bool IsCompiledFrom(TConstArrayView<TObjectPtr<UYapCondition>> Conditions) const;
+	
+	void Compile(TConstArrayView<TObjectPtr<UYapCondition>> Conditions, const UObject* Owner) const;
+
+	bool Run() const;
+};
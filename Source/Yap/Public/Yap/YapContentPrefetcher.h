@@ -0,0 +1,37 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+struct FStreamableHandle;
+class UFlowNode;
+class UFlowNode_YapDialogue;
+
+// ================================================================================================
+
+/**
+ * Walks the flow graph forward from a dialogue node which just started and issues async loads for the dialogue nodes found ahead of it.
+ * Nearer nodes are requested at a higher priority, but always below the default priority which nodes preload their own content with.
+ * Without this, taking a rarely used branch falls back on sync loads when its dialogue runs.
+ *
+ * The prefetcher keeps its own load handles, for the nodes found by the latest call only, so that it never replaces the handles which the
+ * nodes' fragments hold.
+ */
+class YAP_API FYapContentPrefetcher
+{
+public:
+	/** Prefetches content of dialogue nodes up to Depth connections ahead of StartNode. StartNode itself is skipped; it preloads on initialization. */
+	void PrefetchFrom(UFlowNode_YapDialogue* StartNode, int32 Depth);
+
+private:
+	// Scratch containers, kept around to avoid reallocating on every dialogue node
+	TArray<TPair<UFlowNode*, int32>> Frontier;
+
+	TSet<UFlowNode*> Visited;
+
+	/** Keeps the content of the nodes found by the latest call loaded. */
+	TArray<TSharedPtr<FStreamableHandle>> Handles;
+
+	/** Handles of the previous call, released only after the new loads are requested so that content still ahead isn't dropped in between. */
+	TArray<TSharedPtr<FStreamableHandle>> PreviousHandles;
+};
@@ -30,6 +30,31 @@ enum class EYapConversationState : uint8
 
 // ================================================================================================
 
+/** How a conversation competes with other conversations for its turn. Only one conversation is active at a time. */
+USTRUCT(BlueprintType)
+struct FYapConversationRequest
+{
+    GENERATED_BODY()
+
+    /** Higher priorities open first. Requests with the same priority open in the order they were made. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+    int32 Priority = 0;
+
+    /** If set, and this request has a higher priority than the active conversation, the active conversation is closed to make way for it. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+    bool bPreempt = false;
+
+    /** Seconds this request may wait for its turn before it is dropped. Zero waits forever. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default", meta = (ClampMin = 0, Units = "s"))
+    float Timeout = 0.0f;
+
+    /** If set, the request is only considered on the subsystem's next tick, so that every request made during a frame competes by priority rather than the first one opening immediately. */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Default")
+    bool bDeferred = false;
+};
+
+// ================================================================================================
+
 USTRUCT(BlueprintType)
 struct FYapConversation
 {
@@ -75,6 +100,10 @@ protected:
     UPROPERTY(Transient)
     bool bWantsToClose = false;
 
+    /** Preempted by another conversation and waiting to open again. */
+    UPROPERTY(Transient)
+    bool bSuspended = false;
+
     /** What created this conversation? Typically this is going to be a flow graph asset. */
     UPROPERTY(Transient)
     TObjectPtr<UObject> Owner;
@@ -92,6 +121,10 @@ public:
     UPROPERTY(Transient)
     FYapConversationEvent OnConversationClosed;
 
+    /** The conversation timed out while waiting for its turn and was removed without ever opening, or was preempted and is waiting for its turn again. */
+    UPROPERTY(Transient)
+    FYapConversationEvent OnConversationDropped;
+
     UPROPERTY(Transient)
     FYapPromptHandleChosen OnPromptHandleChosen;
     
@@ -115,6 +148,8 @@ public:
 
     const EYapConversationState GetState() const { return State; }
 
+    bool IsSuspended() const { return bSuspended; }
+
     const UObject* GetOwner() const { return Owner; }
     
     void AddRunningFragment(FYapSpeechHandle Handle);
@@ -137,6 +172,11 @@ public:
 
     void ReleaseClosingInterlock(UObject* Object);
 
+    // -----
+
+    /** Gives up the conversation's turn without closing it. It opens again through StartOpening. */
+    void Suspend();
+
     // -----
     
     void ExecuteSkip();
@@ -0,0 +1,207 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "GameplayTagContainer.h"
+#include "Yap/YapFragment.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UFlowAsset;
+class UFlowNode_YapDialogue;
+
+// ================================================================================================
+
+/**
+ * On-disk layout of a baked dialogue database. Everything is plain data and 4-byte aligned so that the blob can be used directly from a mapped file.
+ *
+ * [Header][Nodes][Fragments][AudioIDs][Strings]
+ *
+ * Strings are null-terminated UTF-8, referenced by their byte offset into the string section. Offset 0 is always the empty string.
+ */
+namespace YapDialogueDatabase
+{
+	static constexpr uint32 Magic = 0x44504159; // "YAPD"
+
+	static constexpr uint32 Version = 1;
+
+	static constexpr const TCHAR* Extension = TEXT(".yapdb");
+
+	struct FHeader
+	{
+		uint32 Magic;
+		uint32 Version;
+		uint32 NumNodes;
+		uint32 NumFragments;
+		uint32 NumAudioIDs;
+		uint32 NodesOffset;
+		uint32 FragmentsOffset;
+		uint32 AudioIDsOffset;
+		uint32 StringsOffset;
+		uint32 StringsSize;
+	};
+
+	/** Sorted by DialogueIDHash. */
+	struct FNode
+	{
+		uint32 DialogueIDHash;
+		uint32 DialogueID;
+		uint32 FirstFragment;
+		uint32 NumFragments;
+	};
+
+	struct FTextRef
+	{
+		uint32 Namespace;
+		uint32 Key;
+		uint32 Source;
+	};
+
+	struct FBit
+	{
+		FTextRef DialogueText;
+		FTextRef TitleText;
+		FYapFragmentTimes Times;
+	};
+
+	struct FFragment
+	{
+		uint32 AudioID;
+		uint32 SpeakerTag;
+		uint32 DirectedAtTag;
+		uint32 MoodTag;
+		uint32 Node;
+
+		/** Mature first, then child-safe. */
+		FBit Bits[2];
+	};
+
+	/** Sorted by AudioIDHash. */
+	struct FAudioID
+	{
+		uint32 AudioIDHash;
+		uint32 Fragment;
+	};
+
+	static_assert(sizeof(FFragment) % 4 == 0);
+
+	/** Case-insensitive, same as FName comparison. */
+	YAP_API uint32 HashName(FName Name);
+
+	/** Returns the database file which belongs to a Flow asset package. */
+	YAP_API FString GetFilename(const FString& PackageFilename);
+}
+
+// ================================================================================================
+
+/**
+ * Read-only, flattened copy of every dialogue node of one Flow asset: fragment text, speaker/directed-at/mood tags and baked times.
+ * The database is written next to the cooked Flow asset and mapped into memory at runtime (or loaded whole where mapping is not supported).
+ * Nodes are addressed by DialogueID and fragments by AudioID, without touching the Flow asset itself.
+ *
+ * Cooked nodes still carry their own fragment data, which conditions, replacements and editor tooling read, so the database is an index on
+ * top of the nodes and costs its size in memory rather than saving any. Where two nodes share a DialogueID, the one with the lower GUID wins.
+ */
+class YAP_API FYapDialogueDatabase
+{
+public:
+	struct FFragmentView
+	{
+		const YapDialogueDatabase::FFragment* Fragment = nullptr;
+
+		const FYapDialogueDatabase* Database = nullptr;
+
+		bool IsValid() const { return Fragment != nullptr; }
+
+		FName GetAudioID() const;
+
+		FName GetDialogueID() const;
+
+		FGameplayTag GetSpeakerTag() const;
+
+		FGameplayTag GetDirectedAtTag() const;
+
+		FGameplayTag GetMoodTag() const;
+
+		FText GetDialogueText(EYapMaturitySetting MaturitySetting) const;
+
+		FText GetTitleText(EYapMaturitySetting MaturitySetting) const;
+
+		const FYapFragmentTimes& GetTimes(EYapMaturitySetting MaturitySetting) const;
+
+	private:
+		const YapDialogueDatabase::FBit& GetBit(EYapMaturitySetting MaturitySetting) const;
+	};
+
+	FYapDialogueDatabase() = default;
+
+	~FYapDialogueDatabase();
+
+	FYapDialogueDatabase(const FYapDialogueDatabase&) = delete;
+
+	FYapDialogueDatabase& operator=(const FYapDialogueDatabase&) = delete;
+
+	/** Opens the database of a Flow asset or of the template of a running Flow asset instance. Returns null if it has none (e.g. in the editor, or if it was cooked without dialogue). */
+	static TSharedPtr<const FYapDialogueDatabase> Open(const UFlowAsset* FlowAsset);
+
+	/** The asset on disk which a running Flow asset instance was made from, or the asset itself if it isn't an instance. */
+	static const UFlowAsset* GetTemplateAsset(const UFlowAsset* FlowAsset);
+
+	/** Maps the file if the platform supports it, otherwise loads it. Returns null if the file is missing or invalid. */
+	static TSharedPtr<const FYapDialogueDatabase> OpenFile(const FString& Filename);
+
+	/** Returns the fragments of the node with this DialogueID, empty if not found. */
+	TArray<FFragmentView, TInlineAllocator<8>> FindNode(FName DialogueID) const;
+
+	FFragmentView FindFragment(FName DialogueID, uint8 FragmentIndex) const;
+
+	FFragmentView FindFragmentByAudioID(FName AudioID) const;
+
+	int32 NumNodes() const { return Header ? Header->NumNodes : 0; }
+
+	int32 NumFragments() const { return Header ? Header->NumFragments : 0; }
+
+	/** Size of the whole blob in bytes. */
+	int64 GetSize() const { return Size; }
+
+	bool IsMapped() const { return MappedRegion != nullptr; }
+
+#if WITH_EDITOR
+	/** Flattens every dialogue node of a Flow asset. Nodes should have their fragment times baked already (they are when cooking). */
+	static void Build(const UFlowAsset* FlowAsset, TArray<uint8>& OutData);
+#endif
+
+private:
+	bool Initialize(const uint8* InData, int64 InSize);
+
+	const YapDialogueDatabase::FNode* FindNodeRecord(FName DialogueID) const;
+
+	FUtf8StringView GetString(uint32 Offset) const;
+
+	FName GetName(uint32 Offset) const;
+
+	FGameplayTag GetTag(uint32 Offset) const;
+
+	FText GetText(const YapDialogueDatabase::FTextRef& Text) const;
+
+private:
+	const uint8* Data = nullptr;
+
+	int64 Size = 0;
+
+	const YapDialogueDatabase::FHeader* Header = nullptr;
+
+	TConstArrayView<YapDialogueDatabase::FNode> Nodes;
+
+	TConstArrayView<YapDialogueDatabase::FFragment> Fragments;
+
+	TConstArrayView<YapDialogueDatabase::FAudioID> AudioIDs;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	/** Used instead of the mapped file where mapping isn't supported. */
+	TArray<uint8> LoadedData;
+};
@@ -4,7 +4,8 @@
 #pragma once
 #include "YapBit.h"
 #include "GameplayTagContainer.h"
-#include "Engine/TimerHandle.h"
+#include "Yap/YapTimingWheel.h"
+#include "Yap/YapConditionProgram.h"
 #include "Runtime/Launch/Resources/Version.h"
 
 #if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 5
@@ -55,6 +56,28 @@ inline EYapFragmentEntryStateFlags operator|(EYapFragmentEntryStateFlags Left, E
 
 // ================================================================================================
 
+/** Evaluated timing of a fragment. Dialogue nodes bake one of these per fragment and maturity setting when cooking. */
+USTRUCT()
+struct YAP_API FYapFragmentTimes
+{
+	GENERATED_BODY()
+
+	/** Negative if the fragment has no speech time (time mode None). */
+	UPROPERTY()
+	float SpeechTime = -1.0f;
+
+	UPROPERTY()
+	float Padding = 0.0f;
+
+	/** Speech time plus padding, never negative. */
+	UPROPERTY()
+	float ProgressionTime = 0.0f;
+
+	TOptional<float> GetSpeechTime() const { return SpeechTime >= 0.0f ? TOptional<float>(SpeechTime) : NullOpt; }
+};
+
+// ================================================================================================
+
 /**
  * Fragments contain all of the actual data and settings required for a segment of speech to run.
  * 
@@ -169,33 +192,11 @@ protected:
 	UPROPERTY()
 	FFlowPin EndPin;
 
-	UPROPERTY(Transient)
-	EYapFragmentRunState RunState = EYapFragmentRunState::Idle;
-
 	UPROPERTY(Transient)
 	EYapFragmentEntryStateFlags LastEntryState = EYapFragmentEntryStateFlags::NeverRan;
 
-	/** When was the current running fragment started? */
-	UPROPERTY(Transient)
-	double StartTime = -1;
-
-	/** When did the most recently ran fragment finish? */
-	UPROPERTY(Transient)
-	double EndTime = -1;
-
-	/**  */
-	UPROPERTY(Transient)
-	bool bRunning = false;
-	
-	/**  */
-	UPROPERTY(Transient)
-	bool bFragmentAwaitingManualAdvance = false;
-	
-public:
-	
-	/**  */
-	UPROPERTY(Transient)
-	FTimerHandle PaddingTimerHandle;
+	/** Flattened, memoized form of Conditions. */
+	FYapConditionProgram ConditionProgram;
 	
 	// ASSET LOADING
 protected:
@@ -221,7 +222,10 @@ public:
 	
 	void ResetOptionalPins();
 	
-	void PreloadContent(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext);
+	void PreloadContent(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext, TAsyncLoadPriority Priority = FStreamableManager::DefaultAsyncLoadPriority);
+
+	/** Async-loads the same content as PreloadContent, but adds the handles to OutHandles instead of replacing the fragment's own. */
+	void PrefetchContent(UWorld* World, EYapMaturitySetting MaturitySetting, TAsyncLoadPriority Priority, TArray<TSharedPtr<FStreamableHandle>>& OutHandles) const;
 	
 	const FGameplayTag& GetSpeakerTag() const;
 	
@@ -246,10 +250,6 @@ public:
 	
 	int32 GetActivationCount() const { return ActivationCount; }
 
-	void SetRunState(EYapFragmentRunState NewState) { RunState = NewState; }
-	
-	EYapFragmentRunState GetRunState() const { return RunState; }
-
 	void SetEntryState(EYapFragmentEntryStateFlags NewStateFlags) { LastEntryState = (EYapFragmentEntryStateFlags)NewStateFlags; }
 	
 	EYapFragmentEntryStateFlags GetLastEntryState() const { return LastEntryState; }
@@ -280,20 +280,6 @@ public:
 
 	TOptional<float> GetSpeechTime(UWorld* World, const UYapNodeConfig& NodeConfig) const;
 
-	double GetStartTime() const { return StartTime; }
-
-	void SetStartTime(double InTime) { StartTime = InTime; }
-
-	double GetEndTime() const { return EndTime; }
-
-	void SetEndTime(double InTime) { EndTime = InTime; }
-
-	bool IsAwaitingManualAdvance() const;
-
-	void SetAwaitingManualAdvance();
-	
-	void ClearAwaitingManualAdvance();
-
 	TOptional<float> GetSpeechTime(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext, const UYapNodeConfig& NodeConfig) const;
 	
 public:
@@ -304,15 +290,15 @@ public:
 	bool GetUsesPadding(UWorld* World, const UYapNodeConfig& NodeConfig) const;
 
 	float GetProgressionTime(UWorld* World, const UYapNodeConfig& NodeConfig) const;
+
+	/** Evaluates speech, padding and progression time together, so that speech time (which may need the audio asset) is only evaluated once. */
+	FYapFragmentTimes EvaluateTimes(UWorld* World, EYapMaturitySetting MaturitySetting, EYapLoadContext LoadContext, const UYapNodeConfig& NodeConfig) const;
 	
 	void IncrementActivations();
 
 	const FName& GetFragmentID() const { return FragmentID; } 
 
 	const FName& GetAudioID() const { return AudioID; }
-	
-	// TODO - want to design a better system for this.
-	//void ReplaceBit(EYapMaturitySetting MaturitySetting, const FYapBitReplacement& ReplacementBit);
 
 	const FGuid& GetGuid() const { return Guid; }
 
@@ -399,5 +385,8 @@ public:
 	void SetSpeaker(const FGameplayTag& CharacterTag);
 	
 	void SetDirectedAt(const FGameplayTag& CharacterTag);
+
+	/** Collects pointers to the texts of both bits, for batch processing. */
+	void GatherTexts(TArray<FYapText*>& OutTexts) { MatureBit.GatherTexts(OutTexts); ChildSafeBit.GatherTexts(OutTexts); }
 #endif
 };
\ No newline at end of file
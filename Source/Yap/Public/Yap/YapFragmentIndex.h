@@ -0,0 +1,65 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "UObject/ObjectKey.h"
+
+class UFlowNode_YapDialogue;
+struct FYapFragment;
+
+/** Where a fragment with an ID lives. */
+struct FYapFragmentLocation
+{
+	TWeakObjectPtr<UFlowNode_YapDialogue> DialogueNode;
+
+	uint8 FragmentIndex = 0;
+
+	/** Resolves the fragment, or nullptr if its node is gone. */
+	FYapFragment* Get() const;
+};
+
+// ================================================================================================
+
+/**
+ * Finds fragments by their fragment ID without searching dialogue nodes. Nodes register their fragments when their Flow asset instance starts
+ * and unregister them when it ends. IDs are hierarchical like gameplay tags ("Quest.Intro.Greeting"), and every parent ("Quest", "Quest.Intro")
+ * keeps a list of the IDs below it, so looking up a single ID or everything under a parent is a single map lookup. Every running instance of a
+ * Flow asset registers its own copy of the node, so an ID can have one location per instance.
+ */
+struct YAP_API FYapFragmentIndex
+{
+	/** Adds every fragment of the node which has an ID. IDs already used by a different node are reported and ignored. */
+	void Register(UFlowNode_YapDialogue* DialogueNode);
+
+	/** Removes every fragment registered by the node. IDs stay registered while other instances of the node use them. */
+	void Unregister(const UFlowNode_YapDialogue* DialogueNode);
+
+	/** Location of the ID in the earliest registered instance still running. */
+	const FYapFragmentLocation* Find(FName FragmentID) const;
+
+	/** All fragments with the given ID or, if bIncludeChildren, an ID below it. */
+	void FindAll(FName FragmentID, bool bIncludeChildren, TArray<FYapFragmentLocation>& OutLocations) const;
+
+	int32 Num() const { return Locations.Num(); }
+
+	void Reset();
+
+private:
+	void AddToParents(FName FragmentID);
+
+	void RemoveFromParents(FName FragmentID);
+
+	/** Calls Visit(ParentID) for each parent of the ID, nearest last. */
+	template<typename TVisit>
+	static void ForEachParent(FName FragmentID, TVisit&& Visit);
+
+	/** Locations of each ID, one per registered node instance, in registration order. */
+	TMap<FName, TArray<FYapFragmentLocation, TInlineAllocator<1>>> Locations;
+
+	/** IDs registered below each parent ID. */
+	TMap<FName, TArray<FName>> Children;
+
+	/** IDs each node registered, so that unregistering doesn't need to read the node (its fragments may be gone already). */
+	TMap<TObjectKey<UFlowNode_YapDialogue>, TArray<FName>> NodeFragmentIDs;
+};
@@ -13,4 +13,9 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+#if WITH_EDITOR
+private:
+	FDelegateHandle PackageSavedHandle;
+#endif
 };
@@ -0,0 +1,29 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Yap/YapBroker.h"
+
+#include "YapNullAudioBroker.generated.h"
+
+/**
+ * Broker which reads audio durations straight from asset properties, without going through any audio engine or middleware.
+ * Used by the YapAudioDurations commandlet with -NullAudio, e.g. on headless build machines which have no audio device.
+ */
+UCLASS(NotBlueprintable)
+class YAP_API UYapNullAudioBroker : public UYapBroker
+{
+	GENERATED_BODY()
+
+public:
+	UYapNullAudioBroker();
+
+protected:
+	/** Float or double properties which hold the duration of non-USoundBase audio assets, tried in order. */
+	UPROPERTY(EditDefaultsOnly, Category = "Default")
+	TArray<FName> DurationPropertyNames;
+
+public:
+	float GetAudioAssetDuration(const UObject* AudioAsset) const override;
+};
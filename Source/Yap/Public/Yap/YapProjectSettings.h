@@ -65,6 +65,36 @@ protected:
 	UPROPERTY(Config, EditAnywhere, Category = "Core")
 	TSoftObjectPtr<UYapNodeConfig> DefaultNodeConfig;
 	
+	// - - - - - RUNTIME - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	/** When a dialogue node starts, Yap walks this many connections forward through the flow graph and starts async loading audio and characters of the dialogue nodes it finds. Set to 0 to disable. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime", meta = (ClampMin = 0, UIMax = 8))
+	int32 PrefetchLookAheadDepth = 3;
+
+	/** How many characters registered by soft reference (e.g. from the character list below) the character manager keeps loaded. The least recently used ones are released first. Releasing a character does not unload it while anything else still references it. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime", meta = (ClampMin = 1, UIMin = 4, UIMax = 128))
+	int32 CharacterResidencyLimit = 32;
+
+	/** Records every dialogue event of each game world to Saved/Yap/Sessions, for reproducing timing bugs and benchmarking (see FYapSessionRecorder). Cheap enough to leave on in QA builds. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime")
+	bool bRecordSessions = false;
+
+	/** Most free speech (barks) which may run at once. Free speech over the budget is culled: it completes immediately without reaching handlers. Set to 0 for no limit. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime", meta = (ClampMin = 0, UIMax = 64))
+	int32 FreeSpeechBudget = 0;
+
+	/** Seconds a speaker must wait after starting free speech before their next free speech isn't culled. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime", meta = (ClampMin = 0, Units = "s"))
+	float FreeSpeechSpeakerCooldown = 0.0f;
+
+	/** Free speech from speakers further than this from the local player's camera is culled. Speakers without a known location are never culled by distance. Set to 0 to disable. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime", meta = (ClampMin = 0, Units = "cm"))
+	float FreeSpeechCullDistance = 0.0f;
+
+	/** Size of the cells of the grid which registered characters are sorted into for proximity queries (see FYapCharacterGrid). Roughly the radius of your typical query works well. */
+	UPROPERTY(Config, EditAnywhere, Category = "Runtime", meta = (ClampMin = 100, Units = "cm"))
+	float CharacterGridCellSize = 2000.0f;
+	
 	// - - - - - EDITOR - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 	
 	/** Normally, when assigning dialogue text, Yap will parse the text and attempt to cache a word count to use for determine text time length. Set this to prevent that. */
@@ -164,6 +194,20 @@ public:
 	
 	static bool HasCustomAudioAssetClasses() { return Get().AudioAssetClasses.Num() > 0; };
 
+	static int32 GetPrefetchLookAheadDepth() { return Get().PrefetchLookAheadDepth; }
+
+	static int32 GetCharacterResidencyLimit() { return Get().CharacterResidencyLimit; }
+
+	static bool GetRecordSessions() { return Get().bRecordSessions; }
+
+	static int32 GetFreeSpeechBudget() { return Get().FreeSpeechBudget; }
+
+	static float GetFreeSpeechSpeakerCooldown() { return Get().FreeSpeechSpeakerCooldown; }
+
+	static float GetFreeSpeechCullDistance() { return Get().FreeSpeechCullDistance; }
+
+	static float GetCharacterGridCellSize() { return Get().CharacterGridCellSize; }
+
 	static bool CacheFragmentWordCountAutomatically() { return !Get().bPreventCachingWordCount; }
 	
 	static bool CacheFragmentAudioLengthAutomatically() { return !Get().bPreventCachingAudioLength; }
@@ -171,6 +215,19 @@ public:
 	static const TSoftObjectPtr<UTexture2D> GetDefaultPortraitTextureAsset() { return Get().DefaultPortraitTexture; };
 
 #if WITH_EDITOR
+	/** Settings which tests and benchmarks replace for a run. */
+	struct FTestOverrides
+	{
+		TSoftClassPtr<UYapBroker> BrokerClass;
+
+		TSoftObjectPtr<UYapNodeConfig> DefaultNodeConfig;
+
+		int32 FreeSpeechBudget = 0;
+	};
+
+	/** Replaces the settings in memory only, never saved. Returns the settings it replaced; apply those to restore them. */
+	static FTestOverrides ApplyTestOverrides(const FTestOverrides& Overrides);
+	
 	static const UObject* FindCharacter(FGameplayTag CharacterTag, TSharedPtr<FStreamableHandle>& Handle, EYapLoadContext LoadContext);
 #endif
 	
@@ -0,0 +1,179 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Yap/Handles/YapConversationHandle.h"
+#include "Yap/Handles/YapPromptHandle.h"
+#include "Yap/Handles/YapSpeechHandle.h"
+
+class UYapSubsystem;
+
+/** Events captured by the session recorder. Inputs are what the game asked Yap to do; everything else is Yap's response to them. */
+enum class EYapSessionEvent : uint8
+{
+	// Outputs
+	SpeechBegins,
+	SpeechResult,
+	PromptBroadcast,
+	ConversationOpened,
+	ConversationClosed,
+
+	// Inputs
+	SpeechEnded,
+	PromptChosen,
+	ConversationAdvanced,
+};
+
+/** One recorded event. Fixed size, so a session is written as a raw array. */
+struct FYapSessionRecord
+{
+	/** Seconds since the recording started, in world time. */
+	double Time = 0.0;
+
+	/** Guid of the speech, prompt or conversation handle the event is about. */
+	FGuid Handle;
+
+	/** Position of the subsystem's noise generator when the event happened. */
+	int32 NoisePosition = 0;
+
+	EYapSessionEvent Event = EYapSessionEvent::SpeechBegins;
+
+	/** EYapSpeechCompleteResult of SpeechEnded and SpeechResult events. */
+	EYapSpeechCompleteResult Result = EYapSpeechCompleteResult::Undefined;
+
+	bool IsInput() const { return Event >= EYapSessionEvent::SpeechEnded; }
+};
+
+// ================================================================================================
+
+/**
+ * Captures every subsystem event with its world time and noise generator position. Recording only appends a small fixed-size record to an array,
+ * so it can stay enabled in QA builds (see UYapProjectSettings::bRecordSessions). Sessions are written when recording stops.
+ */
+class YAP_API FYapSessionRecorder
+{
+public:
+	void Start(const UYapSubsystem& Subsystem);
+
+	/** Writes the recorded session. Returns false if nothing was recorded or the file could not be written. */
+	bool Stop(const FString& Filename);
+
+	bool IsRecording() const { return bRecording; }
+
+	FORCEINLINE void Record(const UYapSubsystem& Subsystem, EYapSessionEvent Event, const FGuid& Handle, EYapSpeechCompleteResult Result = EYapSpeechCompleteResult::Undefined)
+	{
+		if (bRecording)
+		{
+			Record_Internal(Subsystem, Event, Handle, Result);
+		}
+	}
+
+	/** Saved/Yap/Sessions/<World>_<Date>.yapsession */
+	static FString MakeFilename(const UWorld* World);
+
+private:
+	void Record_Internal(const UYapSubsystem& Subsystem, EYapSessionEvent Event, const FGuid& Handle, EYapSpeechCompleteResult Result);
+
+	bool bRecording = false;
+
+	double StartTime = 0.0;
+
+	uint32 GlobalSeed = 0;
+
+	int32 StartNoisePosition = 0;
+
+	TArray<FYapSessionRecord> Records;
+};
+
+// ================================================================================================
+
+/**
+ * Drives the subsystem from a recorded session: restores the recorded noise seed and position, issues the recorded inputs at their recorded times,
+ * and compares every output Yap produces against the recording. Handles are matched up by the order outputs happen in, so recorded inputs can be
+ * sent to the live handles they correspond to. The game should not send its own dialogue inputs while a session replays.
+ *
+ * Only inputs are replayed. Speech and conversations which the game started itself (UYapSubsystem::RunSpeech or OpenConversation called from game
+ * code rather than a dialogue flow) are recorded as outputs, but their data is not, so the game has to start them again at the same times for the
+ * replay to match.
+ *
+ * The replay ends at the first divergence: an output which doesn't match, an input whose handle never appeared, or an expected output which is
+ * more than MaxOutputDelay late.
+ */
+class YAP_API FYapSessionReplayer
+{
+public:
+	/** Restores the global noise seed if the replay didn't finish. */
+	~FYapSessionReplayer();
+
+	bool Load(const FString& Filename);
+
+	/** Swaps in the recorded global noise seed; the previous seed is restored by End. */
+	void Begin(UYapSubsystem& Subsystem);
+
+	void End();
+
+	/** Issues every input which is due, and gives up on outputs which are too late. */
+	void Tick(UYapSubsystem& Subsystem);
+
+	void OnOutput(const UYapSubsystem& Subsystem, EYapSessionEvent Event, const FGuid& Handle, EYapSpeechCompleteResult Result);
+
+	void RegisterLiveHandle(const FYapSpeechHandle& Handle) { LiveSpeechHandles.Add(Handle.GetGuid(), Handle); }
+
+	void RegisterLiveHandle(const FYapPromptHandle& Handle) { LivePromptHandles.Add(Handle.GetGuid(), Handle); }
+
+	void RegisterLiveHandle(const FYapConversationHandle& Handle) { LiveConversationHandles.Add(Handle.GetGuid(), Handle); }
+
+	/** Finished once every recorded event happened, or as soon as the replay diverged. */
+	bool IsFinished() const { return bDiverged || (NextInput >= Records.Num() && NextOutput >= Records.Num()); }
+
+	/** Logs how closely the replay followed the recording, and where it diverged. Returns true if every output matched. */
+	bool Report() const;
+
+private:
+	const FGuid* FindLiveGuid(const FGuid& RecordedGuid) const { return RecordedToLive.Find(RecordedGuid); }
+
+	void AdvanceCursor(int32& Cursor, bool bInputs) const;
+
+	void Diverge(double Now, const FString& Description);
+
+	/** How long past its recorded time an output may be before the replay counts as diverged. */
+	static constexpr double MaxOutputDelay = 5.0;
+
+	TArray<FYapSessionRecord> Records;
+
+	uint32 GlobalSeed = 0;
+
+	/** The game's own global seed, while the recorded one is in use. */
+	TOptional<uint32> PreviousGlobalSeed;
+
+	int32 StartNoisePosition = 0;
+
+	double StartTime = 0.0;
+
+	int32 NextInput = 0;
+
+	int32 NextOutput = 0;
+
+	TMap<FGuid, FGuid> RecordedToLive;
+
+	TMap<FGuid, FYapSpeechHandle> LiveSpeechHandles;
+
+	TMap<FGuid, FYapPromptHandle> LivePromptHandles;
+
+	TMap<FGuid, FYapConversationHandle> LiveConversationHandles;
+
+	int32 NumMatched = 0;
+
+	int32 NumMismatched = 0;
+
+	int32 NumNoisePositionMismatches = 0;
+
+	int32 NumUnresolvedInputs = 0;
+
+	double MaxTimeError = 0.0;
+
+	FString FirstMismatch;
+
+	bool bDiverged = false;
+};
@@ -94,6 +94,31 @@ namespace YapSquirrel
 	 * Example: Value = 3.25 has a 25% chance to return 4 and a 75% chance to return 3.
 	 */
 	[[nodiscard]] constexpr int32 RoundWithWeightByFraction(FYapSquirrelState& State, double Value);
+
+	/**
+	 * Batched generation. Every function below produces exactly the values the matching one-at-a-time function would, in the same order, and
+	 * advances the state by the number of values produced, so mixing batched and single calls on one stream stays deterministic.
+	 * The hashing runs four positions per vector instruction.
+	 */
+
+	/** Fills Out with the raw SquirrelNoise5 values at Position, Position + 1, ... Stateless, so disjoint ranges can be filled from any thread. */
+	YAP_API void GenerateUint32(int32 Position, uint32 Seed, TArrayView<uint32> Out);
+
+	/** Reserves Count consecutive positions on the stream and returns the first one. Fill them later with GenerateUint32 or GenerateReal. */
+	YAP_API int32 ReservePositions(FYapSquirrelState& State, int32 Count);
+
+	/** Fills Out with values in [0, 1] at Position, Position + 1, ... Stateless, like GenerateUint32. */
+	YAP_API void GenerateReal(int32 Position, uint32 Seed, TArrayView<double> Out);
+
+	YAP_API void NextUint32Batch(FYapSquirrelState& State, TArrayView<uint32> Out);
+
+	YAP_API void NextRealBatch(FYapSquirrelState& State, TArrayView<double> Out);
+
+	/** Same as calling NextInt32(State, Max) once per element. */
+	YAP_API void NextInt32Batch(FYapSquirrelState& State, const int32 Max, TArrayView<int32> Out);
+
+	/** Same as calling RollChance(State, Roll, Chances[i], RollModifier) once per element: chances are percentages, and Out[i] is true when the roll meets or exceeds Chances[i]. Returns how many succeeded. */
+	YAP_API int32 RollChanceBatch(FYapSquirrelState& State, TConstArrayView<double> Chances, const double RollModifier, TArrayView<bool> Out);
 }
 
 /**
@@ -148,6 +173,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Squirrel")
 	int32 RoundWithWeightByFraction(double Value);
 
+	/** Generates Count values at once; identical to calling NextReal Count times. */
+	UFUNCTION(BlueprintCallable, Category = "Squirrel")
+	void NextRealBatch(int32 Count, TArray<double>& Values);
+
+	/** Rolls one value per chance at once. Identical to calling RollChance for each chance in order, so chances are percentages which the roll must meet or exceed. Returns how many succeeded. */
+	UFUNCTION(BlueprintCallable, Category = "Squirrel")
+	int32 RollChanceBatch(const TArray<double>& Chances, const double RollModifier, TArray<bool>& Results);
+
+	/** Reserves Count consecutive positions on this stream and returns the first one, so the values can be generated later or on another thread with YapSquirrel::GenerateReal. */
+	UFUNCTION(BlueprintCallable, Category = "Squirrel")
+	int32 ReservePositions(int32 Count);
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Squirrel")
 	FYapSquirrelState State;
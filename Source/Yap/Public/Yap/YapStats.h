@@ -0,0 +1,68 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+
+// ------------------------------------------------------------------------------------------------
+// "stat Yap"
+
+DECLARE_STATS_GROUP(TEXT("Yap"), STATGROUP_Yap, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Fire Speech/Padding Timers"), STAT_YapFireTimers, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Speech"), STAT_YapRunSpeech, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast To Handlers"), STAT_YapBroadcastEvent, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Advance Conversation"), STAT_YapAdvanceConversation, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Run Fragment"), STAT_YapRunFragment, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Broadcast Prompts"), STAT_YapBroadcastPrompts, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Get Speech Time"), STAT_YapGetSpeechTime, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Load Bit Content"), STAT_YapLoadContent, STATGROUP_Yap, YAP_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Character"), STAT_YapFindCharacter, STATGROUP_Yap, YAP_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scheduled Timers"), STAT_YapScheduledTimers, STATGROUP_Yap, YAP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sync Loads"), STAT_YapSyncLoads, STATGROUP_Yap, YAP_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Culled Free Speech"), STAT_YapCulledFreeSpeech, STATGROUP_Yap, YAP_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Dialogue Databases"), STAT_YapDialogueDatabaseMemory, STATGROUP_Yap, YAP_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Session Recording"), STAT_YapSessionRecordingMemory, STATGROUP_Yap, YAP_API);
+
+// ------------------------------------------------------------------------------------------------
+// Low-level memory tracker; run with -llm and read the "Yap" tag
+
+LLM_DECLARE_TAG_API(Yap, YAP_API);
+
+// ------------------------------------------------------------------------------------------------
+// Unreal Insights; enable with -trace=default,Yap
+
+UE_TRACE_CHANNEL_EXTERN(YapChannel, YAP_API);
+
+#if CPUPROFILERTRACE_ENABLED
+/** Insights scope on the Yap channel, named "Name [DialogueID | Speaker]". The tags are only evaluated while the channel is enabled. */
+#define YAP_TRACE_SCOPE(Name, DialogueID, Speaker) \
+	const FString YapTraceScopeName = UE_TRACE_CHANNELEXPR_IS_ENABLED(YapChannel) ? FString::Printf(TEXT("%s [%s | %s]"), TEXT(Name), *(DialogueID).ToString(), *(Speaker).ToString()) : FString(); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*YapTraceScopeName, YapChannel)
+
+/** Same as YAP_TRACE_SCOPE, named "Name [DialogueID | Speaker | Asset]". Asset is an FString expression. */
+#define YAP_TRACE_SCOPE_ASSET(Name, DialogueID, Speaker, Asset) \
+	const FString YapTraceScopeName = UE_TRACE_CHANNELEXPR_IS_ENABLED(YapChannel) ? FString::Printf(TEXT("%s [%s | %s | %s]"), TEXT(Name), *(DialogueID).ToString(), *(Speaker).ToString(), *(Asset)) : FString(); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*YapTraceScopeName, YapChannel)
+#else
+#define YAP_TRACE_SCOPE(Name, DialogueID, Speaker)
+#define YAP_TRACE_SCOPE_ASSET(Name, DialogueID, Speaker, Asset)
+#endif
+
+/** Cycle counter, LLM tag and tagged Insights scope. */
+#define YAP_SCOPE(Stat, Name, DialogueID, Speaker) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	LLM_SCOPE_BYTAG(Yap); \
+	YAP_TRACE_SCOPE(Name, DialogueID, Speaker)
+
+/** YAP_SCOPE with the asset being worked on as a separate tag. */
+#define YAP_SCOPE_ASSET(Stat, Name, DialogueID, Speaker, Asset) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	LLM_SCOPE_BYTAG(Yap); \
+	YAP_TRACE_SCOPE_ASSET(Name, DialogueID, Speaker, Asset)
@@ -11,9 +11,14 @@
 #include "Enums/YapMaturitySetting.h"
 #include "Yap/YapRunningFragment.h"
 #include "Yap/YapBitReplacement.h"
+#include "Yap/YapCharacterGrid.h"
+#include "Yap/YapFragmentIndex.h"
 #include "Yap/YapDataStructures.h"
+#include "Yap/YapTimingWheel.h"
+#include "Yap/YapContentPrefetcher.h"
+#include "Yap/YapSessionRecorder.h"
+#include "Yap/YapStats.h"
 #include "Subsystems/WorldSubsystem.h"
-#include "Engine/TimerHandle.h"
 #include "Engine/World.h"
 #include "UObject/ObjectKey.h"
 
@@ -22,11 +27,14 @@
 class UYapCharacterManager;
 class UYapConversationHandler;
 class UYapBroker;
+class UYapBitReplacementRegister;
 struct FYapPromptHandle;
 class IYapConversationHandler;
 struct FYapBit;
 class UYapCharacterComponent;
 class UYapSquirrel;
+class FYapDialogueDatabase;
+class UFlowAsset;
 enum class EYapMaturitySetting : uint8;
 
 UDELEGATE()
@@ -67,6 +75,40 @@ struct FYapHandlersArray
 
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UObject>> Array;
+
+	/** Parallel to Array. Native interface address of each handler, resolved once at registration; null for handlers implemented in blueprint, which go through the Execute_K2 thunk instead. */
+	TArray<void*> NativeInterfaces;
+
+	/** The interface the native addresses were resolved against. */
+	UPROPERTY(Transient)
+	TObjectPtr<UClass> InterfaceClass;
+
+	template<typename TUInterface, typename TIInterface>
+	void AddHandler(UObject* Handler)
+	{
+		check(!InterfaceClass || InterfaceClass == TUInterface::StaticClass());
+		
+		if (Array.Contains(Handler))
+		{
+			return;
+		}
+
+		InterfaceClass = TUInterface::StaticClass();
+		
+		Array.Add(Handler);
+		NativeInterfaces.Add(Cast<TIInterface>(Handler));
+	}
+
+	void RemoveHandler(UObject* Handler)
+	{
+		int32 Index = Array.Find(Handler);
+
+		if (Index != INDEX_NONE)
+		{
+			Array.RemoveAt(Index);
+			NativeInterfaces.RemoveAt(Index);
+		}
+	}
 };
 
 // ================================================================================================
@@ -95,7 +137,7 @@ struct FYap__ActiveSpeechContainer
 	FYapSpeechEvent OnSpeechFinish;
 
 	UPROPERTY(Transient)
-	FTimerHandle SpeechTimerHandle;
+	FYapTimerHandle SpeechTimerHandle;
 
 	UPROPERTY(Transient)
 	FYapConversationHandle ConversationHandle;
@@ -123,6 +165,43 @@ struct FYapConversationTestMap
 };
 */
 
+/** One entry of the active speech slot table. Slots are recycled; the generation is bumped every time a slot is released so that stale handles can be detected. */
+USTRUCT()
+struct FYap__ActiveSpeechSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	FYapSpeechHandle Handle;
+
+	UPROPERTY(Transient)
+	FYap__ActiveSpeechContainer Container;
+
+	uint32 Generation = 0;
+
+	bool bOccupied = false;
+
+	// Intrusive lists of all speech running for the same owner / speaker; these replace per-bucket handle arrays
+	int32 PrevByOwner = INDEX_NONE;
+	int32 NextByOwner = INDEX_NONE;
+	int32 PrevBySpeaker = INDEX_NONE;
+	int32 NextBySpeaker = INDEX_NONE;
+};
+
+/** One entry of the conversation slot table. */
+USTRUCT()
+struct FYap__ConversationSlot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	FYapConversation Conversation;
+
+	uint32 Generation = 0;
+
+	bool bOccupied = false;
+};
+
 USTRUCT()
 struct FYap__ActiveSpeechMap
 {
@@ -131,18 +210,39 @@ struct FYap__ActiveSpeechMap
 // ----------------------------------------------
 // ----------------------------------------------
 private:
+	/** Dense slot table of all running speech. Handles store their slot index and generation, so lookups never need to hash the guid. */
 	UPROPERTY(Transient)
-	TMap<FYapSpeechHandle, FYap__ActiveSpeechContainer> AllSpeech;
+	TArray<FYap__ActiveSpeechSlot> SpeechSlots;
+
+	/** Released slots, reused before the table grows. */
+	TArray<int32> FreeSpeechSlots;
+
+	/** Only used to reject duplicate guids and to resolve handles which were built without going through AddSpeech. */
+	TMap<FGuid, int32> SpeechSlotsByGuid;
 	
+	/** Head slot of each owner's list of running speech. */
 	UPROPERTY(Transient)
-	TMap<TObjectPtr<UObject>, FYapSpeechHandlesArray> ContainersByOwner;
+	TMap<TObjectPtr<UObject>, int32> SpeechHeadsByOwner;
 	
+	/** Head slot of each speaker's list of running speech. */
 	UPROPERTY(Transient)
-	TMap<FName, FYapSpeechHandlesArray> ContainersBySpeakerID;
+	TMap<FName, int32> SpeechHeadsBySpeakerID;
+
+	int32 ResolveSpeechSlot(const FYapSpeechHandle& Handle) const;
+
+	FYap__ActiveSpeechContainer* FindContainer(const FYapSpeechHandle& Handle);
+	
+	void LinkSpeechByOwner(int32 SlotIndex);
+	
+	void UnlinkSpeechByOwner(int32 SlotIndex);
 
+	void LinkSpeechBySpeaker(int32 SlotIndex);
+	
+	void UnlinkSpeechBySpeaker(int32 SlotIndex);
+	
 // ----------
 public:
-	FYap__ActiveSpeechContainer* AddSpeech(FYapSpeechHandle Handle, FName SpeakerID, UObject* SpeechOwner, UObject* ConversationOwner);
+	FYap__ActiveSpeechContainer* AddSpeech(FYapSpeechHandle& Handle, FName SpeakerID, UObject* SpeechOwner, UObject* ConversationOwner);
 
 	void RemoveSpeech(const FYapSpeechHandle& Handle);
 
@@ -150,32 +250,63 @@ public:
 	
 	void UnbindToSpeechFinish(const FYapSpeechHandle& Handle, FYapSpeechEventDelegate Delegate);
 
-	void SetTimer(const FYapSpeechHandle& Handle, FTimerHandle TimerHandle);
+	void SetTimer(const FYapSpeechHandle& Handle, FYapTimerHandle TimerHandle);
 	
 	TArray<FYapSpeechHandle> GetHandles(FName SpeakerID);
 	
 	TArray<FYapSpeechHandle> GetHandles(UObject* SpeechOwner);
 
 	TArray<FYapSpeechHandle> GetHandles(const FYapConversationHandle& ConversationHandle);
+
+	/** Visits running speech without copying, newest first. The visitor must not start or end any speech; gather into an inline array with GetHandles for that. */
+	void ForEachHandle(FName SpeakerID, TFunctionRef<void(const FYapSpeechHandle&)> Visitor) const;
+
+	void ForEachHandle(const UObject* SpeechOwner, TFunctionRef<void(const FYapSpeechHandle&)> Visitor) const;
+
+	void ForEachHandle(const FYapConversationHandle& ConversationHandle, TFunctionRef<void(const FYapSpeechHandle&)> Visitor) const;
+
+	/** Appends handles into a caller-provided array, so callers can use an inline allocator and avoid heap churn. */
+	template<typename TKey, typename AllocatorType>
+	void GetHandles(const TKey& Key, TArray<FYapSpeechHandle, AllocatorType>& OutHandles) const
+	{
+		ForEachHandle(Key, [&OutHandles] (const FYapSpeechHandle& Handle)
+		{
+			OutHandles.Add(Handle);
+		});
+	}
 	
 	FName FindSpeakerID(const FYapSpeechHandle& Handle);
 
-	FTimerHandle FindTimerHandle(const FYapSpeechHandle& Handle);
+	FYapTimerHandle FindTimerHandle(const FYapSpeechHandle& Handle);
 
 	FYapSpeechEvent FindSpeechFinishedEvent(const FYapSpeechHandle& Handle);
 
+	/** Non-copying version of FindSpeechFinishedEvent. Returns null if the speech is not running. */
+	const FYapSpeechEvent* FindSpeechFinishedEventView(const FYapSpeechHandle& Handle) const;
+
+	/** Moves the finish event out of the running speech, leaving it unbound. Used when the speech is about to be removed. */
+	FYapSpeechEvent TakeSpeechFinishedEvent(const FYapSpeechHandle& Handle);
+
 	FYapConversationHandle FindSpeechConversationHandle(const FYapSpeechHandle& Handle);
 
+	/** Node (or other object) which started the speech, null if the handle is not running. */
+	UObject* FindSpeechOwner(const FYapSpeechHandle& Handle);
+
 	bool IsSpeechRunning(const FYapSpeechHandle& Handle);
 	
 // ----------------------------------------------
 // ----------------------------------------------
 private:
+	/** Slot table of all conversations. There are usually only a handful, so handles without slot info are resolved by a linear guid scan. */
 	UPROPERTY(Transient)
-	TMap<FYapConversationHandle, FYapConversation> Conversations;
+	TArray<FYap__ConversationSlot> ConversationSlots;
+
+	TArray<int32> FreeConversationSlots;
 
 	UPROPERTY(Transient)
-	TMap<TObjectPtr<UObject>, FYapConversationHandle> ConversationsByOwner;
+	TMap<TObjectPtr<UObject>, int32> ConversationSlotsByOwner;
+
+	int32 ResolveConversationSlot(const FYapConversationHandle& ConversationHandle) const;
 	
 // ----------
 public:
@@ -192,6 +323,263 @@ public:
 
 // ================================================================================================
 
+USTRUCT()
+struct FYap__PromptEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	FYapConversationHandle Conversation;
+
+	/** Whoever broadcast the prompt menu this prompt belongs to, usually a dialogue node. */
+	TObjectKey<UObject> MenuOwner;
+};
+
+/**
+ * Owns every live prompt handle. Prompts are released as soon as they can no longer be chosen: when any prompt of their menu is chosen,
+ * when their menu owner broadcasts a new menu, or when their conversation closes. Without this, prompt handles were never released.
+ */
+USTRUCT()
+struct FYap__PromptRegistry
+{
+	GENERATED_BODY()
+
+private:
+	UPROPERTY(Transient)
+	TMap<FYapPromptHandle, FYap__PromptEntry> Prompts;
+
+	TMap<TObjectKey<UObject>, TArray<FYapPromptHandle>> PromptsByMenuOwner;
+
+	int32 HighWaterMark = 0;
+
+	int32 TotalRegistered = 0;
+	
+public:
+	void Register(const FYapPromptHandle& Handle, const FYapConversationHandle& Conversation, const UObject* MenuOwner);
+
+	const FYapConversationHandle* FindConversation(const FYapPromptHandle& Handle) const;
+
+	/** Releases the given prompt and every other prompt of its menu. */
+	void ReleaseMenuOf(const FYapPromptHandle& Handle);
+
+	/** Releases all prompts broadcast by this owner. */
+	void ReleaseMenu(const UObject* MenuOwner);
+
+	void ReleaseConversation(const FYapConversationHandle& Conversation);
+
+	bool HasConversationPrompts(const FYapConversationHandle& Conversation) const;
+
+	void Reset();
+
+	/** Number of live prompts. */
+	int32 Num() const { return Prompts.Num(); }
+
+	/** Most prompts which were ever live at the same time. */
+	int32 GetHighWaterMark() const { return HighWaterMark; }
+
+	/** Number of prompts registered since the subsystem started. */
+	int32 GetTotalRegistered() const { return TotalRegistered; }
+
+private:
+	void Release(const FYapPromptHandle& Handle);
+};
+
+// ================================================================================================
+
+USTRUCT()
+struct FYap__ConversationRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(Transient)
+	FYapConversationHandle Handle;
+
+	UPROPERTY(Transient)
+	FYapConversationRequest Request;
+
+	/** Request order; breaks priority ties and tells current heap entries from stale ones. */
+	uint64 Sequence = 0;
+
+	/** World time after which the request is dropped, zero if it never expires. */
+	double ExpireTime = 0.0;
+};
+
+/**
+ * Decides which conversation is active. Waiting requests are kept in a binary heap ordered by priority and then by request order,
+ * and requests with a timeout also in a heap ordered by expiry time, so adding a request or taking the next one is O(log n).
+ * Removed requests are left in the heaps and skipped when they come to the top.
+ */
+USTRUCT()
+struct FYap__ConversationScheduler
+{
+	GENERATED_BODY()
+
+private:
+	struct FHeapEntry
+	{
+		FYapConversationHandle Handle;
+		
+		uint64 Sequence;
+
+		int32 Priority;
+
+		double ExpireTime;
+	};
+
+	/** Higher priority first, then earlier requests. */
+	struct FByPriority
+	{
+		bool operator()(const FHeapEntry& A, const FHeapEntry& B) const { return A.Priority != B.Priority ? A.Priority > B.Priority : A.Sequence < B.Sequence; }
+	};
+
+	struct FByExpiry
+	{
+		bool operator()(const FHeapEntry& A, const FHeapEntry& B) const { return A.ExpireTime < B.ExpireTime; }
+	};
+	
+	UPROPERTY(Transient)
+	FYapConversationHandle Active;
+
+	/** The request which the active conversation was opened with, kept so that it can be queued again if it is preempted. */
+	UPROPERTY(Transient)
+	FYapConversationRequest ActiveRequest;
+
+	/** Every live waiting request. Heap entries which no longer match a request here are stale. */
+	UPROPERTY(Transient)
+	TMap<FYapConversationHandle, FYap__ConversationRequest> Pending;
+
+	/** Deferred requests made since the last flush; they enter the priority heap on the subsystem's next tick, but the expiry heap straight away. */
+	TArray<FYapConversationHandle> Deferred;
+
+	TArray<FHeapEntry> PriorityHeap;
+
+	TArray<FHeapEntry> ExpiryHeap;
+
+	uint64 NextSequence = 0;
+
+	int32 PendingHighWaterMark = 0;
+
+	int32 TotalActivated = 0;
+
+	int32 TotalExpired = 0;
+
+public:
+	void Add(const FYapConversationHandle& Handle, const FYapConversationRequest& Request, double Now);
+
+	/** Removes the active conversation or a waiting request. */
+	bool Remove(const FYapConversationHandle& Handle);
+
+	bool Contains(const FYapConversationHandle& Handle) const { return Active == Handle || Pending.Contains(Handle); }
+
+	const FYapConversationHandle& GetActive() const { return Active.IsValid() ? Active : FYapConversationHandle::GetNullHandle(); }
+
+	int32 GetActivePriority() const { return ActiveRequest.Priority; }
+
+	/** Puts the active conversation back in the queue with its original priority. It never times out, since it already had its turn once. */
+	bool RequeueActive();
+
+	/** The request which would become active next, if any. */
+	const FYap__ConversationRequest* PeekNext();
+
+	/** If nothing is active, makes the best waiting request active. */
+	bool ActivateNext(FYapConversationHandle& OutHandle);
+
+	/** Moves deferred requests into the heaps. Returns true if there were any. */
+	bool FlushDeferred();
+
+	/** Removes every waiting request whose timeout has passed. */
+	void RemoveExpired(double Now, TArray<FYapConversationHandle>& OutExpired);
+
+	int32 NumPending() const { return Pending.Num(); }
+
+	/** Most requests which were ever waiting at the same time. */
+	int32 GetPendingHighWaterMark() const { return PendingHighWaterMark; }
+
+	/** Number of requests which became active since the subsystem started. */
+	int32 GetTotalActivated() const { return TotalActivated; }
+
+	/** Number of requests which timed out waiting since the subsystem started. */
+	int32 GetTotalExpired() const { return TotalExpired; }
+
+	void Reset();
+
+private:
+	void Push(const FYap__ConversationRequest& Entry);
+
+	void PushExpiry(const FYap__ConversationRequest& Entry);
+
+	bool IsCurrent(const FHeapEntry& Entry) const;
+
+	/** Rebuilds the heaps without stale entries once those outnumber the live ones. */
+	void CompactIfNeeded();
+};
+
+// ================================================================================================
+
+/**
+ * Decides whether free speech (barks) may run, by global budget, per-speaker cooldown and distance from the local player's camera
+ * (see the free speech settings in UYapProjectSettings). Culled speech skips speech time evaluation, handler broadcasts and timers.
+ */
+USTRUCT()
+struct FYap__FreeSpeechBudget
+{
+	GENERATED_BODY()
+
+private:
+	/** Free speech which is running. */
+	TSet<FGuid> Running;
+
+	/** When each speaker last started free speech. */
+	TMap<FName, double> LastSpeechTimes;
+
+	/** LastSpeechTimes is pruned of finished cooldowns whenever it grows past this. */
+	int32 PruneThreshold = 256;
+
+	FVector ListenerLocation = FVector::ZeroVector;
+
+	bool bHasListener = false;
+
+	/** Frame the listener location was resolved on; it is resolved at most once per frame. */
+	uint64 ListenerFrame = MAX_uint64;
+
+	int32 HighWaterMark = 0;
+
+	int32 TotalCulled = 0;
+
+public:
+	/** Returns false if the speech should be culled. Admitted speech starts its speaker's cooldown. */
+	bool Admit(const UWorld* World, FName SpeakerID, const FVector* SpeakerLocation);
+
+	void AddRunning(const FYapSpeechHandle& Handle)
+	{
+		Running.Add(Handle.GetGuid());
+		HighWaterMark = FMath::Max(HighWaterMark, Running.Num());
+	}
+
+	void RemoveRunning(const FYapSpeechHandle& Handle)
+	{
+		if (Running.Num() > 0)
+		{
+			Running.Remove(Handle.GetGuid());
+		}
+	}
+
+	int32 NumRunning() const { return Running.Num(); }
+
+	/** Most free speech which was ever running at the same time. */
+	int32 GetHighWaterMark() const { return HighWaterMark; }
+
+	/** Number of free speech requests culled since the subsystem started. */
+	int32 GetTotalCulled() const { return TotalCulled; }
+
+	void Reset();
+
+private:
+	void UpdateListener(const UWorld* World);
+};
+
+// ================================================================================================
+
 // Alias for TSubclassOf<UFlowNode_YapDialogue>.
 // This is a wrapper to auto-convert a null type to the default Yap dialogue node type.
 USTRUCT(BlueprintType)
@@ -247,11 +635,12 @@ struct FYapDialogueNodeClassType
 // ================================================================================================
 
 UCLASS()
-class YAP_API UYapSubsystem : public UWorldSubsystem
+class YAP_API UYapSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
 friend class UFlowNode_YapDialogue;
+friend class UYapBitReplacementRegister;
 friend struct FYapFragment;
 friend struct FYapPromptHandle;
 	
@@ -274,27 +663,29 @@ protected:
 	UPROPERTY(Transient)
 	TObjectPtr<UYapBroker> Broker;
 
-	/** Queue of conversations. The top one is always going to be "active". If two "Open Conversation" nodes run, the second one will wait in this queue until the first one closes. */
 	UPROPERTY(Transient)
-	TArray<FYapConversationHandle> ConversationQueue;
+	FYap__FreeSpeechBudget FreeSpeechBudget;
+
+	/** Active conversation and waiting conversation requests. If two "Open Conversation" nodes run, the second one waits until the first one closes, unless it has a higher priority and preempts it. */
+	UPROPERTY(Transient)
+	FYap__ConversationScheduler ConversationScheduler;
 
 	///** Stores which conversation a given speech is a part of */
 	//UPROPERTY(Transient)
 	//TMap<FYapSpeechHandle, FYapConversationHandle> SpeechConversationMapping;
 	
-	/** Stores which conversation a given prompt is a part of */
+	/** Stores which conversation a given prompt is a part of, and releases prompts once they can no longer be chosen */
 	UPROPERTY(Transient)
-	TMap<FYapPromptHandle, FYapConversationHandle> PromptHandleConversationTags;
+	FYap__PromptRegistry PromptRegistry;
 
-	// TODO dialogue node FName map?
-	// TODO change this up, should instead use Flow asset instance + flow node instance + fragment FName 
-	/** Stores the tag of a fragment and the owning dialogue node where that fragment can be found */
-	UPROPERTY(Transient)
-	TMap<FGameplayTag, UFlowNode_YapDialogue*> TaggedFragments;
+	/** Fragments of all running dialogue nodes by fragment ID. Nodes register as their Flow asset instances start and unregister as they end. */
+	FYapFragmentIndex TaggedFragments;
 
-	/** Stores overrides of bit replacements. Currently, can only store one at a time per fragment; new assignments simply replace the old one. */
-	UPROPERTY(Transient)
-	TMap<FGameplayTag, FYapBitReplacement> BitReplacements;
+	/** Layered replacements of fragment text and audio, resolved into a flat table by fragment ID. Holds this world's runtime mods on top of the game instance's persistent layers. */
+	FYapBitReplacementLayers BitReplacements;
+
+	/** Game instance subsystem which keeps the persistent replacement layers across map travel. Unset for worlds without a game instance, which keep every layer themselves. */
+	TWeakObjectPtr<UYapBitReplacementRegister> BitReplacementRegister;
 
 	/** All registered character components. */
 	UPROPERTY(Transient)
@@ -304,6 +695,23 @@ protected:
 	UPROPERTY(Transient)
 	TSet<TObjectPtr<AActor>> RegisteredYapCharacterActors;
 
+	/** Registered characters sorted by location, for radius, cone and nearest queries. */
+	FYapCharacterGrid CharacterGrid;
+
+	/** Drives speech completion and fragment padding expiry from the subsystem tick. */
+	FYapTimingWheel TimingWheel;
+
+	/** Starts async loads for dialogue nodes ahead of running ones. */
+	FYapContentPrefetcher ContentPrefetcher;
+
+	/** Dialogue databases opened so far, by template Flow asset. Null entries mean the asset has no database. */
+	mutable TMap<TObjectKey<UFlowAsset>, TSharedPtr<const FYapDialogueDatabase>> DialogueDatabases;
+
+	FYapSessionRecorder SessionRecorder;
+
+	/** Set while a recorded session is being replayed. */
+	TUniquePtr<FYapSessionReplayer> SessionReplayer;
+
 	static bool bGetGameMaturitySettingWarningIssued;
 
 public:
@@ -331,6 +739,27 @@ public:
 public:
 	UYapSquirrel& GetNoiseGenerator() { return *NoiseGenerator; }
 
+	const UYapSquirrel& GetNoiseGenerator() const { return *NoiseGenerator; }
+
+	// - - - - - SESSION RECORDING - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	
+	/** Starts recording every dialogue event, restarting if already recording. */
+	void StartSessionRecording();
+
+	/** Stops recording and writes the session. Uses FYapSessionRecorder::MakeFilename if no filename is given. Returns the written file, or an empty string. */
+	FString StopSessionRecording(const FString& Filename = FString());
+
+	/** Replays a recorded session from now on; see FYapSessionReplayer. Speech and conversations the game started itself are not replayed, the game has to start them again. */
+	bool ReplaySession(const FString& Filename);
+
+	bool IsReplayingSession() const { return SessionReplayer.IsValid(); }
+
+private:
+	template<typename THandle>
+	void RecordSessionEvent(EYapSessionEvent Event, const THandle& Handle, EYapSpeechCompleteResult Result = EYapSpeechCompleteResult::Undefined);
+
+public:
+
 	static UYapCharacterManager& GetCharacterManager(UObject* WorldContextObject);
 	
 	/*
@@ -363,6 +792,9 @@ public:
 	/** Given a character identity tag, attempt to find the character component in the world. */
 	static UYapCharacterComponent* FindCharacterComponent(UWorld* World, FName CharacterName);
 
+	/** Registered characters by location. Locations are refreshed every subsystem tick. */
+	const FYapCharacterGrid& GetCharacterGrid() const { return CharacterGrid; }
+
 	// =========================================
 	// YAP API - These are called by Yap classes
 	// =========================================
@@ -392,6 +824,20 @@ public:
 	
 	static bool IsSpeechInConversation(const UObject* WorldContext, const FYapSpeechHandle& Handle);
 
+	/** Adds the fragments of a dialogue node to the fragment ID index. */
+	void RegisterTaggedFragments(UFlowNode_YapDialogue* DialogueNode);
+
+	void UnregisterTaggedFragments(const UFlowNode_YapDialogue* DialogueNode);
+
+	/** Live prompt count, high-water mark and total registered prompts, e.g. for soak tests and debug displays. */
+	const FYap__PromptRegistry& GetPromptRegistry() const { return PromptRegistry; }
+
+	/** Active conversation, waiting requests and how many requests opened or timed out so far. */
+	const FYap__ConversationScheduler& GetConversationScheduler() const { return ConversationScheduler; }
+
+	/** Running free speech, its high-water mark and how much free speech was culled so far. */
+	const FYap__FreeSpeechBudget& GetFreeSpeechBudget() const { return FreeSpeechBudget; }
+
 public:
 #if WITH_EDITOR
 	static const UYapBroker& GetBroker_Editor();
@@ -401,16 +847,30 @@ public:
 	
 	static EYapMaturitySetting GetCurrentMaturitySetting(UWorld* World);
 
-	/**  */
+	/** Finds the fragment whose fragment ID is the tag's name among all running dialogue nodes. */
 	FYapFragment* FindTaggedFragment(const FGameplayTag& FragmentTag);
-	
-protected:  // TODO should some of these be public?
-	/**  */
-	void RegisterTaggedFragment(const FGameplayTag& FragmentTag, UFlowNode_YapDialogue* DialogueNode);
+
+	/** Finds all fragments whose fragment ID is the tag's name or, if bIncludeChildren, below it (e.g. "Quest.Intro" finds "Quest.Intro.Greeting"). */
+	void FindTaggedFragments(const FGameplayTag& FragmentTag, TArray<FYapFragmentLocation>& OutLocations, bool bIncludeChildren = true) const;
+
+	const FYapFragmentIndex& GetFragmentIndex() const { return TaggedFragments; }
+
+	/** Replaces the text, audio or time of the fragment whose fragment ID is the tag's name, on top of lower layers. Only RuntimeMod replacements are cleared with the world. */
+	void SetBitReplacement(const FGameplayTag& FragmentTag, const FYapBitReplacement& Replacement, EYapBitReplacementLayer Layer = EYapBitReplacementLayer::RuntimeMod);
+
+	void RemoveBitReplacement(const FGameplayTag& FragmentTag, EYapBitReplacementLayer Layer = EYapBitReplacementLayer::RuntimeMod);
+
+	/** Replaces every replacement of a layer at once, keyed by fragment ID. Use this to mount or unmount a DLC or patch. */
+	void SetBitReplacementLayer(EYapBitReplacementLayer Layer, TMap<FName, FYapBitReplacement> Replacements);
+
+	const FYapBitReplacementLayers& GetBitReplacements() const { return BitReplacements; }
+
+	/** Returns the baked dialogue database of a cooked Flow asset, opening it on first use. Null in the editor or if the asset has no dialogue. */
+	TSharedPtr<const FYapDialogueDatabase> GetDialogueDatabase(const UFlowAsset* FlowAsset) const;
 
 public:
 	// Main open conversation function, and is called by the Open Conversation flow node
-	FYapConversation& OpenConversation(FName ConversationName, UObject* ConversationOwner); // Called by Open Conversation node
+	FYapConversation& OpenConversation(FName ConversationName, UObject* ConversationOwner, const FYapConversationRequest& Request = FYapConversationRequest()); // Called by Open Conversation node
 
 	// Main close conversation function
 	EYapConversationState CloseConversation(FYapConversationHandle& Handle);
@@ -436,18 +896,41 @@ protected:
 	
 	void StartNextQueuedConversation();
 
+	/** Opens the next conversation if none is active, or suspends the active one if a waiting request preempts it. */
+	void UpdateConversationSchedule();
+
+	/** Takes the turn away from the active conversation at a speech boundary and queues it again; its flow waits until it reopens. */
+	void SuspendActiveConversation(FYapConversation& Conversation);
+
+	/** Removes a conversation which never got its turn. */
+	void DropConversationRequest(const FYapConversationHandle& Handle);
+
 	UFUNCTION()
 	void OnActiveConversationClosed(UObject* Instigator, FYapConversationHandle Handle);
 	
 	/**  */
-	FYapPromptHandle BroadcastPrompt(const FYapData_PlayerPromptCreated& Data, FYapDialogueNodeClassType NodeType);
+	/** MenuOwner groups prompts into a menu; when one of them is chosen, the rest are released too. */
+	FYapPromptHandle BroadcastPrompt(const FYapData_PlayerPromptCreated& Data, FYapDialogueNodeClassType NodeType, const UObject* MenuOwner = nullptr);
+
+	/** Releases all prompts broadcast by this menu owner, e.g. before it broadcasts a new set. */
+	void ReleasePrompts(const UObject* MenuOwner);
 
 	/**  */
 	void OnFinishedBroadcastingPrompts(const FYapData_PlayerPromptsReady& Data, FYapDialogueNodeClassType NodeType);
 
 public:
+	/** Runs speech unconditionally. Free speech is not checked against the free speech budget here; callers which want it budgeted ask AdmitFreeSpeech first, as dialogue nodes and Run Speech do. */
 	void RunSpeech(const FYapData_SpeechBegins& SpeechData, FYapDialogueNodeClassType NodeType, const FYapSpeechHandle& SpeechHandle);
 
+	/** Issues async loads for dialogue nodes within the project's look-ahead depth of the given node. */
+	void PrefetchAhead(UFlowNode_YapDialogue* DialogueNode);
+
+	/** Schedules the dialogue node's OnPaddingComplete on the subsystem's timing wheel. */
+	FYapTimerHandle StartPaddingTimer(UFlowNode_YapDialogue* DialogueNode, const FYapSpeechHandle& Handle, float PaddingTime);
+
+	/** Cancels a speech or padding timer and invalidates the handle. Stale handles are ignored. */
+	void ClearTimer(FYapTimerHandle& TimerHandle);
+	
 	/** This is a bit ghetto. Normally Yap permits speech to overlap (negative padding or Talk And Advance node usage), but sometimes we don't want that. This tells the subsystem to cancel this speech event if another one starts up. */
 	void MarkConversationSpeechAsFragile(const FYapSpeechHandle& Handle);
 
@@ -494,6 +977,16 @@ public:
 	// static bool SkipConversationTo(???);
 
 	bool EmitSpeechResult(const FYapSpeechHandle& Handle, EYapSpeechCompleteResult Result);
+
+	/**
+	 * Asks the free speech budget whether this speaker may start free speech now. Call it before doing any work for the speech; if it returns false,
+	 * get a handle and pass it to CullSpeech instead of RunSpeech. The speaker's location comes from their character component, else from LocationContext
+	 * if it is an actor or actor component.
+	 */
+	bool AdmitFreeSpeech(FName SpeakerID, const UObject* LocationContext = nullptr);
+
+	/** Completes speech which was never run with EYapSpeechCompleteResult::Culled on the next tick, so callers never hear about it before this returns. Only whatever is bound to the handle hears about it. */
+	void CullSpeech(const FYapSpeechHandle& Handle);
 	
 public:
 	/**  */
@@ -502,13 +995,13 @@ public:
 	/**  */
 	void UnregisterCharacterComponent(UYapCharacterComponent* YapCharacterComponent);
 
-	TArray<TObjectPtr<UObject>>& FindOrAddConversationHandlerArray(FYapDialogueNodeClassType NodeType);
+	FYapHandlersArray& FindOrAddConversationHandlerArray(FYapDialogueNodeClassType NodeType);
 
-	TArray<TObjectPtr<UObject>>* FindConversationHandlerArray(FYapDialogueNodeClassType NodeType);
+	FYapHandlersArray* FindConversationHandlerArray(FYapDialogueNodeClassType NodeType);
 	
-	TArray<TObjectPtr<UObject>>& FindOrAddFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType);
+	FYapHandlersArray& FindOrAddFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType);
 	
-	TArray<TObjectPtr<UObject>>* FindFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType);
+	FYapHandlersArray* FindFreeSpeechHandlerArray(FYapDialogueNodeClassType NodeType);
 
 	FYapSpeechHandle GetNewSpeechHandle(FName SpeakerID, UObject* SpeechOwner, UObject* ConversationOwner);
 	
@@ -523,8 +1016,16 @@ public:
 
 	/**  */
 	void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**  */
+	void Tick(float DeltaTime) override;
+
+	/**  */
+	TStatId GetStatId() const override;
 	
 protected:
+	void OnTimerExpired(const FYapTimerPayload& Payload);
+	
 	void OnSpeechComplete(FYapSpeechHandle Handle, bool bBroadcast, EYapSpeechCompleteResult SpeechResult = EYapSpeechCompleteResult::Undefined);
 
 	/**  */
@@ -532,26 +1033,43 @@ protected:
 
 	// Thanks to Blue Man for template help
 	template<typename TUInterface, typename TIInterface, auto TFunction, auto TExecFunction, typename... TArgs>
-	static void BroadcastEventHandlerFunc(TArray<TObjectPtr<UObject>>* HandlersArray, TArgs&&... Args)
+	static void BroadcastEventHandlerFunc(FYapHandlersArray* Handlers, TArgs&&... Args)
 	{
-		if (!HandlersArray)
+		SCOPE_CYCLE_COUNTER(STAT_YapBroadcastEvent);
+		TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(YapBroadcastEvent, YapChannel);
+
+		if (!Handlers)
 		{
 			UE_LOG(LogYap, Error, TEXT("No handlers are currently registered for this type group!"));
 			return;
 		}
 		
+		// Native interface addresses are only usable if they were resolved against the interface we are calling
+		const bool bUseResolvedDispatch = Handlers->InterfaceClass == TUInterface::StaticClass();
+		
 		bool bHandled = false;
 	
-		for (int i = 0; i < HandlersArray->Num(); ++i)
+		for (int i = 0; i < Handlers->Array.Num(); ++i)
 		{
-			UObject* HandlerObj = (*HandlersArray)[i];
+			UObject* HandlerObj = Handlers->Array[i];
 
 			if (!IsValid(HandlerObj))
 			{
 				continue;
 			}
-		
-			if (TIInterface* CppInterface = Cast<TIInterface>(HandlerObj))
+
+			if (bUseResolvedDispatch)
+			{
+				if (void* NativeInterface = Handlers->NativeInterfaces[i])
+				{
+					(static_cast<TIInterface*>(NativeInterface)->*TFunction)(Args...);
+				}
+				else
+				{
+					(*TExecFunction)(HandlerObj, Args...);
+				}
+			}
+			else if (TIInterface* CppInterface = Cast<TIInterface>(HandlerObj))
 			{
 				(CppInterface->*TFunction)(Args...);
 			}
@@ -0,0 +1,204 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Yap/Handles/YapSpeechHandle.h"
+
+#include "YapTimingWheel.generated.h"
+
+// ================================================================================================
+
+/** Handle to an entry on the subsystem's timing wheel. Stale handles (entry already fired or cancelled) are safe to cancel. */
+USTRUCT()
+struct YAP_API FYapTimerHandle
+{
+	GENERATED_BODY()
+
+	FYapTimerHandle() = default;
+
+	FYapTimerHandle(int32 InIndex, uint32 InGeneration)
+		: Index(InIndex)
+		, Generation(InGeneration)
+	{}
+
+private:
+	UPROPERTY(Transient)
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY(Transient)
+	uint32 Generation = 0;
+
+public:
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	void Invalidate() { Index = INDEX_NONE; Generation = 0; }
+
+	int32 GetIndex() const { return Index; }
+
+	uint32 GetGeneration() const { return Generation; }
+};
+
+// ================================================================================================
+
+UENUM()
+enum class EYapTimerEvent : uint8
+{
+	None,
+	SpeechComplete,
+	PaddingComplete,
+	SpeechCulled,
+};
+
+/** What to do when a timer expires. Plain data, so scheduling never has to allocate a delegate. */
+struct FYapTimerPayload
+{
+	EYapTimerEvent Event = EYapTimerEvent::None;
+
+	FYapSpeechHandle SpeechHandle;
+
+	TWeakObjectPtr<UObject> Target;
+};
+
+// ================================================================================================
+
+/**
+ * Hashed timing wheel. Scheduling and cancelling are O(1); advancing only visits the buckets the elapsed time passed over.
+ * Entries further out than one revolution stay in their bucket until their tick comes around. Timers never fire early and
+ * fire at most one resolution step late.
+ */
+struct YAP_API FYapTimingWheel
+{
+	void Initialize(float InResolution, int32 InNumBuckets);
+
+	void Reset();
+
+	FYapTimerHandle Schedule(float Delay, const FYapTimerPayload& Payload);
+
+	bool Cancel(FYapTimerHandle& Handle);
+
+	bool IsScheduled(const FYapTimerHandle& Handle) const;
+
+	float GetTimeRemaining(const FYapTimerHandle& Handle) const;
+
+	int32 Num() const { return NumScheduled; }
+
+	/** Advances the wheel and calls Fire(const FYapTimerPayload&) for every expired entry, in expiry order per bucket. Fire may schedule or cancel other entries. */
+	template<typename TFire>
+	void Advance(float DeltaTime, TFire&& Fire);
+
+private:
+	struct FEntry
+	{
+		FYapTimerPayload Payload;
+
+		int64 ExpireTick = 0;
+
+		uint32 Generation = 0;
+
+		int32 Prev = INDEX_NONE;
+
+		int32 Next = INDEX_NONE;
+
+		int32 Bucket = INDEX_NONE;
+
+		bool bScheduled = false;
+	};
+
+	float Resolution = 1.0f / 60.0f;
+
+	/** Time elapsed since CurrentTick, always less than one resolution step. */
+	double Remainder = 0.0;
+
+	int64 CurrentTick = 0;
+
+	int32 NumScheduled = 0;
+
+	TArray<FEntry> Entries;
+
+	TArray<int32> FreeEntries;
+
+	/** Head entry of each bucket. Always a power of two in size. */
+	TArray<int32> Buckets;
+
+	/** Scratch list of entries collected during Advance. */
+	TArray<int32> Expired;
+
+	const FEntry* FindEntry(const FYapTimerHandle& Handle) const;
+
+	void Link(int32 EntryIndex);
+
+	void Unlink(int32 EntryIndex);
+
+	void Release(int32 EntryIndex);
+};
+
+// ------------------------------------------------------------------------------------------------
+
+template<typename TFire>
+void FYapTimingWheel::Advance(float DeltaTime, TFire&& Fire)
+{
+	Remainder += DeltaTime;
+
+	const int64 Steps = FMath::FloorToInt64(Remainder / Resolution);
+
+	if (Steps <= 0)
+	{
+		return;
+	}
+
+	Remainder -= Steps * Resolution;
+
+	const int64 TargetTick = CurrentTick + Steps;
+
+	if (NumScheduled == 0)
+	{
+		CurrentTick = TargetTick;
+		return;
+	}
+
+	// After one full revolution every bucket has been visited, no need to go around again
+	const int64 BucketsToVisit = FMath::Min<int64>(Steps, Buckets.Num());
+	const int64 BucketMask = Buckets.Num() - 1;
+
+	Expired.Reset();
+
+	for (int64 Tick = CurrentTick + 1; Tick <= CurrentTick + BucketsToVisit; ++Tick)
+	{
+		int32 EntryIndex = Buckets[Tick & BucketMask];
+
+		while (EntryIndex != INDEX_NONE)
+		{
+			const int32 NextIndex = Entries[EntryIndex].Next;
+
+			if (Entries[EntryIndex].ExpireTick <= TargetTick)
+			{
+				Unlink(EntryIndex);
+				Expired.Add(EntryIndex);
+			}
+
+			EntryIndex = NextIndex;
+		}
+	}
+
+	CurrentTick = TargetTick;
+
+	for (int32 i = 0; i < Expired.Num(); ++i)
+	{
+		const int32 EntryIndex = Expired[i];
+
+		// An earlier callback in this batch may have cancelled it, and the slot may even have been rescheduled (which links it back into a bucket)
+		if (!Entries[EntryIndex].bScheduled || Entries[EntryIndex].Bucket != INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FYapTimerPayload Payload = MoveTemp(Entries[EntryIndex].Payload);
+
+		Release(EntryIndex);
+
+		Fire(Payload);
+	}
+
+	Expired.Reset();
+}
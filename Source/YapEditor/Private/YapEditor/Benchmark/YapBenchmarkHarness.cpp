@@ -0,0 +1,564 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "YapEditor/Benchmark/YapBenchmarkHarness.h"
+
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "FlowAsset.h"
+#include "FlowSubsystem.h"
+#include "Graph/FlowGraph.h"
+#include "Graph/FlowGraphSchema_Actions.h"
+#include "Graph/Nodes/FlowGraphNode.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Nodes/Graph/FlowNode_Start.h"
+#include "Yap/YapLog.h"
+#include "Yap/YapNodeConfig.h"
+#include "Yap/YapProjectSettings.h"
+#include "Yap/YapSubsystem.h"
+#include "Yap/Enums/YapTimeMode.h"
+#include "Yap/Nodes/FlowNode_YapConversation_Close.h"
+#include "Yap/Nodes/FlowNode_YapConversation_Open.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+#include "YapEditor/YapEditorLog.h"
+
+#define LOCTEXT_NAMESPACE "YapEditor"
+
+namespace YapBenchmark
+{
+	// Same step the subsystem's timing wheel uses
+	constexpr float DeltaTime = 1.0f / 60.0f;
+
+	/** Graph variants built for each kind of flow; the flows are spread across them. */
+	constexpr int32 NumVariants = 4;
+
+	/** Flows start at a random frame within this many, so that the run doesn't begin with every flow at once. */
+	constexpr int32 StaggerFrames = 120;
+
+	static UFlowAsset* NewFlowAsset(const TCHAR* BaseName)
+	{
+		UPackage* Package = GetTransientPackage();
+
+		UFlowAsset* Asset = NewObject<UFlowAsset>(Package, MakeUniqueObjectName(Package, UFlowAsset::StaticClass(), BaseName), RF_Transient);
+		UFlowGraph::CreateGraph(Asset);
+
+		return Asset;
+	}
+
+	static UFlowGraphNode* AddNode(UFlowAsset* Asset, UClass* NodeClass)
+	{
+		return FFlowGraphSchemaAction_NewNode::CreateNode(Asset->GetGraph(), nullptr, NodeClass, FVector2D::ZeroVector, false);
+	}
+
+	static UFlowGraphNode* FindOrAddStartNode(UFlowAsset* Asset)
+	{
+		for (UEdGraphNode* Node : Asset->GetGraph()->Nodes)
+		{
+			UFlowGraphNode* FlowGraphNode = Cast<UFlowGraphNode>(Node);
+
+			if (FlowGraphNode && Cast<UFlowNode_Start>(FlowGraphNode->GetFlowNodeBase()))
+			{
+				return FlowGraphNode;
+			}
+		}
+
+		return AddNode(Asset, UFlowNode_Start::StaticClass());
+	}
+
+	static bool Connect(UFlowGraphNode* From, FName OutputPinName, UFlowGraphNode* To)
+	{
+		UEdGraphPin* OutputPin = From->FindPin(OutputPinName, EGPD_Output);
+		UEdGraphPin* InputPin = To->FindPin(UFlowNode::DefaultInputPin.PinName, EGPD_Input);
+
+		if (!OutputPin || !InputPin)
+		{
+			UE_LOG(LogYapEditor, Error, TEXT("Benchmark graph: could not connect %s [%s] to %s!"), *From->GetName(), *OutputPinName.ToString(), *To->GetName());
+			return false;
+		}
+
+		return From->GetSchema()->TryCreateConnection(OutputPin, InputPin);
+	}
+}
+
+// ================================================================================================
+
+double FYapBenchmarkResults::GetLatencyPercentile(double Fraction) const
+{
+	return Latencies.Num() > 0 ? Latencies[FMath::Min(Latencies.Num() - 1, FMath::FloorToInt32(Latencies.Num() * Fraction))] : 0.0;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkResults::Log(const FYapBenchmarkSettings& Settings) const
+{
+	const int32 NumSpeeches = NumConversationSpeeches + NumFreeSpeeches;
+
+	UE_LOG(LogYapEditor, Display, TEXT("Yap benchmark: %i conversation flows, %i bark flows, %i frames of %.4fs (seed %i)."), Settings.NumConversations, Settings.NumBarks, NumFrames, YapBenchmark::DeltaTime, Settings.Seed);
+	UE_LOG(LogYapEditor, Display, TEXT("  Speeches:          %i in conversations, %i free (%.0f/sec wall time, %i handler events)"), NumConversationSpeeches, NumFreeSpeeches, NumSpeeches / FMath::Max(WallSeconds, UE_DOUBLE_SMALL_NUMBER), NumHandlerEvents);
+	UE_LOG(LogYapEditor, Display, TEXT("  Conversations:     %i opened, %i timed out waiting, up to %i waiting at once"), ConversationsActivated, ConversationsExpired, PendingConversationsHighWaterMark);
+	UE_LOG(LogYapEditor, Display, TEXT("  Free speech:       %i culled, up to %i running at once (budget %i)"), FreeSpeechCulled, FreeSpeechHighWaterMark, Settings.FreeSpeechBudget);
+	UE_LOG(LogYapEditor, Display, TEXT("  RunSpeech latency: p50 %.2fus, p99 %.2fus, max %.2fus (%i probes)"), GetLatencyPercentile(0.5), GetLatencyPercentile(0.99), Latencies.Num() > 0 ? Latencies.Last() : 0.0, Latencies.Num());
+	UE_LOG(LogYapEditor, Display, TEXT("  World tick:        avg %.2fus, max %.2fus"), AverageTickSeconds * 1e6, MaxTickSeconds * 1e6);
+
+	if (LLMPeakBytes != INDEX_NONE)
+	{
+		UE_LOG(LogYapEditor, Display, TEXT("  Yap LLM tag:       %.1f KiB at start, %.1f KiB peak, %.1f KiB at end (%.1f bytes of growth per speech)"), LLMStartBytes / 1024.0, LLMPeakBytes / 1024.0, LLMEndBytes / 1024.0, (LLMEndBytes - LLMStartBytes) / (double)FMath::Max(NumSpeeches, 1));
+	}
+	else
+	{
+		UE_LOG(LogYapEditor, Display, TEXT("  Yap LLM tag:       not tracked, run with -llm"));
+	}
+
+	UE_LOG(LogYapEditor, Display, TEXT("  Peak memory:       %.1f MiB physical"), PeakUsedPhysical / (1024.0 * 1024.0));
+	UE_LOG(LogYapEditor, Display, TEXT("  Allocations:       not counted; compare the LLM bytes per speech instead"));
+}
+
+// ================================================================================================
+
+FYapBenchmarkHarness::FYapBenchmarkHarness(const FYapBenchmarkSettings& InSettings)
+	: Settings(InSettings)
+{
+}
+
+// ------------------------------------------------------------------------------------------------
+
+FYapBenchmarkHarness::~FYapBenchmarkHarness()
+{
+	End();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapBenchmarkHarness::Run(FYapBenchmarkResults& OutResults)
+{
+	OutResults = FYapBenchmarkResults();
+
+	if (!Begin())
+	{
+		End();
+		return false;
+	}
+
+	const int32 NumFrames = FMath::CeilToInt32(Settings.Seconds / YapBenchmark::DeltaTime);
+	const FYapDialogueNodeClassType NodeType(UFlowNode_YapDialogue::StaticClass());
+	const FText DialogueText = LOCTEXT("YapBenchmark_ProbeText", "The quick brown fox jumps over the lazy dog.");
+
+	TArray<FName> ProbeSpeakers;
+
+	for (int32 i = 0; i < Settings.LatencyProbesPerFrame; ++i)
+	{
+		ProbeSpeakers.Add(FName(TEXT("LatencyProbe"), i));
+	}
+
+	OutResults.NumFrames = NumFrames;
+	OutResults.Latencies.Reserve(NumFrames * ProbeSpeakers.Num());
+
+	SampleMemory(OutResults);
+
+	double TickSeconds = 0.0;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		while (PendingStarts.IsValidIndex(NextPendingStart) && PendingStarts[NextPendingStart].Frame <= Frame)
+		{
+			StartFlow(PendingStarts[NextPendingStart++]);
+		}
+
+		const uint64 TickStart = FPlatformTime::Cycles64();
+		World->Tick(LEVELTICK_All, YapBenchmark::DeltaTime);
+		const double TickTime = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - TickStart);
+
+		TickSeconds += TickTime;
+		OutResults.MaxTickSeconds = FMath::Max(OutResults.MaxTickSeconds, TickTime);
+
+		RetryDroppedConversations();
+
+		for (const FName& SpeakerID : ProbeSpeakers)
+		{
+			FYapData_SpeechBegins Data;
+			Data.SpeakerID = SpeakerID;
+			Data.DialogueText = DialogueText;
+
+			// Finishes on the next tick, so probes don't pile up
+			Data.SpeechTime = YapBenchmark::DeltaTime;
+
+			const uint64 SpeechStart = FPlatformTime::Cycles64();
+
+			const FYapSpeechHandle SpeechHandle = Subsystem->GetNewSpeechHandle(SpeakerID, Handler, nullptr);
+			Subsystem->RunSpeech(Data, NodeType, SpeechHandle);
+
+			OutResults.Latencies.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - SpeechStart) * 1e6);
+		}
+
+		if (Frame % 60 == 0)
+		{
+			SampleMemory(OutResults);
+		}
+	}
+
+	OutResults.WallSeconds = FPlatformTime::Seconds() - StartTime;
+	OutResults.AverageTickSeconds = TickSeconds / FMath::Max(NumFrames, 1);
+
+	SampleMemory(OutResults);
+
+	OutResults.NumConversationSpeeches = Handler->NumConversationSpeeches;
+	OutResults.NumFreeSpeeches = Handler->NumFreeSpeeches - OutResults.Latencies.Num();
+	OutResults.NumHandlerEvents = Handler->NumEvents;
+
+	const FYap__ConversationScheduler& Scheduler = Subsystem->GetConversationScheduler();
+	OutResults.ConversationsActivated = Scheduler.GetTotalActivated();
+	OutResults.ConversationsExpired = Scheduler.GetTotalExpired();
+	OutResults.PendingConversationsHighWaterMark = Scheduler.GetPendingHighWaterMark();
+
+	const FYap__FreeSpeechBudget& FreeSpeechBudget = Subsystem->GetFreeSpeechBudget();
+	OutResults.FreeSpeechCulled = FreeSpeechBudget.GetTotalCulled();
+	OutResults.FreeSpeechHighWaterMark = FreeSpeechBudget.GetHighWaterMark();
+
+	OutResults.Latencies.Sort();
+
+	End();
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::AddReferencedObjects(FReferenceCollector& Collector)
+{
+	Collector.AddReferencedObject(GameInstance);
+	Collector.AddReferencedObject(World);
+	Collector.AddReferencedObject(FlowSubsystem);
+	Collector.AddReferencedObject(Subsystem);
+	Collector.AddReferencedObject(Handler);
+	Collector.AddReferencedObject(NodeConfig);
+	Collector.AddReferencedObjects(ConversationTemplates);
+	Collector.AddReferencedObjects(BarkTemplates);
+	Collector.AddReferencedObjects(FlowOwners);
+
+	for (FConversationFlow& ConversationFlow : ConversationFlows)
+	{
+		Collector.AddReferencedObject(ConversationFlow.Flow);
+		Collector.AddReferencedObject(ConversationFlow.OpenNode);
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+bool FYapBenchmarkHarness::Begin()
+{
+	OverrideProjectSettings();
+
+	// Every dropped conversation is logged at Display
+	SavedLogVerbosity = LogYap.GetVerbosity();
+	LogYap.SetVerbosity(ELogVerbosity::Warning);
+
+	FRandomStream Random(Settings.Seed);
+
+	for (int32 i = 0; i < YapBenchmark::NumVariants; ++i)
+	{
+		UFlowAsset* ConversationTemplate = BuildConversationTemplate(Random);
+		UFlowAsset* BarkTemplate = BuildBarkTemplate(Random);
+
+		if (!ConversationTemplate || !BarkTemplate)
+		{
+			return false;
+		}
+
+		ConversationTemplates.Add(ConversationTemplate);
+		BarkTemplates.Add(BarkTemplate);
+	}
+
+	GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->InitializeStandalone(TEXT("YapBenchmark"));
+
+	World = GameInstance->GetWorld();
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	FlowSubsystem = GameInstance->GetSubsystem<UFlowSubsystem>();
+	Subsystem = UYapSubsystem::Get(World.Get());
+
+	if (!FlowSubsystem || !Subsystem)
+	{
+		UE_LOG(LogYapEditor, Error, TEXT("Could not create the Flow and Yap subsystems!"));
+		return false;
+	}
+
+	const FYapDialogueNodeClassType NodeType(UFlowNode_YapDialogue::StaticClass());
+
+	Handler = NewObject<UYapBenchmarkHandler>(World);
+	UYapSubsystem::RegisterConversationHandler(Handler, NodeType);
+	UYapSubsystem::RegisterFreeSpeechHandler(Handler, NodeType);
+
+	PendingStarts.Reserve(Settings.NumConversations + Settings.NumBarks);
+
+	for (int32 i = 0; i < Settings.NumConversations + Settings.NumBarks; ++i)
+	{
+		FPendingStart& PendingStart = PendingStarts.AddDefaulted_GetRef();
+		PendingStart.Frame = Random.RandRange(0, YapBenchmark::StaggerFrames - 1);
+		PendingStart.TemplateIndex = i % YapBenchmark::NumVariants;
+		PendingStart.bConversation = i < Settings.NumConversations;
+	}
+
+	PendingStarts.StableSort([] (const FPendingStart& A, const FPendingStart& B) { return A.Frame < B.Frame; });
+
+	FlowOwners.Reserve(PendingStarts.Num());
+	ConversationFlows.Reserve(Settings.NumConversations);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::End()
+{
+	if (Handler)
+	{
+		const FYapDialogueNodeClassType NodeType(UFlowNode_YapDialogue::StaticClass());
+
+		UYapSubsystem::UnregisterFreeSpeechHandler(Handler, NodeType);
+		UYapSubsystem::UnregisterConversationHandler(Handler, NodeType);
+	}
+
+	// Stops every root flow while the world and the Yap subsystem are still around
+	if (GameInstance)
+	{
+		GameInstance->Shutdown();
+	}
+
+	if (World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+
+	GameInstance = nullptr;
+	World = nullptr;
+	FlowSubsystem = nullptr;
+	Subsystem = nullptr;
+	Handler = nullptr;
+
+	ConversationTemplates.Empty();
+	BarkTemplates.Empty();
+	OpenNodeGuids.Empty();
+	FlowOwners.Empty();
+	ConversationFlows.Empty();
+	PendingStarts.Empty();
+	NextPendingStart = 0;
+
+	if (bOverridingProjectSettings)
+	{
+		LogYap.SetVerbosity(SavedLogVerbosity);
+	}
+
+	RestoreProjectSettings();
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::OverrideProjectSettings()
+{
+	NodeConfig = NewObject<UYapNodeConfig>(GetTransientPackage(), NAME_None, RF_Transient);
+	NodeConfig->General.bDisableSpeaker = true;
+	NodeConfig->General.bDisableDirectedAt = true;
+	NodeConfig->Audio.bDisableAudio = true;
+	NodeConfig->MoodTags.bDisableMoodTags = true;
+
+	// Nobody has a speaker, so every speech would otherwise cancel everybody else's
+	NodeConfig->DialoguePlayback.bPermitOverlappingSpeech = true;
+
+	UYapProjectSettings::FTestOverrides Overrides;
+	Overrides.BrokerClass = UYapBenchmarkBroker::StaticClass();
+	Overrides.DefaultNodeConfig = NodeConfig.Get();
+	Overrides.FreeSpeechBudget = Settings.FreeSpeechBudget;
+
+	SavedProjectSettings = UYapProjectSettings::ApplyTestOverrides(Overrides);
+
+	bOverridingProjectSettings = true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::RestoreProjectSettings()
+{
+	if (!bOverridingProjectSettings)
+	{
+		return;
+	}
+
+	UYapProjectSettings::ApplyTestOverrides(SavedProjectSettings);
+
+	NodeConfig = nullptr;
+
+	bOverridingProjectSettings = false;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+UFlowAsset* FYapBenchmarkHarness::BuildConversationTemplate(FRandomStream& Random)
+{
+	UFlowAsset* Asset = YapBenchmark::NewFlowAsset(TEXT("YapBenchmarkConversation"));
+
+	UFlowGraphNode* StartNode = YapBenchmark::FindOrAddStartNode(Asset);
+	UFlowGraphNode* OpenNode = YapBenchmark::AddNode(Asset, UFlowNode_YapConversation_Open::StaticClass());
+
+	UFlowNode_YapConversation_Open* Open = CastChecked<UFlowNode_YapConversation_Open>(OpenNode->GetFlowNodeBase());
+	FYapConversationRequest Scheduling = Open->GetScheduling();
+	Scheduling.Timeout = Settings.ConversationTimeout;
+	Open->SetScheduling(Scheduling);
+
+	bool bConnected = YapBenchmark::Connect(StartNode, UFlowNode::DefaultOutputPin.PinName, OpenNode);
+
+	UFlowGraphNode* PreviousNode = OpenNode;
+	FName PreviousPinName = UFlowNode::DefaultOutputPin.PinName;
+
+	const int32 NumTalkNodes = Random.RandRange(2, 4);
+
+	for (int32 i = 0; i < NumTalkNodes; ++i)
+	{
+		UFlowGraphNode* TalkNode = AddTalkNode(Asset, Random);
+
+		bConnected &= YapBenchmark::Connect(PreviousNode, PreviousPinName, TalkNode);
+
+		PreviousNode = TalkNode;
+		PreviousPinName = UFlowNode_YapDialogue::OutputPinName;
+	}
+
+	UFlowGraphNode* CloseNode = YapBenchmark::AddNode(Asset, UFlowNode_YapConversation_Close::StaticClass());
+
+	bConnected &= YapBenchmark::Connect(PreviousNode, PreviousPinName, CloseNode);
+
+	// Closing asks for the next turn straight away, behind every conversation already waiting
+	bConnected &= YapBenchmark::Connect(CloseNode, UFlowNode::DefaultOutputPin.PinName, OpenNode);
+
+	if (!bConnected)
+	{
+		return nullptr;
+	}
+
+	Asset->HarvestNodeConnections();
+
+	OpenNodeGuids.Add(Open->GetGuid());
+
+	return Asset;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+UFlowAsset* FYapBenchmarkHarness::BuildBarkTemplate(FRandomStream& Random)
+{
+	UFlowAsset* Asset = YapBenchmark::NewFlowAsset(TEXT("YapBenchmarkBark"));
+
+	UFlowGraphNode* StartNode = YapBenchmark::FindOrAddStartNode(Asset);
+	UFlowGraphNode* FirstNode = AddTalkNode(Asset, Random);
+	UFlowGraphNode* SecondNode = AddTalkNode(Asset, Random);
+
+	bool bConnected = YapBenchmark::Connect(StartNode, UFlowNode::DefaultOutputPin.PinName, FirstNode);
+	bConnected &= YapBenchmark::Connect(FirstNode, UFlowNode_YapDialogue::OutputPinName, SecondNode);
+	bConnected &= YapBenchmark::Connect(SecondNode, UFlowNode_YapDialogue::OutputPinName, FirstNode);
+
+	if (!bConnected)
+	{
+		return nullptr;
+	}
+
+	Asset->HarvestNodeConnections();
+
+	return Asset;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+UFlowGraphNode* FYapBenchmarkHarness::AddTalkNode(UFlowAsset* Asset, FRandomStream& Random)
+{
+	UFlowGraphNode* GraphNode = YapBenchmark::AddNode(Asset, UFlowNode_YapDialogue::StaticClass());
+	UFlowNode_YapDialogue* DialogueNode = CastChecked<UFlowNode_YapDialogue>(GraphNode->GetFlowNodeBase());
+
+	TArray<FYapFragment>& Fragments = DialogueNode->GetFragmentsMutable();
+	
+	Fragments.SetNum(Random.RandRange(1, 3));
+
+	for (int32 i = 0; i < Fragments.Num(); ++i)
+	{
+		FYapFragment& Fragment = Fragments[i];
+		
+		Fragment.SetIndexInDialogue(i);
+		Fragment.SetTimeModeSetting(EYapTimeMode::ManualTime);
+
+		FYapBit& Bit = Fragment.GetMatureBitMutable();
+		Bit.SetDialogueText(LOCTEXT("YapBenchmark_DialogueText", "The quick brown fox jumps over the lazy dog."));
+		Bit.SetManualTime(Random.FRandRange(0.5f, 4.0f));
+	}
+
+	DialogueNode->ForceReconstruction();
+
+	return GraphNode;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::StartFlow(const FPendingStart& PendingStart)
+{
+	UObject* Owner = FlowOwners.Add_GetRef(NewObject<UYapBenchmarkHandler>(World));
+
+	if (!PendingStart.bConversation)
+	{
+		FlowSubsystem->StartRootFlow(Owner, BarkTemplates[PendingStart.TemplateIndex], true);
+		return;
+	}
+
+	FlowSubsystem->StartRootFlow(Owner, ConversationTemplates[PendingStart.TemplateIndex], true);
+
+	if (UFlowAsset* Flow = FlowSubsystem->GetRootFlow(Owner))
+	{
+		FConversationFlow& ConversationFlow = ConversationFlows.AddDefaulted_GetRef();
+		ConversationFlow.Flow = Flow;
+		ConversationFlow.OpenNode = Cast<UFlowNode_YapConversation_Open>(Flow->GetNode(OpenNodeGuids[PendingStart.TemplateIndex]));
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::RetryDroppedConversations()
+{
+	// Dropped requests ask again here rather than through a Dropped -> Open connection, because the Dropped pin fires while the subsystem is still removing the request
+	for (const FConversationFlow& ConversationFlow : ConversationFlows)
+	{
+		if (ConversationFlow.OpenNode && !UYapSubsystem::GetConversationByOwner(World, ConversationFlow.Flow))
+		{
+			ConversationFlow.OpenNode->ExecuteInput(UFlowNode::DefaultInputPin.PinName);
+		}
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+void FYapBenchmarkHarness::SampleMemory(FYapBenchmarkResults& Results) const
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+	FLowLevelMemTracker& Tracker = FLowLevelMemTracker::Get();
+
+	if (Tracker.IsEnabled())
+	{
+		// Normally done by the engine loop, which the benchmark steps around
+		Tracker.UpdateStatsPerFrame();
+
+		const int64 Bytes = Tracker.GetTagAmountForTracker(ELLMTracker::Default, FName(TEXT("Yap")), ELLMTagSet::None);
+
+		if (Results.LLMStartBytes == INDEX_NONE)
+		{
+			Results.LLMStartBytes = Bytes;
+		}
+
+		Results.LLMPeakBytes = FMath::Max(Results.LLMPeakBytes, Bytes);
+		Results.LLMEndBytes = Bytes;
+	}
+#endif
+
+	Results.PeakUsedPhysical = FPlatformMemory::GetStats().PeakUsedPhysical;
+}
+
+#undef LOCTEXT_NAMESPACE
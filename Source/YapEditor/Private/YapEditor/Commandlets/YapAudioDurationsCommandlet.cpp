@@ -0,0 +1,153 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "YapEditor/Commandlets/YapAudioDurationsCommandlet.h"
+
+#include "FlowAsset.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "Misc/PackageName.h"
+#include "Misc/SecureHash.h"
+#include "UObject/UObjectGlobals.h"
+#include "Yap/YapAudioDurationCache.h"
+#include "Yap/YapBit.h"
+#include "Yap/YapNullAudioBroker.h"
+#include "Yap/YapSubsystem.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+#include "YapEditor/YapEditorLog.h"
+
+#define LOCTEXT_NAMESPACE "YapEditor"
+
+UYapAudioDurationsCommandlet::UYapAudioDurationsCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UYapAudioDurationsCommandlet::Main(const FString& Params)
+{
+	const bool bNullAudio = FParse::Param(*Params, TEXT("NullAudio"));
+	const bool bFull = FParse::Param(*Params, TEXT("Full"));
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> FlowAssets;
+	AssetRegistry.GetAssetsByClass(UFlowAsset::StaticClass()->GetClassPathName(), FlowAssets, true);
+
+	// Every audio asset referenced by any bit
+	TSet<FSoftObjectPath> AudioAssetSet;
+
+	for (const FAssetData& AssetData : FlowAssets)
+	{
+		const UFlowAsset* FlowAsset = Cast<UFlowAsset>(AssetData.GetAsset());
+
+		if (!IsValid(FlowAsset))
+		{
+			UE_LOG(LogYapEditor, Warning, TEXT("Could not load flow asset <%s>, skipping."), *AssetData.GetObjectPathString());
+			continue;
+		}
+
+		for (const auto& [Guid, Node] : FlowAsset->GetNodes())
+		{
+			if (const UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(Node))
+			{
+				for (const FYapFragment& Fragment : DialogueNode->GetFragments())
+				{
+					for (const FYapBit* Bit : { &Fragment.GetMatureBit(), &Fragment.GetChildSafeBit() })
+					{
+						const FSoftObjectPath AudioAsset = Bit->GetDialogueAudioAsset_SoftPtr<UObject>().ToSoftObjectPath();
+
+						if (AudioAsset.IsValid())
+						{
+							AudioAssetSet.Add(AudioAsset);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	const TArray<FSoftObjectPath> AudioAssets = AudioAssetSet.Array();
+
+	// Hashing package files is the bulk of the work when little changed, and is safe to do off the game thread
+	TArray<FString> PackageHashes;
+	PackageHashes.SetNum(AudioAssets.Num());
+
+	ParallelFor(AudioAssets.Num(), [&AudioAssets, &PackageHashes] (int32 i)
+	{
+		FString PackageFilename;
+
+		if (FPackageName::DoesPackageExist(AudioAssets[i].GetLongPackageName(), &PackageFilename))
+		{
+			PackageHashes[i] = LexToString(FMD5Hash::HashFile(*PackageFilename));
+		}
+	});
+
+	FYapAudioDurationCache& Cache = FYapAudioDurationCache::Get();
+
+	TArray<int32> StaleAssets;
+
+	for (int32 i = 0; i < AudioAssets.Num(); ++i)
+	{
+		if (PackageHashes[i].IsEmpty())
+		{
+			UE_LOG(LogYapEditor, Warning, TEXT("Audio asset <%s> does not exist, skipping."), *AudioAssets[i].ToString());
+			continue;
+		}
+
+		const FString* CachedHash = Cache.FindHash(AudioAssets[i]);
+
+		if (bFull || !CachedHash || *CachedHash != PackageHashes[i])
+		{
+			StaleAssets.Add(i);
+		}
+	}
+
+	// Load everything stale in one batch so the loader can overlap the reads
+	for (int32 i : StaleAssets)
+	{
+		LoadPackageAsync(AudioAssets[i].GetLongPackageName());
+	}
+
+	FlushAsyncLoading();
+
+	const UYapBroker* Broker = bNullAudio ? GetDefault<UYapNullAudioBroker>() : &UYapSubsystem::GetBroker_Editor();
+
+	int32 NumFailed = 0;
+
+	for (int32 i : StaleAssets)
+	{
+		const UObject* AudioAsset = AudioAssets[i].ResolveObject();
+
+		const float Duration = Broker->GetAudioAssetDuration(AudioAsset);
+
+		if (Duration < 0.0f)
+		{
+			UE_LOG(LogYapEditor, Warning, TEXT("Could not resolve the duration of audio asset <%s>."), *AudioAssets[i].ToString());
+			++NumFailed;
+			continue;
+		}
+
+		Cache.Set(AudioAssets[i], Duration, PackageHashes[i]);
+	}
+
+	const int32 NumPruned = Cache.Prune(AudioAssetSet);
+
+	UE_LOG(LogYapEditor, Display, TEXT("Checked %i audio assets in %.2f seconds; %i resolved, %i failed, %i unused entries removed."), AudioAssets.Num(), FPlatformTime::Seconds() - StartTime, StaleAssets.Num() - NumFailed, NumFailed, NumPruned);
+
+	if (!Cache.Save())
+	{
+		UE_LOG(LogYapEditor, Error, TEXT("Failed to write <%s>!"), *FYapAudioDurationCache::GetFilename());
+		return 1;
+	}
+
+	return 0;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,52 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "YapEditor/Commandlets/YapBenchmarkCommandlet.h"
+
+#include "YapEditor/YapEditorLog.h"
+#include "YapEditor/Benchmark/YapBenchmarkHarness.h"
+
+#define LOCTEXT_NAMESPACE "YapEditor"
+
+UYapBenchmarkCommandlet::UYapBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UYapBenchmarkCommandlet::Main(const FString& Params)
+{
+	FYapBenchmarkSettings Settings;
+	float MaxP99Us = 0.0f;
+
+	FParse::Value(*Params, TEXT("Conversations="), Settings.NumConversations);
+	FParse::Value(*Params, TEXT("Barks="), Settings.NumBarks);
+	FParse::Value(*Params, TEXT("Seconds="), Settings.Seconds);
+	FParse::Value(*Params, TEXT("Seed="), Settings.Seed);
+	FParse::Value(*Params, TEXT("FreeSpeechBudget="), Settings.FreeSpeechBudget);
+	FParse::Value(*Params, TEXT("ConversationTimeout="), Settings.ConversationTimeout);
+	FParse::Value(*Params, TEXT("MaxP99Us="), MaxP99Us);
+
+	FYapBenchmarkResults Results;
+
+	if (!FYapBenchmarkHarness(Settings).Run(Results))
+	{
+		return 1;
+	}
+
+	Results.Log(Settings);
+
+	const double P99 = Results.GetLatencyPercentile(0.99);
+
+	if (MaxP99Us > 0.0f && P99 > MaxP99Us)
+	{
+		UE_LOG(LogYapEditor, Error, TEXT("p99 RunSpeech latency %.2fus exceeds the limit of %.2fus!"), P99, MaxP99Us);
+		return 1;
+	}
+
+	return 0;
+}
+
+#undef LOCTEXT_NAMESPACE
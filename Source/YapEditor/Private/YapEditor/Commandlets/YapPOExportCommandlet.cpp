@@ -0,0 +1,372 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "YapEditor/Commandlets/YapPOExportCommandlet.h"
+
+#include "FlowAsset.h"
+#include "Algo/Sort.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Internationalization/TextNamespaceUtil.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Yap/YapBit.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+#include "YapEditor/YapEditorLog.h"
+
+#define LOCTEXT_NAMESPACE "YapEditor"
+
+namespace YapPOExport
+{
+	static const TCHAR* ManifestFilename = TEXT("YapPOExport.manifest");
+
+	static const TCHAR* ChangedFilename = TEXT("Changed.po");
+
+	struct FEntry
+	{
+		FString Context;
+
+		uint32 Hash = 0;
+
+		FString Block;
+	};
+
+	struct FAsset
+	{
+		FName PackageName;
+
+		FDateTime TimeStamp;
+
+		int64 FileSize = 0;
+
+		/** Null if the asset did not change since the last run. */
+		UFlowAsset* FlowAsset = nullptr;
+
+		TArray<FEntry> Entries;
+	};
+
+	struct FManifestAsset
+	{
+		FDateTime TimeStamp;
+
+		int64 FileSize = 0;
+
+		TMap<FString, uint32> EntryHashes;
+	};
+
+	static FString Escape(const FString& String)
+	{
+		FString Result = String.Replace(TEXT("\\"), TEXT("\\\\"));
+		Result.ReplaceInline(TEXT("\""), TEXT("\\\""));
+		Result.ReplaceInline(TEXT("\r"), TEXT(""));
+		Result.ReplaceInline(TEXT("\n"), TEXT("\\n"));
+		Result.ReplaceInline(TEXT("\t"), TEXT("\\t"));
+		return Result;
+	}
+
+	static void AppendComment(FString& Block, const TCHAR* Prefix, const FString& Comment)
+	{
+		TArray<FString> Lines;
+		Comment.ParseIntoArrayLines(Lines, true);
+
+		for (const FString& Line : Lines)
+		{
+			Block += FString::Printf(TEXT("%s %s\n"), Prefix, *Line);
+		}
+	}
+
+	static FString GetPOFilename(const FString& OutputDir, FName PackageName)
+	{
+		FString Name = PackageName.ToString();
+		Name.RemoveFromStart(TEXT("/"));
+		Name.ReplaceCharInline(TEXT('/'), TEXT('_'));
+
+		return OutputDir / Name + TEXT(".po");
+	}
+
+	static void AddEntry(TArray<FEntry>& Entries, const FText& Text, const FString& SourceLocation, const FString& Comments, const FString& StageDirections, const FYapBit& Bit)
+	{
+		const FString* Source = FTextInspector::GetSourceString(Text);
+		const TOptional<FString> Namespace = FTextInspector::GetNamespace(Text);
+		const TOptional<FString> Key = FTextInspector::GetKey(Text);
+
+		if (!Source || Source->IsEmpty() || !Key.IsSet() || !Text.ShouldGatherForLocalization())
+		{
+			return;
+		}
+
+		FEntry& Entry = Entries.AddDefaulted_GetRef();
+		Entry.Context = TextNamespaceUtil::StripPackageNamespace(Namespace.Get(FString())) + TEXT(",") + Key.GetValue();
+
+		FString& Block = Entry.Block;
+		Block += FString::Printf(TEXT("#. Key:\t%s\n"), *Key.GetValue());
+		Block += FString::Printf(TEXT("#. SourceLocation:\t%s\n"), *SourceLocation);
+		AppendComment(Block, TEXT("#."), Comments);
+		AppendComment(Block, TEXT("#. Stage directions:"), StageDirections);
+		Block += FString::Printf(TEXT("#: %s\n"), *SourceLocation);
+
+		if (Bit.GetPreviousMsgctxt().Num() > 0)
+		{
+			Block += FString::Printf(TEXT("#| msgctxt \"%s\"\n"), *Escape(Bit.GetPreviousMsgctxt().Last()));
+		}
+
+		if (Bit.GetPreviousMsgid().Num() > 0)
+		{
+			Block += FString::Printf(TEXT("#| msgid \"%s\"\n"), *Escape(Bit.GetPreviousMsgid().Last()));
+		}
+
+		Block += FString::Printf(TEXT("msgctxt \"%s\"\n"), *Escape(Entry.Context));
+		Block += FString::Printf(TEXT("msgid \"%s\"\n"), *Escape(*Source));
+		Block += TEXT("msgstr \"\"\n\n");
+
+		Entry.Hash = FCrc::StrCrc32(*Block);
+	}
+
+	static void GatherEntries(FAsset& Asset)
+	{
+		const FString AssetPath = Asset.FlowAsset->GetPathName();
+
+		TArray<const UFlowNode_YapDialogue*> DialogueNodes;
+
+		for (const auto& [Guid, Node] : Asset.FlowAsset->GetNodes())
+		{
+			if (const UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(Node))
+			{
+				DialogueNodes.Add(DialogueNode);
+			}
+		}
+
+		// Node map order is not stable between loads; keep the output diffable
+		Algo::SortBy(DialogueNodes, &UFlowNode_YapDialogue::GetGuid);
+
+		for (const UFlowNode_YapDialogue* DialogueNode : DialogueNodes)
+		{
+			const TArray<FYapFragment>& Fragments = DialogueNode->GetFragments();
+
+			for (int32 i = 0; i < Fragments.Num(); ++i)
+			{
+				for (const bool bMature : { true, false })
+				{
+					const FYapBit& Bit = bMature ? Fragments[i].GetMatureBit() : Fragments[i].GetChildSafeBit();
+					const FString BitPath = FString::Printf(TEXT("%s.%s.Fragments[%i].%s"), *AssetPath, *DialogueNode->GetName(), i, bMature ? TEXT("MatureBit") : TEXT("ChildSafeBit"));
+
+					AddEntry(Asset.Entries, Bit.GetDialogueText(), BitPath + TEXT(".DialogueText"), Bit.GetDialogueLocalizationComments(), Bit.GetStageDirections(), Bit);
+					AddEntry(Asset.Entries, Bit.GetTitleText(), BitPath + TEXT(".TitleText"), Bit.GetTitleTextLocalizationComments(), FString(), Bit);
+				}
+			}
+		}
+	}
+
+	static FString MakePOHeader()
+	{
+		return TEXT("# Yap dialogue export\nmsgid \"\"\nmsgstr \"\"\n\"Content-Type: text/plain; charset=UTF-8\\n\"\n\n");
+	}
+
+	static void LoadManifest(const FString& Filename, TMap<FName, FManifestAsset>& OutManifest)
+	{
+		TArray<FString> Lines;
+
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Filename))
+		{
+			return;
+		}
+
+		FManifestAsset* Current = nullptr;
+
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Fields;
+			Line.ParseIntoArray(Fields, TEXT("\t"), false);
+
+			if (Fields.Num() == 4 && Fields[0] == TEXT("P"))
+			{
+				Current = &OutManifest.Add(FName(Fields[1]));
+				Current->TimeStamp = FDateTime(FCString::Atoi64(*Fields[2]));
+				Current->FileSize = FCString::Atoi64(*Fields[3]);
+			}
+			else if (Fields.Num() == 3 && Fields[0] == TEXT("E") && Current)
+			{
+				Current->EntryHashes.Add(Fields[1], static_cast<uint32>(FCString::Strtoui64(*Fields[2], nullptr, 10)));
+			}
+		}
+	}
+
+	static bool SaveManifest(const FString& Filename, const TMap<FName, FManifestAsset>& Manifest)
+	{
+		FString Output;
+
+		for (const auto& [PackageName, Asset] : Manifest)
+		{
+			Output += FString::Printf(TEXT("P\t%s\t%lld\t%lld\n"), *PackageName.ToString(), Asset.TimeStamp.GetTicks(), Asset.FileSize);
+
+			for (const auto& [Context, Hash] : Asset.EntryHashes)
+			{
+				Output += FString::Printf(TEXT("E\t%s\t%u\n"), *Context, Hash);
+			}
+		}
+
+		return FFileHelper::SaveStringToFile(Output, *Filename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	}
+}
+
+// ================================================================================================
+
+UYapPOExportCommandlet::UYapPOExportCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UYapPOExportCommandlet::Main(const FString& Params)
+{
+	using namespace YapPOExport;
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	const bool bFull = FParse::Param(*Params, TEXT("Full"));
+
+	FString OutputDir;
+
+	if (!FParse::Value(*Params, TEXT("Output="), OutputDir))
+	{
+		OutputDir = FPaths::ProjectSavedDir() / TEXT("Yap") / TEXT("Localization");
+	}
+
+	const FString ManifestPath = OutputDir / ManifestFilename;
+
+	TMap<FName, FManifestAsset> OldManifest;
+
+	if (!bFull)
+	{
+		LoadManifest(ManifestPath, OldManifest);
+	}
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> FlowAssets;
+	AssetRegistry.GetAssetsByClass(UFlowAsset::StaticClass()->GetClassPathName(), FlowAssets, true);
+
+	TArray<FAsset> Assets;
+	Assets.Reserve(FlowAssets.Num());
+
+	TArray<int32> ChangedAssets;
+
+	// Only packages saved since the last run need to be loaded; loading has to happen on the game thread
+	for (const FAssetData& AssetData : FlowAssets)
+	{
+		FString PackageFilename;
+
+		if (!FPackageName::DoesPackageExist(AssetData.PackageName.ToString(), &PackageFilename))
+		{
+			continue;
+		}
+
+		const FFileStatData StatData = IFileManager::Get().GetStatData(*PackageFilename);
+
+		FAsset& Asset = Assets.AddDefaulted_GetRef();
+		Asset.PackageName = AssetData.PackageName;
+		Asset.TimeStamp = StatData.ModificationTime;
+		Asset.FileSize = StatData.FileSize;
+
+		const FManifestAsset* Previous = OldManifest.Find(Asset.PackageName);
+
+		if (Previous && Previous->TimeStamp == Asset.TimeStamp && Previous->FileSize == Asset.FileSize && IFileManager::Get().FileExists(*GetPOFilename(OutputDir, Asset.PackageName)))
+		{
+			continue;
+		}
+
+		Asset.FlowAsset = Cast<UFlowAsset>(AssetData.GetAsset());
+
+		if (!IsValid(Asset.FlowAsset))
+		{
+			UE_LOG(LogYapEditor, Warning, TEXT("Could not load flow asset <%s>, skipping."), *AssetData.GetObjectPathString());
+			Assets.Pop(EAllowShrinking::No);
+			continue;
+		}
+
+		ChangedAssets.Add(Assets.Num() - 1);
+	}
+
+	ParallelFor(ChangedAssets.Num(), [&Assets, &ChangedAssets] (int32 i)
+	{
+		GatherEntries(Assets[ChangedAssets[i]]);
+	});
+
+	TMap<FName, FManifestAsset> NewManifest;
+	NewManifest.Reserve(Assets.Num());
+
+	FString ChangedPO = MakePOHeader();
+	int32 NumChangedEntries = 0;
+	int32 NumWrittenFiles = 0;
+	bool bSuccess = true;
+
+	for (const FAsset& Asset : Assets)
+	{
+		const FManifestAsset* Previous = OldManifest.Find(Asset.PackageName);
+
+		if (!Asset.FlowAsset)
+		{
+			NewManifest.Add(Asset.PackageName, *Previous);
+			continue;
+		}
+
+		FManifestAsset& Current = NewManifest.Add(Asset.PackageName);
+		Current.TimeStamp = Asset.TimeStamp;
+		Current.FileSize = Asset.FileSize;
+
+		bool bAssetChanged = !Previous || Previous->EntryHashes.Num() != Asset.Entries.Num();
+
+		FString AssetPO = MakePOHeader();
+
+		for (const FEntry& Entry : Asset.Entries)
+		{
+			Current.EntryHashes.Add(Entry.Context, Entry.Hash);
+			AssetPO += Entry.Block;
+
+			const uint32* PreviousHash = Previous ? Previous->EntryHashes.Find(Entry.Context) : nullptr;
+
+			if (!PreviousHash || *PreviousHash != Entry.Hash)
+			{
+				ChangedPO += Entry.Block;
+				++NumChangedEntries;
+				bAssetChanged = true;
+			}
+		}
+
+		const FString POFilename = GetPOFilename(OutputDir, Asset.PackageName);
+
+		if (bAssetChanged || !IFileManager::Get().FileExists(*POFilename))
+		{
+			if (!FFileHelper::SaveStringToFile(AssetPO, *POFilename, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+			{
+				UE_LOG(LogYapEditor, Error, TEXT("Failed to write <%s>!"), *POFilename);
+				bSuccess = false;
+			}
+
+			++NumWrittenFiles;
+		}
+	}
+
+	// Flow assets which were deleted or renamed since the last run
+	for (const auto& [PackageName, Previous] : OldManifest)
+	{
+		if (!NewManifest.Contains(PackageName))
+		{
+			IFileManager::Get().Delete(*GetPOFilename(OutputDir, PackageName), false, false, true);
+		}
+	}
+
+	bSuccess &= FFileHelper::SaveStringToFile(ChangedPO, *(OutputDir / ChangedFilename), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
+	bSuccess &= SaveManifest(ManifestPath, NewManifest);
+
+	UE_LOG(LogYapEditor, Display, TEXT("Exported %i flow assets (%i loaded, %i .po files written) in %.2f seconds; %i entries new or changed."), Assets.Num(), ChangedAssets.Num(), NumWrittenFiles, FPlatformTime::Seconds() - StartTime, NumChangedEntries);
+
+	return bSuccess ? 0 : 1;
+}
+
+#undef LOCTEXT_NAMESPACE
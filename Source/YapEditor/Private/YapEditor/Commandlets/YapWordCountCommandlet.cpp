@@ -0,0 +1,124 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license. 
+
+#include "YapEditor/Commandlets/YapWordCountCommandlet.h"
+
+#include "FileHelpers.h"
+#include "FlowAsset.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Yap/YapProjectSettings.h"
+#include "Yap/YapText.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
+#include "YapEditor/YapEditorLog.h"
+
+#define LOCTEXT_NAMESPACE "YapEditor"
+
+UYapWordCountCommandlet::UYapWordCountCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UYapWordCountCommandlet::Main(const FString& Params)
+{
+	const bool bSave = !FParse::Param(*Params, TEXT("NoSave"));
+
+	// Same as when text is assigned; the project may be setting word counts itself
+	if (!UYapProjectSettings::CacheFragmentWordCountAutomatically())
+	{
+		UE_LOG(LogYapEditor, Display, TEXT("Caching word counts is turned off in the Yap project settings (Prevent Caching Word Count), nothing to do."));
+		return 0;
+	}
+	
+	const double StartTime = FPlatformTime::Seconds();
+	
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	TArray<FAssetData> FlowAssets;
+	AssetRegistry.GetAssetsByClass(UFlowAsset::StaticClass()->GetClassPathName(), FlowAssets, true);
+
+	// Gather every text up front so they can all be counted in a single batch
+	TArray<FYapText*> Texts;
+	TArray<int32> OldWordCounts;
+	TArray<int32> TextPackageIndices;
+	TArray<UPackage*> Packages;
+	
+	for (const FAssetData& AssetData : FlowAssets)
+	{
+		UFlowAsset* FlowAsset = Cast<UFlowAsset>(AssetData.GetAsset());
+
+		if (!IsValid(FlowAsset))
+		{
+			UE_LOG(LogYapEditor, Warning, TEXT("Could not load flow asset <%s>, skipping."), *AssetData.GetObjectPathString());
+			continue;
+		}
+
+		const int32 FirstText = Texts.Num();
+		
+		for (const auto& [Guid, Node] : FlowAsset->GetNodes())
+		{
+			if (UFlowNode_YapDialogue* DialogueNode = Cast<UFlowNode_YapDialogue>(Node))
+			{
+				for (FYapFragment& Fragment : DialogueNode->GetFragmentsMutable())
+				{
+					Fragment.GatherTexts(Texts);
+				}
+			}
+		}
+
+		if (Texts.Num() > FirstText)
+		{
+			const int32 PackageIndex = Packages.Add(FlowAsset->GetPackage());
+			
+			TextPackageIndices.Reserve(Texts.Num());
+			
+			for (int32 i = FirstText; i < Texts.Num(); ++i)
+			{
+				TextPackageIndices.Add(PackageIndex);
+			}
+		}
+	}
+
+	OldWordCounts.Reserve(Texts.Num());
+
+	for (const FYapText* Text : Texts)
+	{
+		OldWordCounts.Add(Text->GetWordCount());
+	}
+
+	const int32 NumChanged = FYapText::UpdateInternalWordCounts(Texts);
+
+	TSet<UPackage*> ChangedPackages;
+
+	for (int32 i = 0; i < Texts.Num(); ++i)
+	{
+		if (Texts[i]->GetWordCount() != OldWordCounts[i])
+		{
+			ChangedPackages.Add(Packages[TextPackageIndices[i]]);
+		}
+	}
+
+	UE_LOG(LogYapEditor, Display, TEXT("Counted words of %i texts in %i flow assets in %.2f seconds; %i counts changed in %i assets."), Texts.Num(), Packages.Num(), FPlatformTime::Seconds() - StartTime, NumChanged, ChangedPackages.Num());
+
+	if (bSave && ChangedPackages.Num() > 0)
+	{
+		for (UPackage* Package : ChangedPackages)
+		{
+			Package->MarkPackageDirty();
+		}
+
+		if (!UEditorLoadingAndSavingUtils::SavePackages(ChangedPackages.Array(), true))
+		{
+			UE_LOG(LogYapEditor, Error, TEXT("Failed to save one or more flow assets!"));
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -121,10 +121,19 @@ void UFlowGraphNode_YapDialogue::GetNodeContextMenuActions(class UToolMenu* Menu
 
 void UFlowGraphNode_YapDialogue::RecalculateTextOnAllFragments()
 {
+	// Same as when text is assigned; the project may be setting word counts itself
+	if (!UYapProjectSettings::CacheFragmentWordCountAutomatically())
+	{
+		UE_LOG(LogYapEditor, Warning, TEXT("Word counts were not recalculated, caching them is turned off in the Yap project settings (Prevent Caching Word Count)."));
+		return;
+	}
+
 	FGraphPanelSelectionSet Nodes = FFlowGraphUtils::GetFlowGraphEditor(GetGraph())->GetSelectedNodes();
 	
 	FYapScopedTransaction T(FName("Default"), FText::Format(LOCTEXT("RecalculateTextLength_Command","Recalculate text length on {0} {0}|plural(one=node,other=nodes)"), Nodes.Num()), nullptr);
 
+	TArray<FYapText*> Texts;
+	
 	for (UObject* Node : Nodes)
 	{
 		if (UFlowGraphNode_YapDialogue* DialogeGraphNode = Cast<UFlowGraphNode_YapDialogue>(Node))
@@ -134,11 +143,13 @@ void UFlowGraphNode_YapDialogue::RecalculateTextOnAllFragments()
 
 			for (FYapFragment& Fragment : DialogueNode2->GetFragmentsMutable())
 			{
-				// TODO
-				// Fragment.GetBitMutable().RecacheSpeakingTime();
+				Fragment.GatherTexts(Texts);
 			}
 		}
 	}
+
+	// Count them all in one batch; the broker can spread the work across threads
+	FYapText::UpdateInternalWordCounts(Texts);
 }
 
 void UFlowGraphNode_YapDialogue::AutoAssignAudioOnAllNodes()
@@ -172,8 +172,7 @@ void SFlowGraphNode_YapDialogueWidget::OnTextChanged_DialogueID(const FText& New
 // ------------------------------------------------------------------------------------------------
 FOptionalSize SFlowGraphNode_YapDialogueWidget::GetMaxNodeWidth() const
 {
-	const float GraphGridSize = 16;
-	return FMath::Max(YAP_MIN_NODE_WIDTH + GetNodeConfig().GetPortraitSize(), YAP_DEFAULT_NODE_WIDTH + GraphGridSize * GetNodeConfig().GetDialogueWidthAdjustment());
+	return GetCache().MaxNodeWidth;
 }
 
 // ------------------------------------------------------------------------------------------------
@@ -365,11 +364,11 @@ TSharedRef<SWidget> SFlowGraphNode_YapDialogueWidget::CreateNodeContentArea()
 			// This is a helper identification bar on the left of the node, colored for the type group. Invisible for default type group.
 			SNew(SBox)
 			.WidthOverride(4)
-			.Visibility_Lambda( [this] () { return GetFlowYapDialogueNode()->GetNodeConfig().GetGroupColor().IsSet() ? EVisibility::HitTestInvisible : EVisibility::Collapsed; })
+			.Visibility_Lambda( [this] () { return GetCache().GroupColor.IsSet() ? EVisibility::HitTestInvisible : EVisibility::Collapsed; })
 			[
 				SNew(SImage)
 				.Image(FYapEditorStyle::GetImageBrush(YapBrushes.Box_SolidWhite))
-				.ColorAndOpacity_Lambda( [this] () { return GetFlowYapDialogueNode()->GetNodeConfig().GetGroupColor().Get(YapColor::White).Desaturate(0.25F); }) // Epic's Desaturate command sets opacity as well, which I want for this
+				.ColorAndOpacity_Lambda( [this] () { return GetCache().GroupColor.Get(YapColor::White).Desaturate(0.25F); }) // Epic's Desaturate command sets opacity as well, which I want for this
 			]
 		]
 		+ SOverlay::Slot()
@@ -701,32 +700,66 @@ TSharedRef<SWidget> SFlowGraphNode_YapDialogueWidget::CreateFragmentBoxes()
 // ------------------------------------------------------------------------------------------------
 FText SFlowGraphNode_YapDialogueWidget::Text_NodeHeader() const
 {
+	return GetCache().NodeHeaderText;
+}
+
+FText SFlowGraphNode_YapDialogueWidget::Text_GroupLabel() const
+{
+	return GetCache().GroupLabelText;
+}
+
+// ------------------------------------------------------------------------------------------------
+const FYapDialogueWidgetCache& SFlowGraphNode_YapDialogueWidget::GetCache() const
+{
+	if (Cache.Frame != GFrameCounter)
+	{
+		Cache.Frame = GFrameCounter;
+
+		if (Cache.Revision != UYapEditorSubsystem::GetGraphDataRevision())
+		{
+			RefreshCache();
+		}
+	}
+
+	return Cache;
+}
+
+void SFlowGraphNode_YapDialogueWidget::RefreshCache() const
+{
+	const UYapNodeConfig& NodeConfig = GetNodeConfig();
+
+	Cache.Revision = UYapEditorSubsystem::GetGraphDataRevision();
+
+	const float GraphGridSize = 16;
+	Cache.MaxNodeWidth = FMath::Max(YAP_MIN_NODE_WIDTH + NodeConfig.GetPortraitSize(), YAP_DEFAULT_NODE_WIDTH + GraphGridSize * NodeConfig.GetDialogueWidthAdjustment());
+
+	Cache.GroupColor = NodeConfig.GetGroupColor();
+	Cache.GroupLabelText = NodeConfig.General.NodeLabel;
+
 	switch (GetFlowYapDialogueNode()->GetNodeType())
 	{
 		case EYapDialogueNodeType::Talk:
 		{
-			return GetNodeConfig().GetTalkModeTitle();
+			Cache.NodeHeaderText = NodeConfig.GetTalkModeTitle();
+			break;
 		}
 		case EYapDialogueNodeType::TalkAndAdvance:
 		{
-			return GetNodeConfig().GetTalkAndAdvanceModeTitle();
+			Cache.NodeHeaderText = NodeConfig.GetTalkAndAdvanceModeTitle();
+			break;
 		}
 		case EYapDialogueNodeType::PlayerPrompt:
 		{
-			return GetNodeConfig().GetPromptModeTitle();
+			Cache.NodeHeaderText = NodeConfig.GetPromptModeTitle();
+			break;
 		}
 		default:
 		{
-			return LOCTEXT("DialogueNodeHeaderButtonText_Error", "*** ERROR ***");
+			Cache.NodeHeaderText = LOCTEXT("DialogueNodeHeaderButtonText_Error", "*** ERROR ***");
 		}
 	}
 }
 
-FText SFlowGraphNode_YapDialogueWidget::Text_GroupLabel() const
-{
-	return GetFlowYapDialogueNode()->GetNodeConfig().General.NodeLabel;
-}
-
 // ------------------------------------------------------------------------------------------------
 TSharedRef<SWidget> SFlowGraphNode_YapDialogueWidget::CreateFragmentSeparatorWidget(uint8 FragmentIndex)
 {
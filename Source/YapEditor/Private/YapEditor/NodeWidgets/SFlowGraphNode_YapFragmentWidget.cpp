@@ -152,10 +152,10 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateCentreTextDisplayWid
 				.VAlign(VAlign_Top)
 				[
 					SNew(STextBlock)
-					.AutoWrapText_Lambda( [this] () { return !GetNodeConfig().GetPreventDialogueTextWrapping(); })
+					.AutoWrapText_Lambda( [this] () { return GetCache().bWrapDialogueText; })
 					.TextStyle(FYapEditorStyle::Get(), YapStyles.TextBlockStyle_DialogueText)
 					.Font(DialogueTextFont)
-					.Text_Lambda( [this] () { return GetFragment().GetDialogueText(GEditor->EditorWorld, GetDisplayMaturitySetting()); } )
+					.Text_Lambda( [this] () { return GetCache().DialogueText; } )
 					.ColorAndOpacity(this, &ThisClass::GetColorAndOpacityForFragmentText, YapColor::LightGray)
 				]
 			]
@@ -193,7 +193,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateCentreTextDisplayWid
 				[
 					SNew(STextBlock)
 					.TextStyle(FYapEditorStyle::Get(), YapStyles.TextBlockStyle_TitleText)
-					.Text_Lambda( [this] () { return GetFragment().GetTitleText(GEditor->EditorWorld, GetDisplayMaturitySetting()); } )
+					.Text_Lambda( [this] () { return GetCache().TitleText; } )
 					.ToolTipText(LOCTEXT("TitleTextDisplayWidget_ToolTipText", "Title text"))
 					.ColorAndOpacity(this, &ThisClass::GetColorAndOpacityForFragmentText, YapColor::YellowGray)
 				]
@@ -390,7 +390,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateFragmentHighlightWid
 
 EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_FragmentHighlight() const
 {
-	if (GetFragment().IsAwaitingManualAdvance() || FragmentRecentlyRan())
+	if (GetDialogueNode()->IsFragmentAwaitingManualAdvance(FragmentIndex) || FragmentRecentlyRan())
 	{
 		return EVisibility::HitTestInvisible;
 	}
@@ -415,7 +415,7 @@ FSlateColor SFlowGraphNode_YapFragmentWidget::BorderBackgroundColor_FragmentHigh
 		return YapColor::White_Glass;
 	}
 
-	if (GetFragment().IsAwaitingManualAdvance())
+	if (GetDialogueNode()->IsFragmentAwaitingManualAdvance(FragmentIndex))
 	{
 		return YapColor::Yellow_Glass;
 	}
@@ -434,12 +434,12 @@ FSlateColor SFlowGraphNode_YapFragmentWidget::BorderBackgroundColor_FragmentHigh
 	
 	UWorld* World = GEditor->GetCurrentPlayWorld(GEditor->PlayWorld);
 	
-	if (World)// && GetFragment().GetStartTime() >= 0.0)
+	if (World)// && GetFragmentStartTime() >= 0.0)
 	{
 		float MinOpaqueTime = 1.0f;
 		float FadeTime = 0.5f;
 
-		float EndTime = FMath::Max(GetFragment().GetStartTime() + MinOpaqueTime, GetFragment().GetEndTime());
+		float EndTime = FMath::Max(GetFragmentStartTime() + MinOpaqueTime, GetFragmentEndTime());
 
 		float Elapsed = World->GetTimeSeconds() - EndTime;
 
@@ -689,7 +689,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateFragmentWidget()
 		.Padding(0, 0, 0, 2)
 		[
 			SNew(SBox)
-			.Visibility_Lambda( [this] () { return GetNodeConfig().GetUsesChildSafe() ? EVisibility::Visible : EVisibility::Collapsed; } )
+			.Visibility_Lambda( [this] () { return GetCache().bUsesChildSafe ? EVisibility::Visible : EVisibility::Collapsed; } )
 			.WidthOverride(22)
 			.HeightOverride(22)
 			[
@@ -733,7 +733,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateFragmentWidget()
 		.Padding(0, 2, 0, 0)
 		[
 			SNew(SBox)
-			.Visibility_Lambda( [this] () { return GetNodeConfig().GetUsesMoodTags() ? EVisibility::Visible : EVisibility::Collapsed; } )
+			.Visibility_Lambda( [this] () { return GetCache().bUsesMoodTags ? EVisibility::Visible : EVisibility::Collapsed; } )
 			.WidthOverride(22)
 			.HeightOverride(22)
 			[
@@ -832,9 +832,9 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateFragmentWidget()
 						.FragmentIndex(FragmentIndex)
 						.BarColor(this, &ThisClass::ColorAndOpacity_FragmentTimeIndicator)
 						.PaddingIsSet(this, &ThisClass::Bool_PaddingTimeIsSet)
-						.SpeechTime_Lambda( [this] () { return GetDialogueNode()->GetSpeechTime(FragmentIndex, GetDisplayMaturitySetting(), EYapLoadContext::AsyncEditorOnly); } )
+						.SpeechTime_Lambda( [this] () { return GetCache().SpeechTime; } )
 						.PaddingTime_Lambda( [this] () { return GetDialogueNode()->GetPadding(FragmentIndex); } )
-						.MaxDisplayTime_Lambda( [this] () { return GetNodeConfig().GetDialogueTimeSliderMax(); } )
+						.MaxDisplayTime_Lambda( [this] () { return GetCache().DialogueTimeSliderMax; } )
 						.PlaybackTime_Lambda( [this] () { return Percent_FragmentTime(); } )
 					]
 				]
@@ -872,28 +872,95 @@ EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_AudioSettingsButton() c
 
 EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_DialogueErrorState() const
 {
-	if (!NeedsChildSafeData())
+	return GetCache().DialogueErrorVisibility;
+}
+
+FSlateColor SFlowGraphNode_YapFragmentWidget::ColorAndOpacity_AudioIDText() const
+{
+	FLinearColor Color = GetCache().AudioIDTextColor;
+	
+	if (AudioIDButton.IsValid() && AudioIDButton->IsHovered())
 	{
-		return EVisibility::Collapsed;
+		Color /= YapColor::LightGray;
 	}
 
-	const FYapBit& MatureBit = GetFragment().GetMatureBit();
-	const FYapBit& ChildSafeBit = GetFragment().GetChildSafeBit();
-	
-	if (MatureBit.HasDialogueText() != ChildSafeBit.HasDialogueText())
+	return Color;
+}
+
+FText SFlowGraphNode_YapFragmentWidget::Text_AudioIDLabel() const
+{
+	//GetFragment().GetAudioID();
+
+	return FText::GetEmpty();
+}
+
+EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_TimeProgressionWidget() const
+{
+	return GetCache().TimeProgressionVisibility;
+}
+
+// ================================================================================================
+// ATTRIBUTE CACHE
+// ------------------------------------------------------------------------------------------------
+
+const FYapFragmentWidgetCache& SFlowGraphNode_YapFragmentWidget::GetCache() const
+{
+	if (Cache.Frame == GFrameCounter)
 	{
-		return EVisibility::Visible;
+		return Cache;
 	}
 
-	return EVisibility::Collapsed;
+	Cache.Frame = GFrameCounter;
+
+	const uint32 Revision = UYapEditorSubsystem::GetGraphDataRevision();
+	const EYapMaturitySetting Maturity = GetDisplayMaturitySetting();
+
+	// During PIE, bit replacements and the game's maturity setting change without touching any asset. The expanded dialogue editor edits text as it is typed.
+	if (Cache.Revision != Revision || Cache.Maturity != Maturity || Cache.bAudioPending || GEditor->PlayWorld || ExpandedDialogueEditor.IsValid())
+	{
+		RefreshCache();
+	}
+
+	return Cache;
 }
 
-FSlateColor SFlowGraphNode_YapFragmentWidget::ColorAndOpacity_AudioIDText() const
+void SFlowGraphNode_YapFragmentWidget::RefreshCache() const
 {
-	const TSoftObjectPtr<UObject>& MatureAudioAsset = GetFragment().GetMatureBit().AudioAsset;
-	const TSoftObjectPtr<UObject>& SafeAudioAsset = GetFragment().GetChildSafeBit().AudioAsset;
+	const UYapNodeConfig& NodeConfig = GetNodeConfig();
+	const FYapFragment& Fragment = GetFragment();
+	const FYapBit& MatureBit = Fragment.GetMatureBit();
+	const FYapBit& ChildSafeBit = Fragment.GetChildSafeBit();
+	const bool bNeedsChildSafeData = NeedsChildSafeData();
+
+	Cache.Revision = UYapEditorSubsystem::GetGraphDataRevision();
+	Cache.Maturity = GetDisplayMaturitySetting();
+
+	Cache.DialogueText = Fragment.GetDialogueText(GEditor->EditorWorld, Cache.Maturity);
+	Cache.TitleText = Fragment.GetTitleText(GEditor->EditorWorld, Cache.Maturity);
+
+	Cache.bWrapDialogueText = !NodeConfig.GetPreventDialogueTextWrapping();
+	Cache.bUsesChildSafe = NodeConfig.GetUsesChildSafe();
+	Cache.bUsesMoodTags = NodeConfig.GetUsesMoodTags();
+	Cache.bShowAudioID = !NodeConfig.GetHideAudioID();
+
+	Cache.SpeechTime = GetDialogueNode()->GetSpeechTime(FragmentIndex, Cache.Maturity, EYapLoadContext::AsyncEditorOnly);
+
+	// After the speech time, which may have started the load. Unloaded audio which nobody is loading doesn't keep the cache refreshing.
+	Cache.bAudioPending = MatureBit.IsAudioAssetLoading() || (bNeedsChildSafeData && ChildSafeBit.IsAudioAssetLoading());
+	Cache.DialogueTimeSliderMax = NodeConfig.GetDialogueTimeSliderMax();
+
+	Cache.TimeProgressionVisibility = Fragment.GetTimeMode(GetDialogueNode()->GetWorld(), NodeConfig) == EYapTimeMode::None ? EVisibility::Collapsed : EVisibility::SelfHitTestInvisible;
+	Cache.TitleTextVisibility = NodeConfig.GetUsesTitleText(GetDialogueNode()->GetNodeType()) ? EVisibility::Visible : EVisibility::Collapsed;
+	Cache.DialogueErrorVisibility = bNeedsChildSafeData && MatureBit.HasDialogueText() != ChildSafeBit.HasDialogueText() ? EVisibility::Visible : EVisibility::Collapsed;
+	Cache.TitleTextErrorVisibility = bNeedsChildSafeData && MatureBit.HasTitleText() != ChildSafeBit.HasTitleText() ? EVisibility::Visible : EVisibility::Collapsed;
+
+	Cache.FragmentAudioErrorLevel = GetFragmentAudioErrorLevel();
+
+	// Checking whether the audio asset names match the audio ID is the most expensive part of the widget
+	const TSoftObjectPtr<UObject>& MatureAudioAsset = MatureBit.AudioAsset;
+	const TSoftObjectPtr<UObject>& SafeAudioAsset = ChildSafeBit.AudioAsset;
 
-	bool bNeedsChildSafeAudio = NeedsChildSafeData();
+	bool bNeedsChildSafeAudio = bNeedsChildSafeData;
 
 	const FLinearColor Error = YapColor::Red;
 	const FLinearColor NoAudio = YapColor::White;
@@ -933,32 +1000,8 @@ FSlateColor SFlowGraphNode_YapFragmentWidget::ColorAndOpacity_AudioIDText() cons
 			Color = Error;
 		}
 	}
-	
-	if (AudioIDButton.IsValid() && AudioIDButton->IsHovered())
-	{
-		Color /= YapColor::LightGray;
-	}
 
-	return Color;
-}
-
-FText SFlowGraphNode_YapFragmentWidget::Text_AudioIDLabel() const
-{
-	//GetFragment().GetAudioID();
-
-	return FText::GetEmpty();
-}
-
-EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_TimeProgressionWidget() const
-{
-	UWorld* World = GetDialogueNode()->GetWorld();
-
-	if (GetFragment().GetTimeMode(World, GetNodeConfig()) == EYapTimeMode::None)
-	{
-		return EVisibility::Collapsed;
-	}
-	
-	return EVisibility::SelfHitTestInvisible;
+	Cache.AudioIDTextColor = Color;
 }
 
 // ================================================================================================
@@ -1006,10 +1049,10 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateDialogueDisplayWidge
 				.Padding(4, 4, 4, 2)
 				[
 					SNew(STextBlock)
-					.AutoWrapText_Lambda( [this] () { return !GetNodeConfig().GetPreventDialogueTextWrapping(); })
+					.AutoWrapText_Lambda( [this] () { return GetCache().bWrapDialogueText; })
 					.TextStyle(FYapEditorStyle::Get(), YapStyles.TextBlockStyle_DialogueText)
 					.Font(DialogueTextFont)
-					.Text_Lambda( [this] () { return GetFragment().GetDialogueText(GEditor->EditorWorld, GetDisplayMaturitySetting()); } )
+					.Text_Lambda( [this] () { return GetCache().DialogueText; } )
 					.ColorAndOpacity(this, &ThisClass::GetColorAndOpacityForFragmentText, YapColor::LightGray)
 				]
 				+ SOverlay::Slot()
@@ -1019,8 +1062,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateDialogueDisplayWidge
 					SNew(STextBlock)
 					.Visibility_Lambda( [this] ()
 					{
-						const FText& DialogueText =  GetFragment().GetDialogueText(GEditor->EditorWorld, GetDisplayMaturitySetting());
-						return DialogueText.IsEmpty() ? EVisibility::HitTestInvisible : EVisibility::Hidden;
+						return GetCache().DialogueText.IsEmpty() ? EVisibility::HitTestInvisible : EVisibility::Hidden;
 					})
 					.Justification(ETextJustify::Center)
 					.TextStyle(FYapEditorStyle::Get(), YapStyles.TextBlockStyle_DialogueText)
@@ -1084,7 +1126,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateDialogueDisplayWidge
 		})
 		[
 			SNew(SBorder)
-			.Visibility_Lambda( [this] () { return GetNodeConfig().GetHideAudioID() ? EVisibility::Collapsed : EVisibility::Visible; } )
+			.Visibility_Lambda( [this] () { return GetCache().bShowAudioID ? EVisibility::Visible : EVisibility::Collapsed; } )
 			.BorderImage(FYapEditorStyle::GetImageBrush(YapBrushes.Icon_IDTag))
 			.BorderBackgroundColor(this, &ThisClass::ColorAndOpacity_AudioIDButton)
 			.Padding(4, 2, 4, 2)
@@ -1123,9 +1165,9 @@ TOptional<float> SFlowGraphNode_YapFragmentWidget::Percent_FragmentTime() const
 		return NullOpt;
 	}
 	
-	if (GetFragment().GetStartTime() >= GetFragment().GetEndTime())
+	if (GetFragmentStartTime() >= GetFragmentEndTime())
 	{
-		return GEditor->PlayWorld->GetTimeSeconds() - GetFragment().GetStartTime();
+		return GEditor->PlayWorld->GetTimeSeconds() - GetFragmentStartTime();
 	}
 	else
 	{
@@ -1752,7 +1794,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateTitleTextDisplayWidg
 		[
 			SNew(STextBlock)
 			.TextStyle(FYapEditorStyle::Get(), YapStyles.TextBlockStyle_TitleText)
-			.Text_Lambda( [this] () { return GetFragment().GetTitleText(GEditor->EditorWorld, GetDisplayMaturitySetting()); } )
+			.Text_Lambda( [this] () { return GetCache().TitleText; } )
 			.ToolTipText(LOCTEXT("TitleTextDisplayWidget_ToolTipText", "Title text"))
 			.ColorAndOpacity(this, &ThisClass::GetColorAndOpacityForFragmentText, YapColor::YellowGray)
 		]
@@ -1763,8 +1805,7 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateTitleTextDisplayWidg
 			SNew(STextBlock)
 			.Visibility_Lambda( [this] ()
 			{
-				const FText& TitleText = GetFragment().GetTitleText(GEditor->EditorWorld, GetDisplayMaturitySetting());
-				return TitleText.IsEmpty() ? EVisibility::HitTestInvisible : EVisibility::Hidden;;
+				return GetCache().TitleText.IsEmpty() ? EVisibility::HitTestInvisible : EVisibility::Hidden;
 			})
 			.Justification(ETextJustify::Center)
 			.TextStyle(FYapEditorStyle::Get(), YapStyles.TextBlockStyle_TitleText)
@@ -1795,29 +1836,12 @@ TSharedRef<SWidget> SFlowGraphNode_YapFragmentWidget::CreateTitleTextDisplayWidg
  
 EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_TitleTextErrorState() const
 {
-	if (!NeedsChildSafeData())
-	{
-		return EVisibility::Collapsed;
-	}
-
-	const FYapBit& MatureBit = GetFragment().GetMatureBit();
-	const FYapBit& ChildSafeBit = GetFragment().GetChildSafeBit();
-
-	if (MatureBit.HasTitleText() != ChildSafeBit.HasTitleText())
-	{
-		return EVisibility::Visible;
-	}
-
-	return EVisibility::Collapsed;
+	return GetCache().TitleTextErrorVisibility;
 }
 
 EVisibility SFlowGraphNode_YapFragmentWidget::Visibility_TitleTextWidgets() const
 {
-	const UYapNodeConfig& NodeConfig = GetDialogueNode()->GetNodeConfig();
-
-	EYapDialogueNodeType NodeType = GetDialogueNode()->GetNodeType();
-	
-	return NodeConfig.GetUsesTitleText(NodeType) ? EVisibility::Visible : EVisibility::Collapsed;
+	return GetCache().TitleTextVisibility;
 }
 
 // ================================================================================================
@@ -2045,7 +2069,7 @@ FSlateColor SFlowGraphNode_YapFragmentWidget::ColorAndOpacity_AudioIDButton() co
 {
 	FLinearColor Color = YapColor::White;
 
-	switch (GetFragmentAudioErrorLevel())
+	switch (GetCache().FragmentAudioErrorLevel)
 	{
 		case EYapErrorLevel::OK:
 		{
@@ -2276,9 +2300,23 @@ bool SFlowGraphNode_YapFragmentWidget::HasCompleteChildSafeData() const
 	return bDialogueTextOK && bTitleTextOK && bAudioAssetOK;
 }
 
+double SFlowGraphNode_YapFragmentWidget::GetFragmentStartTime() const
+{
+	const FYapDialogueFragmentRunState* FragmentState = GetDialogueNode()->FindLatestFragmentRunState(FragmentIndex);
+
+	return FragmentState ? FragmentState->StartTime : -1.0;
+}
+
+double SFlowGraphNode_YapFragmentWidget::GetFragmentEndTime() const
+{
+	const FYapDialogueFragmentRunState* FragmentState = GetDialogueNode()->FindLatestFragmentRunState(FragmentIndex);
+
+	return FragmentState ? FragmentState->EndTime : -1.0;
+}
+
 bool SFlowGraphNode_YapFragmentWidget::FragmentIsRunning() const
 {
-	return GetFragment().GetStartTime() > GetFragment().GetEndTime();
+	return GetFragmentStartTime() > GetFragmentEndTime();
 }
 
 bool SFlowGraphNode_YapFragmentWidget::FragmentRecentlyRan() const
@@ -2290,9 +2328,9 @@ bool SFlowGraphNode_YapFragmentWidget::FragmentRecentlyRan() const
 	
 	UWorld* World = GEditor->GetCurrentPlayWorld(GEditor->PlayWorld);
 	
-	if (World && GetFragment().GetStartTime() >= 0.0)
+	if (World && GetFragmentStartTime() >= 0.0)
 	{
-		float Elapsed = World->GetTimeSeconds() - GetFragment().GetEndTime();
+		float Elapsed = World->GetTimeSeconds() - GetFragmentEndTime();
 		return Elapsed <= 2.0f;
 	}
 
@@ -0,0 +1,123 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Misc/AutomationTest.h"
+#include "YapEditor/Benchmark/YapBenchmarkHarness.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapBenchmarkConversationTurnsTest, "Yap.Benchmark.ConversationsTakeTurns", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapBenchmarkConversationTurnsTest::RunTest(const FString& Parameters)
+{
+	FYapBenchmarkSettings Settings;
+	Settings.NumConversations = 4;
+	Settings.NumBarks = 0;
+	Settings.Seconds = 300.0f;
+	Settings.ConversationTimeout = 0.0f;
+	Settings.LatencyProbesPerFrame = 0;
+
+	FYapBenchmarkResults Results;
+
+	if (!TestTrue(TEXT("Benchmark world started"), FYapBenchmarkHarness(Settings).Run(Results)))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Conversations waited for their turn"), Results.PendingConversationsHighWaterMark > 0);
+	TestTrue(TEXT("Conversations opened again after closing"), Results.ConversationsActivated > Settings.NumConversations);
+	TestEqual(TEXT("No conversation timed out"), Results.ConversationsExpired, 0);
+	TestTrue(TEXT("Conversation speech ran"), Results.NumConversationSpeeches > 0);
+	TestEqual(TEXT("No free speech ran"), Results.NumFreeSpeeches, 0);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapBenchmarkConversationTimeoutTest, "Yap.Benchmark.ConversationsTimeOut", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapBenchmarkConversationTimeoutTest::RunTest(const FString& Parameters)
+{
+	FYapBenchmarkSettings Settings;
+	Settings.NumConversations = 50;
+	Settings.NumBarks = 0;
+	Settings.Seconds = 20.0f;
+	Settings.ConversationTimeout = 2.0f;
+	Settings.LatencyProbesPerFrame = 0;
+
+	FYapBenchmarkResults Results;
+
+	if (!TestTrue(TEXT("Benchmark world started"), FYapBenchmarkHarness(Settings).Run(Results)))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Conversations opened"), Results.ConversationsActivated > 0);
+	TestTrue(TEXT("Waiting conversations timed out"), Results.ConversationsExpired > 0);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapBenchmarkFreeSpeechBudgetTest, "Yap.Benchmark.FreeSpeechBudget", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapBenchmarkFreeSpeechBudgetTest::RunTest(const FString& Parameters)
+{
+	FYapBenchmarkSettings Settings;
+	Settings.NumConversations = 0;
+	Settings.NumBarks = 200;
+	Settings.Seconds = 10.0f;
+	Settings.FreeSpeechBudget = 16;
+
+	// Probes call RunSpeech directly, which doesn't ask the budget
+	Settings.LatencyProbesPerFrame = 0;
+
+	FYapBenchmarkResults Results;
+
+	if (!TestTrue(TEXT("Benchmark world started"), FYapBenchmarkHarness(Settings).Run(Results)))
+	{
+		return false;
+	}
+
+	TestTrue(TEXT("Free speech ran"), Results.NumFreeSpeeches > 0);
+	TestTrue(TEXT("Free speech was culled"), Results.FreeSpeechCulled > 0);
+	TestTrue(TEXT("Running free speech stayed within the budget"), Results.FreeSpeechHighWaterMark <= Settings.FreeSpeechBudget);
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapBenchmarkDeterminismTest, "Yap.Benchmark.Deterministic", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapBenchmarkDeterminismTest::RunTest(const FString& Parameters)
+{
+	FYapBenchmarkSettings Settings;
+	Settings.NumConversations = 20;
+	Settings.NumBarks = 100;
+	Settings.Seconds = 30.0f;
+	Settings.FreeSpeechBudget = 16;
+	Settings.ConversationTimeout = 5.0f;
+	Settings.LatencyProbesPerFrame = 2;
+
+	FYapBenchmarkResults First;
+	FYapBenchmarkResults Second;
+
+	if (!TestTrue(TEXT("First run started"), FYapBenchmarkHarness(Settings).Run(First)) || !TestTrue(TEXT("Second run started"), FYapBenchmarkHarness(Settings).Run(Second)))
+	{
+		return false;
+	}
+
+	TestEqual(TEXT("Conversation speeches"), Second.NumConversationSpeeches, First.NumConversationSpeeches);
+	TestEqual(TEXT("Free speeches"), Second.NumFreeSpeeches, First.NumFreeSpeeches);
+	TestEqual(TEXT("Handler events"), Second.NumHandlerEvents, First.NumHandlerEvents);
+	TestEqual(TEXT("Conversations opened"), Second.ConversationsActivated, First.ConversationsActivated);
+	TestEqual(TEXT("Conversations timed out"), Second.ConversationsExpired, First.ConversationsExpired);
+	TestEqual(TEXT("Free speech culled"), Second.FreeSpeechCulled, First.FreeSpeechCulled);
+
+	return true;
+}
+
+#endif
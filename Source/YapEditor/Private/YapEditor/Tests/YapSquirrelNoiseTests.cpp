@@ -0,0 +1,230 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Yap/SquirrelNoise5.hpp"
+#include "Yap/YapSquirrelNoise.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace YapSquirrelNoiseTests
+{
+	// Counts either side of the four-wide vector loop, and one which runs past a whole chunk
+	static const int32 Counts[] = { 0, 1, 3, 4, 5, 7, 8, 1027 };
+
+	// The last two run past MAX_int32 and through -1 to 0
+	static const int32 Starts[] = { 0, 12345, -1000, MAX_int32 - 2, -1 };
+
+	static const uint32 Seeds[] = { 0, 1, 0xDEADBEEF, MAX_uint32 };
+
+	/** Position Offset steps along from Start, wrapping the same way the batched functions do. */
+	int32 WrappedPosition(const int32 Start, const int32 Offset)
+	{
+		return static_cast<int32>(static_cast<uint32>(Start) + static_cast<uint32>(Offset));
+	}
+
+	uint32 GetGlobalSeed()
+	{
+		return static_cast<uint32>(GEngine->GetEngineSubsystem<UYapSquirrelSubsystem>()->GetGlobalSeed());
+	}
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapSquirrelNoiseGenerateTest, "Yap.SquirrelNoise.GenerateMatchesSquirrelNoise5", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapSquirrelNoiseGenerateTest::RunTest(const FString& Parameters)
+{
+	using namespace YapSquirrelNoiseTests;
+
+	TArray<uint32> Bits;
+	TArray<double> Reals;
+
+	for (const uint32 Seed : Seeds)
+	{
+		for (const int32 Start : Starts)
+		{
+			for (const int32 Count : Counts)
+			{
+				Bits.SetNumZeroed(Count);
+				Reals.SetNumZeroed(Count);
+
+				YapSquirrel::GenerateUint32(Start, Seed, Bits);
+				YapSquirrel::GenerateReal(Start, Seed, Reals);
+
+				for (int32 i = 0; i < Count; ++i)
+				{
+					const int32 Position = WrappedPosition(Start, i);
+
+					if (Bits[i] != ::SquirrelNoise5(Position, Seed))
+					{
+						AddError(FString::Printf(TEXT("GenerateUint32 differs at position %d (start %d, count %d, seed %u)"), Position, Start, Count, Seed));
+						return false;
+					}
+
+					if (Reals[i] != Get1dNoiseZeroToOne(Position, Seed))
+					{
+						AddError(FString::Printf(TEXT("GenerateReal differs at position %d (start %d, count %d, seed %u)"), Position, Start, Count, Seed));
+						return false;
+					}
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapSquirrelNoiseStreamBatchTest, "Yap.SquirrelNoise.StreamBatchesMatchSquirrelNoise5", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapSquirrelNoiseStreamBatchTest::RunTest(const FString& Parameters)
+{
+	using namespace YapSquirrelNoiseTests;
+
+	const uint32 Seed = GetGlobalSeed();
+	const int32 Max = 37;
+
+	TArray<uint32> Bits;
+	TArray<double> Reals;
+	TArray<int32> Ints;
+
+	for (const int32 Start : Starts)
+	{
+		for (const int32 Count : Counts)
+		{
+			Bits.SetNumZeroed(Count);
+			Reals.SetNumZeroed(Count);
+			Ints.SetNumZeroed(Count);
+
+			FYapSquirrelState BitsState;
+			BitsState.Position = Start;
+			FYapSquirrelState RealsState = BitsState;
+			FYapSquirrelState IntsState = BitsState;
+
+			YapSquirrel::NextUint32Batch(BitsState, Bits);
+			YapSquirrel::NextRealBatch(RealsState, Reals);
+			YapSquirrel::NextInt32Batch(IntsState, Max, Ints);
+
+			const int32 End = WrappedPosition(Start, Count);
+
+			if (BitsState.Position != End || RealsState.Position != End || IntsState.Position != End)
+			{
+				AddError(FString::Printf(TEXT("Batch left the stream at the wrong position (start %d, count %d)"), Start, Count));
+				return false;
+			}
+
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const int32 Position = WrappedPosition(Start, i);
+				const double Real = Get1dNoiseZeroToOne(Position, Seed);
+
+				if (Bits[i] != ::SquirrelNoise5(Position, Seed) || Reals[i] != Real)
+				{
+					AddError(FString::Printf(TEXT("NextUint32Batch or NextRealBatch differs at position %d (start %d, count %d)"), Position, Start, Count));
+					return false;
+				}
+
+				// As in NextInt32
+				if (Ints[i] != FMath::Min(FMath::TruncToInt(Real * static_cast<double>(Max)), Max - 1))
+				{
+					AddError(FString::Printf(TEXT("NextInt32Batch differs at position %d (start %d, count %d)"), Position, Start, Count));
+					return false;
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+// ------------------------------------------------------------------------------------------------
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FYapSquirrelNoiseSingleCallsTest, "Yap.SquirrelNoise.BatchesMatchSingleCalls", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FYapSquirrelNoiseSingleCallsTest::RunTest(const FString& Parameters)
+{
+	using namespace YapSquirrelNoiseTests;
+
+	UYapSquirrel* Batched = NewObject<UYapSquirrel>();
+	UYapSquirrel* Single = NewObject<UYapSquirrel>();
+
+	// Single calls step the position with a signed increment, so keep them clear of the wrap
+	const int32 Start = 5000;
+	const int32 Count = 1027;
+	const int32 Max = 37;
+
+	TArray<double> Chances;
+	Chances.SetNumUninitialized(Count);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		Chances[i] = 100.0 * static_cast<double>(i) / static_cast<double>(Count - 1);
+	}
+
+	for (const double RollModifier : { 0.0, 25.0, -40.0 })
+	{
+		Batched->Jump(Start);
+		Single->Jump(Start);
+
+		TArray<bool> Results;
+		const int32 Successes = Batched->RollChanceBatch(Chances, RollModifier, Results);
+
+		int32 ExpectedSuccesses = 0;
+
+		for (int32 i = 0; i < Count; ++i)
+		{
+			double Roll;
+			const bool bSuccess = Single->RollChance(Roll, Chances[i], RollModifier);
+
+			if (Results[i] != bSuccess)
+			{
+				AddError(FString::Printf(TEXT("RollChanceBatch differs from RollChance for chance %f with modifier %f (roll %f)"), Chances[i], RollModifier, Roll));
+				return false;
+			}
+
+			ExpectedSuccesses += bSuccess ? 1 : 0;
+		}
+
+		TestEqual(TEXT("RollChanceBatch counted its successes"), Successes, ExpectedSuccesses);
+		TestEqual(TEXT("RollChanceBatch advanced the stream like RollChance"), Batched->GetPosition(), Single->GetPosition());
+	}
+
+	Batched->Jump(Start);
+	Single->Jump(Start);
+
+	TArray<double> Reals;
+	Batched->NextRealBatch(Count, Reals);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Reals[i] != Single->NextReal())
+		{
+			AddError(FString::Printf(TEXT("NextRealBatch differs from NextReal at index %d"), i));
+			return false;
+		}
+	}
+
+	FYapSquirrelState IntsState;
+	IntsState.Position = Start;
+	TArray<int32> Ints;
+	Ints.SetNumZeroed(Count);
+	YapSquirrel::NextInt32Batch(IntsState, Max, Ints);
+
+	Single->Jump(Start);
+
+	for (int32 i = 0; i < Count; ++i)
+	{
+		if (Ints[i] != Single->NextInt32(Max))
+		{
+			AddError(FString::Printf(TEXT("NextInt32Batch differs from NextInt32 at index %d"), i));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+#endif
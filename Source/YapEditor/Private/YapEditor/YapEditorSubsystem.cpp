@@ -9,10 +9,13 @@
 #include "UnrealEdGlobals.h"
 #include "Editor/UnrealEdEngine.h"
 #include "Yap/YapCharacterAsset.h"
+#include "Yap/YapNodeConfig.h"
+#include "Yap/Nodes/FlowNode_YapDialogue.h"
 #include "YapEditor/YapInputTracker.h"
 #include "Yap/YapProjectSettings.h"
 #include "YapEditor/YapEditorStyle.h"
 #include "Engine/Texture2D.h"
+#include "Misc/TransactionObjectEvent.h"
 #include "UObject/ObjectSaveContext.h"
 #include "YapEditor/YapDeveloperSettings.h"
 #include "YapEditor/Globals/YapTagHelpers.h"
@@ -21,6 +24,7 @@
 
 bool UYapEditorSubsystem::bLiveCodingInProgress = true;
 TArray<TWeakObjectPtr<UObject>> UYapEditorSubsystem::OpenedAssets = {};
+uint32 UYapEditorSubsystem::GraphDataRevision = 0;
 
 TSharedPtr<FSlateImageBrush> UYapEditorSubsystem::GetCharacterPortraitBrush(const UObject* Character, const FGameplayTag& MoodTag)
 {
@@ -93,6 +97,10 @@ void UYapEditorSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 #endif
 
 	FCoreUObjectDelegates::OnObjectPreSave.AddUObject(this, &ThisClass::OnObjectPresave);
+
+	FCoreUObjectDelegates::OnObjectModified.AddUObject(this, &ThisClass::OnObjectModified);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.AddUObject(this, &ThisClass::OnObjectPropertyChanged);
+	FCoreUObjectDelegates::OnObjectTransacted.AddUObject(this, &ThisClass::OnObjectTransacted);
 }
 
 void UYapEditorSubsystem::Deinitialize()
@@ -102,6 +110,10 @@ void UYapEditorSubsystem::Deinitialize()
 		FSlateApplication::Get().UnregisterInputPreProcessor(InputTracker);
 	}
 
+	FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+
 	Super::Deinitialize();
 }
 
@@ -113,6 +125,27 @@ void UYapEditorSubsystem::OnObjectPresave(UObject* Object, FObjectPreSaveContext
 	}
 }
 
+void UYapEditorSubsystem::OnObjectModified(UObject* Object)
+{
+	// Modify is called before the change is made, but graph widgets only read their caches when they paint, which is after the edit has finished
+	if (Object->IsA<UFlowNode_YapDialogue>() || Object->IsA<UYapNodeConfig>() || Object->IsA<UYapCharacterAsset>() || Object->IsA<UYapProjectSettings>())
+	{
+		++GraphDataRevision;
+	}
+}
+
+void UYapEditorSubsystem::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	// Details panel edits of settings objects don't always go through Modify
+	OnObjectModified(Object);
+}
+
+void UYapEditorSubsystem::OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent)
+{
+	// Undo and redo
+	OnObjectModified(Object);
+}
+
 void UYapEditorSubsystem::CleanupDialogueTags()
 {
 	for (auto It = TagsPendingDeletion.CreateIterator(); It; ++It)
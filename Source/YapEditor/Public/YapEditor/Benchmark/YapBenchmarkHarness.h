@@ -0,0 +1,237 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Math/RandomStream.h"
+#include "UObject/GCObject.h"
+#include "Yap/YapBroker.h"
+#include "Yap/YapProjectSettings.h"
+#include "Yap/Enums/YapMaturitySetting.h"
+#include "Yap/Interfaces/IYapConversationHandler.h"
+#include "Yap/Interfaces/IYapFreeSpeechHandler.h"
+
+#include "YapBenchmarkHarness.generated.h"
+
+class UFlowAsset;
+class UFlowGraphNode;
+class UFlowNode_YapConversation_Open;
+class UFlowSubsystem;
+class UGameInstance;
+class UWorld;
+class UYapNodeConfig;
+class UYapSubsystem;
+
+/** Stand-in broker with fixed settings and no audio, so that benchmark runs don't depend on the project's broker. */
+UCLASS(Transient)
+class UYapBenchmarkBroker : public UYapBroker
+{
+	GENERATED_BODY()
+
+public:
+	void Initialize() override { }
+
+	EYapMaturitySetting GetMaturitySetting() const override { return EYapMaturitySetting::Mature; }
+
+	float GetPlaybackSpeed() const override { return 1.0f; }
+
+	float GetAudioAssetDuration(const UObject* AudioAsset) const override { return 0.0f; }
+
+#if WITH_EDITOR
+	bool PreviewAudioAsset(const UObject* AudioAsset) const override { return false; }
+#endif
+};
+
+// ================================================================================================
+
+/** Handler which only counts, so that the benchmark measures Yap rather than game code. Also used as flow and speech owner. */
+UCLASS(Transient)
+class UYapBenchmarkHandler : public UObject, public IYapConversationHandler, public IYapFreeSpeechHandler
+{
+	GENERATED_BODY()
+
+public:
+	int32 NumEvents = 0;
+
+	int32 NumConversationSpeeches = 0;
+
+	int32 NumFreeSpeeches = 0;
+
+	void OnConversationOpened(FYapData_ConversationOpened Data, FYapConversationHandle Handle) override { ++NumEvents; }
+
+	void OnConversationSpeechBegins(FYapData_SpeechBegins Data, FYapSpeechHandle Handle) override { ++NumEvents; ++NumConversationSpeeches; }
+
+	void OnConversationPlayerPromptCreated(FYapData_PlayerPromptCreated Data, FYapPromptHandle Handle) override { ++NumEvents; }
+
+	void OnConversationPlayerPromptsReady(FYapData_PlayerPromptsReady Data) override { ++NumEvents; }
+
+	void OnConversationPlayerPromptChosen(FYapData_PlayerPromptChosen Data, FYapPromptHandle Handle) override { ++NumEvents; }
+
+	void OnTalkSpeechBegins(FYapData_SpeechBegins Data, FYapSpeechHandle Handle) override { ++NumEvents; ++NumFreeSpeeches; }
+};
+
+// ================================================================================================
+
+struct FYapBenchmarkSettings
+{
+	/** Flow instances which loop through a conversation. Only one conversation is open at a time; the rest wait in the conversation scheduler. */
+	int32 NumConversations = 1000;
+
+	/** Flow instances which loop through free speech, competing for the free speech budget. */
+	int32 NumBarks = 4000;
+
+	float Seconds = 120.0f;
+
+	/** Seeds the generated graphs and the start times of the flows. */
+	int32 Seed = 1;
+
+	/** Replaces the project's free speech budget for the run. Zero is unlimited. */
+	int32 FreeSpeechBudget = 64;
+
+	/** Seconds a conversation may wait for its turn before it is dropped and asks again. Zero waits forever. */
+	float ConversationTimeout = 30.0f;
+
+	/** Direct RunSpeech calls timed each frame for the latency figures. These skip the free speech budget like any direct RunSpeech call. */
+	int32 LatencyProbesPerFrame = 16;
+};
+
+// ================================================================================================
+
+struct FYapBenchmarkResults
+{
+	int32 NumFrames = 0;
+
+	double WallSeconds = 0.0;
+
+	int32 NumConversationSpeeches = 0;
+
+	int32 NumFreeSpeeches = 0;
+
+	int32 NumHandlerEvents = 0;
+
+	int32 ConversationsActivated = 0;
+
+	int32 ConversationsExpired = 0;
+
+	int32 PendingConversationsHighWaterMark = 0;
+
+	int32 FreeSpeechCulled = 0;
+
+	int32 FreeSpeechHighWaterMark = 0;
+
+	/** RunSpeech latencies in microseconds, sorted. */
+	TArray<double> Latencies;
+
+	double AverageTickSeconds = 0.0;
+
+	double MaxTickSeconds = 0.0;
+
+	/** Bytes under the Yap LLM tag; INDEX_NONE unless the run had -llm. The benchmark no longer counts allocations, since that meant replacing GMalloc. */
+	int64 LLMStartBytes = INDEX_NONE;
+
+	int64 LLMPeakBytes = INDEX_NONE;
+
+	int64 LLMEndBytes = INDEX_NONE;
+
+	uint64 PeakUsedPhysical = 0;
+
+	double GetLatencyPercentile(double Fraction) const;
+
+	void Log(const FYapBenchmarkSettings& Settings) const;
+};
+
+// ================================================================================================
+
+/**
+ * Builds conversation and bark Flow graphs in memory, starts one root flow per requested conversation and bark in a game world, and ticks that world with a
+ * fixed time step. Everything runs through the dialogue nodes, the conversation scheduler and the timing wheel like a game would, with a stand-in broker and
+ * seeded speech times so every run with the same settings is identical. Project settings touched by the run are restored afterwards.
+ */
+class FYapBenchmarkHarness : public FGCObject
+{
+public:
+	explicit FYapBenchmarkHarness(const FYapBenchmarkSettings& InSettings);
+
+	~FYapBenchmarkHarness();
+
+	/** Runs the whole benchmark. Returns false if the world or its subsystems could not be created. */
+	bool Run(FYapBenchmarkResults& OutResults);
+
+	// FGCObject
+	void AddReferencedObjects(FReferenceCollector& Collector) override;
+
+	FString GetReferencerName() const override { return TEXT("FYapBenchmarkHarness"); }
+
+private:
+	struct FConversationFlow
+	{
+		TObjectPtr<UFlowAsset> Flow = nullptr;
+
+		TObjectPtr<UFlowNode_YapConversation_Open> OpenNode = nullptr;
+	};
+
+	struct FPendingStart
+	{
+		int32 Frame = 0;
+
+		int32 TemplateIndex = 0;
+
+		bool bConversation = false;
+	};
+
+	bool Begin();
+
+	void End();
+
+	void OverrideProjectSettings();
+
+	void RestoreProjectSettings();
+
+	UFlowAsset* BuildConversationTemplate(FRandomStream& Random);
+
+	UFlowAsset* BuildBarkTemplate(FRandomStream& Random);
+
+	UFlowGraphNode* AddTalkNode(UFlowAsset* Asset, FRandomStream& Random);
+
+	void StartFlow(const FPendingStart& PendingStart);
+
+	void RetryDroppedConversations();
+
+	void SampleMemory(FYapBenchmarkResults& Results) const;
+
+	FYapBenchmarkSettings Settings;
+
+	TObjectPtr<UGameInstance> GameInstance = nullptr;
+
+	TObjectPtr<UWorld> World = nullptr;
+
+	TObjectPtr<UFlowSubsystem> FlowSubsystem = nullptr;
+
+	TObjectPtr<UYapSubsystem> Subsystem = nullptr;
+
+	TObjectPtr<UYapBenchmarkHandler> Handler = nullptr;
+
+	TObjectPtr<UYapNodeConfig> NodeConfig = nullptr;
+
+	TArray<TObjectPtr<UFlowAsset>> ConversationTemplates;
+
+	TArray<TObjectPtr<UFlowAsset>> BarkTemplates;
+
+	/** Open node of each conversation template. */
+	TArray<FGuid> OpenNodeGuids;
+
+	TArray<TObjectPtr<UObject>> FlowOwners;
+
+	TArray<FConversationFlow> ConversationFlows;
+
+	/** Flows still to be started, sorted by frame, so that the run doesn't begin with every flow at once. */
+	TArray<FPendingStart> PendingStarts;
+
+	int32 NextPendingStart = 0;
+
+	bool bOverridingProjectSettings = false;
+
+	UYapProjectSettings::FTestOverrides SavedProjectSettings;
+
+	ELogVerbosity::Type SavedLogVerbosity = ELogVerbosity::Log;
+};
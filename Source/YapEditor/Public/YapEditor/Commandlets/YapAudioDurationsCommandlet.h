@@ -0,0 +1,28 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "YapAudioDurationsCommandlet.generated.h"
+
+/**
+ * Resolves the duration of every dialogue audio asset used by any Flow asset and writes them to the audio duration cache (see FYapAudioDurationCache).
+ * Audio packages are hashed in parallel; only packages whose hash changed since the last run are loaded (in one async batch) and resolved again.
+ *
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=YapAudioDurations [-NullAudio] [-Full]
+ *
+ * -NullAudio reads durations with UYapNullAudioBroker instead of the project's broker, for machines without audio (e.g. -nullrhi -nosound).
+ * -Full resolves every duration again, ignoring the hashes in the cache.
+ */
+UCLASS()
+class UYapAudioDurationsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UYapAudioDurationsCommandlet();
+
+	int32 Main(const FString& Params) override;
+};
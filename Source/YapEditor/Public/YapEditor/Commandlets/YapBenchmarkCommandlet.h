@@ -0,0 +1,29 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "YapBenchmarkCommandlet.generated.h"
+
+/**
+ * Soak and throughput benchmark for the dialogue runtime, see FYapBenchmarkHarness. Starts a looping conversation flow per -Conversations and a looping bark flow
+ * per -Barks in a game world and ticks it with a fixed time step. Conversations are serial, so the conversation flows compete for turns in the conversation
+ * scheduler and time out after -ConversationTimeout seconds; barks compete for -FreeSpeechBudget. Reports speeches/sec, scheduler and budget counters,
+ * p50/p99 RunSpeech latency, world tick cost and memory; add -llm to track the bytes under the Yap LLM tag.
+ *
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=YapBenchmark -nullrhi [-Conversations=1000] [-Barks=4000] [-Seconds=120] [-Seed=1] [-FreeSpeechBudget=64] [-ConversationTimeout=30] [-llm]
+ *
+ * Returns non-zero if -MaxP99Us=<Microseconds> is given and the p99 RunSpeech latency exceeds it, so it can gate a build.
+ */
+UCLASS()
+class UYapBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UYapBenchmarkCommandlet();
+
+	int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,28 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "YapPOExportCommandlet.generated.h"
+
+/**
+ * Exports the dialogue and title text of every Flow asset to .PO files, one per Flow asset, plus a Changed.po holding only the entries which are new or
+ * changed since the last run. A manifest of package timestamps and entry hashes is kept in the output directory, so that only Flow assets which were
+ * saved since the last run get loaded again. Localization comments, stage directions and the previous msgctxt/msgid kept on each bit are included.
+ *
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=YapPOExport [-Output=<Directory>] [-Full]
+ *
+ * -Output defaults to Saved/Yap/Localization. -Full ignores the manifest and re-exports everything.
+ */
+UCLASS()
+class UYapPOExportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UYapPOExportCommandlet();
+
+	int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,25 @@
+// Copyright Ghost Pepper Games, Inc. All Rights Reserved.
+// This work is MIT-licensed. Feel free to use it however you wish, within the confines of the MIT license. 
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+
+#include "YapWordCountCommandlet.generated.h"
+
+/**
+ * Recounts the words of every dialogue text in every Flow asset of the project and saves the assets which changed. Does nothing if the project
+ * settings prevent caching word counts.
+ * 
+ * Usage: UnrealEditor-Cmd.exe <Project> -run=YapWordCount [-NoSave]
+ */
+UCLASS()
+class UYapWordCountCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UYapWordCountCommandlet();
+
+	int32 Main(const FString& Params) override;
+};
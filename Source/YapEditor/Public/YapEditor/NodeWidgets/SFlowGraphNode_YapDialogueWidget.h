@@ -28,6 +28,22 @@ struct FYapWidgetOverlay
 	float Opacity = 0;
 };
 
+/** Node config values the dialogue widget reads on every paint. Refreshed at most once per frame, and only when graph data changed (see UYapEditorSubsystem::GetGraphDataRevision). */
+struct FYapDialogueWidgetCache
+{
+	uint64 Frame = MAX_uint64;
+
+	uint32 Revision = MAX_uint32;
+
+	float MaxNodeWidth = 0.0f;
+
+	TOptional<FLinearColor> GroupColor;
+
+	FText NodeHeaderText;
+
+	FText GroupLabelText;
+};
+
 class SFlowGraphNode_YapDialogueWidget : public SFlowGraphNode
 {
 	// ------------------------------------------
@@ -82,6 +98,8 @@ protected:
 	TSharedPtr<SWidget> AppendFragmentButton;
 	
 	double FocusedConditionWidgetStartTime = -1;
+
+	mutable FYapDialogueWidgetCache Cache;
 	
 public:
 	TArray<FYapWidgetOverlay> OverlayWidgets;
@@ -223,6 +241,10 @@ protected:
 	void OnDialogueSkipped(uint8 FragmentIndex);
 
 	const UYapNodeConfig& GetNodeConfig() const;
+
+	const FYapDialogueWidgetCache& GetCache() const;
+
+	void RefreshCache() const;
 	
 	// ------------------------------------------
 	// OVERRIDES & THEIR HELPERS
@@ -57,6 +57,50 @@ enum class EFlowGraphNode_YapCharacterHasPortrait: uint8
 	NotFound,
 };
 
+/**
+ * Attributes the fragment widget reads on every paint. Refreshed at most once per frame, and only when graph data changed
+ * (see UYapEditorSubsystem::GetGraphDataRevision) or the displayed maturity setting flipped.
+ */
+struct FYapFragmentWidgetCache
+{
+	uint64 Frame = MAX_uint64;
+
+	uint32 Revision = MAX_uint32;
+
+	EYapMaturitySetting Maturity {};
+
+	/** Set while a load of the fragment's audio is in flight, since finishing it changes speech times without modifying anything. Refreshing once more after the load completes picks up the new time. */
+	bool bAudioPending = false;
+	
+	FText DialogueText;
+
+	FText TitleText;
+
+	bool bWrapDialogueText = true;
+
+	bool bUsesChildSafe = false;
+
+	bool bUsesMoodTags = false;
+
+	bool bShowAudioID = true;
+
+	TOptional<float> SpeechTime;
+
+	float DialogueTimeSliderMax = 0.0f;
+
+	EVisibility TimeProgressionVisibility = EVisibility::Collapsed;
+
+	EVisibility TitleTextVisibility = EVisibility::Collapsed;
+
+	EVisibility DialogueErrorVisibility = EVisibility::Collapsed;
+
+	EVisibility TitleTextErrorVisibility = EVisibility::Collapsed;
+
+	EYapErrorLevel FragmentAudioErrorLevel {};
+
+	FLinearColor AudioIDTextColor = FLinearColor::White;
+};
+
 class SFlowGraphNode_YapFragmentWidget : public SCompoundWidget
 {
 	// ==========================================
@@ -147,6 +191,9 @@ protected:
 
 	//
 	EFlowGraphNode_YapCharacterHasPortrait DirectedAtPortraitState;
+
+	// Values the attribute bindings read instead of querying the fragment, node config and project settings on every paint
+	mutable FYapFragmentWidgetCache Cache;
 	
 public:
 	// ================================================================================================
@@ -330,6 +377,12 @@ protected:
 	
 	bool HasCompleteChildSafeData() const;
 
+	/** Start time of the fragment in the dialogue node's most recent activation to run it, or -1. */
+	double GetFragmentStartTime() const;
+
+	/** End time of the fragment in the dialogue node's most recent activation to run it, or -1. */
+	double GetFragmentEndTime() const;
+
 	bool FragmentIsRunning() const;
 
 	bool FragmentRecentlyRan() const;
@@ -346,6 +399,10 @@ protected:
 
 	const UYapNodeConfig& GetNodeConfig() const;
 
+	const FYapFragmentWidgetCache& GetCache() const;
+
+	void RefreshCache() const;
+
 public:
 	bool GetIsChildSafeCheckBoxHovered() const { return bChildSafeCheckBoxHovered; };
 	
@@ -10,6 +10,8 @@
 
 class UYapCharacterAsset;
 class FYapInputTracker;
+class FTransactionObjectEvent;
+struct FPropertyChangedEvent;
 struct FYapFragment;
 
 #define LOCTEXT_NAMESPACE "YapEditor"
@@ -59,6 +61,20 @@ public:
 
 	void OnObjectPresave(UObject* Object, FObjectPreSaveContext Context);
 
+	/** Bumped whenever a dialogue node, node config, character or the project settings are modified, edited or undone. Graph widgets compare against it to know when their cached attributes are stale. */
+	static uint32 GetGraphDataRevision() { return GraphDataRevision; }
+
+protected:
+	static uint32 GraphDataRevision;
+
+	void OnObjectModified(UObject* Object);
+
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& PropertyChangedEvent);
+
+	void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& TransactionEvent);
+
+public:
+
 	void CleanupDialogueTags();
 	
 	FYapInputTracker* GetInputTracker();